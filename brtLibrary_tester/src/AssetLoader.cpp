@@ -0,0 +1,219 @@
+/**
+*
+* \brief Concurrent loading of the HRTF, ILD and audio files listed in a manifest
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "AssetLoader.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CAssetLoader::CAssetLoader(const TAssetReaders& _readers, int _numberOfThreads) : readers(_readers), jobsRunning(0), stopRequested(false), started(false)
+{
+    int numberOfThreads = _numberOfThreads > 0 ? _numberOfThreads : std::max<int>(ASSET_LOADER_MIN_THREADS, (int)std::thread::hardware_concurrency());
+    for (int i = 0; i < numberOfThreads; i++) { threads.push_back(std::thread(&CAssetLoader::WorkerLoop, this)); }
+}
+
+CAssetLoader::~CAssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread& thread : threads) { thread.join(); }
+}
+
+std::shared_future<TAsset> CAssetLoader::Load(const TAssetEntry& _entry)
+{
+    TJob job = { _entry, std::make_shared<std::promise<TAsset>>() };
+    std::shared_future<TAsset> future = job.promise->get_future().share();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!started) {
+            startTime = std::chrono::steady_clock::now();
+            started = true;
+        }
+        jobs.push_back(job);
+    }
+    jobAvailable.notify_one();
+    return future;
+}
+
+std::map<std::string, std::shared_future<TAsset>> CAssetLoader::Load(const std::vector<TAssetEntry>& _manifest)
+{
+    std::map<std::string, std::shared_future<TAsset>> futures;
+    for (const TAssetEntry& entry : _manifest) { futures[entry.name] = Load(entry); }
+    return futures;
+}
+
+void CAssetLoader::WaitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    jobsFinished.wait(lock, [this] { return jobsRunning == 0 && jobs.empty(); });
+}
+
+std::vector<TAssetTiming> CAssetLoader::GetTimings()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return timings;
+}
+
+double CAssetLoader::GetElapsedMilliseconds() const
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void CAssetLoader::WorkerLoop()
+{
+    BRTReaders::CSOFAReader sofaReader;                                 // One reader per thread
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobAvailable.wait(lock, [this] { return stopRequested || !jobs.empty(); });
+        if (jobs.empty()) { return; }                                   // Stop requested and nothing left to do
+        TJob job = jobs.front();
+        jobs.pop_front();
+        jobsRunning++;
+        TAssetTiming timing = { job.entry.name, job.entry.type, GetElapsedMilliseconds(), 0, false };
+        lock.unlock();
+
+        TAsset asset = LoadAsset(sofaReader, job.entry);
+
+        lock.lock();
+        timing.loadMilliseconds = GetElapsedMilliseconds() - timing.startMilliseconds;
+        timing.loaded = asset.IsLoaded();
+        timings.push_back(timing);
+        jobsRunning--;
+        if (jobsRunning == 0 && jobs.empty()) { jobsFinished.notify_all(); }
+        lock.unlock();
+        job.promise->set_value(asset);                                  // Waiters run once the timing is recorded
+        lock.lock();
+    }
+}
+
+TAsset CAssetLoader::LoadAsset(BRTReaders::CSOFAReader& _sofaReader, const TAssetEntry& _entry)
+{
+    TAsset asset;
+    asset.type = _entry.type;
+    switch (_entry.type) {
+    case ASSET_HRTF:
+        if (readers.readHRTF) { asset.hrtf = readers.readHRTF(_sofaReader, _entry.filePath); }
+        break;
+    case ASSET_ILD:
+        if (readers.readILD) { asset.ild = readers.readILD(_sofaReader, _entry.filePath); }
+        break;
+    case ASSET_AUDIO:
+        if (readers.readAudio) {
+            std::shared_ptr<std::vector<float>> samples = std::make_shared<std::vector<float>>();
+            if (readers.readAudio(*samples, _entry.filePath, _entry.audioSeconds)) { asset.samples = samples; }
+        }
+        break;
+    }
+    return asset;
+}
+
+void CAssetLoader::PrintReport()
+{
+    std::vector<TAssetTiming> finished = GetTimings();
+    double total = 0;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%-20s %6s %10s %10s %10s %7s", "asset", "type", "start ms", "load ms", "end ms", "loaded");
+    std::cout << row << std::endl;
+    for (const TAssetTiming& timing : finished) {
+        std::snprintf(row, sizeof(row), "%-20s %6s %10.1f %10.1f %10.1f %7s", timing.name.c_str(), GetAssetTypeName(timing.type), timing.startMilliseconds,
+            timing.loadMilliseconds, timing.startMilliseconds + timing.loadMilliseconds, timing.loaded ? "yes" : "NO");
+        std::cout << row << std::endl;
+        total = std::max(total, timing.startMilliseconds + timing.loadMilliseconds);
+    }
+    std::cout << finished.size() << " assets in " << total << " ms with " << GetNumberOfThreads() << " thread(s)" << std::endl;
+}
+
+const char* GetAssetTypeName(TAssetType _type)
+{
+    switch (_type) {
+    case ASSET_HRTF: return "hrtf";
+    case ASSET_ILD: return "ild";
+    case ASSET_AUDIO: return "audio";
+    }
+    return "";
+}
+
+bool ReadAssetManifest(const std::string& _filePath, std::vector<TAssetEntry>& _manifest)
+{
+    std::ifstream file(_filePath);
+    if (!file.is_open()) {
+        std::cout << "Error opening the asset manifest " << _filePath << std::endl;
+        return false;
+    }
+
+    _manifest.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream tokens(line);
+        std::string type;
+        if (!(tokens >> type) || type[0] == '#') { continue; }
+        TAssetEntry entry;
+        if (type == "hrtf") { entry.type = ASSET_HRTF; }
+        else if (type == "ild") { entry.type = ASSET_ILD; }
+        else if (type == "audio") { entry.type = ASSET_AUDIO; }
+        else {
+            std::cout << "Asset manifest line " << lineNumber << ": " << type << " assets are not loaded by the tester, skipped" << std::endl;
+            continue;
+        }
+        if (!(tokens >> entry.name >> entry.filePath)) {
+            std::cout << "Asset manifest line " << lineNumber << ": expected " << type << " <name> <file>, skipped" << std::endl;
+            continue;
+        }
+        float seconds;
+        if (entry.type == ASSET_AUDIO && tokens >> seconds && seconds > 0) { entry.audioSeconds = seconds; }
+        bool duplicated = std::any_of(_manifest.begin(), _manifest.end(), [&entry](const TAssetEntry& _other) { return _other.name == entry.name; });
+        if (duplicated) {
+            std::cout << "Asset manifest line " << lineNumber << ": the name " << entry.name << " is already used, skipped" << std::endl;
+            continue;
+        }
+        _manifest.push_back(entry);
+    }
+    return !_manifest.empty();
+}
+
+void RunAssetLoadingBenchmark(const std::vector<TAssetEntry>& _manifest, const TAssetReaders& _readers, int _numberOfThreads)
+{
+    double totals[2] = { 0, 0 };
+    double slowest = 0;
+    for (int concurrent = 0; concurrent < 2; concurrent++) {
+        CAssetLoader loader(_readers, concurrent ? _numberOfThreads : 1);
+        std::cout << std::endl << (concurrent ? "Concurrent" : "Sequential") << " loading of " << _manifest.size() << " assets:" << std::endl;
+        std::map<std::string, std::shared_future<TAsset>> futures = loader.Load(_manifest);
+        for (auto& future : futures) { future.second.wait(); }
+        loader.PrintReport();
+        for (const TAssetTiming& timing : loader.GetTimings()) {
+            totals[concurrent] = std::max(totals[concurrent], timing.startMilliseconds + timing.loadMilliseconds);
+            if (!concurrent) { slowest = std::max(slowest, timing.loadMilliseconds); }
+        }
+    }
+    std::cout << std::endl << "Sequential " << totals[0] << " ms, concurrent " << totals[1] << " ms (" << totals[0] / std::max(totals[1], 1e-3)
+        << "x), slowest asset " << slowest << " ms" << std::endl;
+}
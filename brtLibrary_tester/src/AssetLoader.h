@@ -0,0 +1,171 @@
+/**
+*
+* \brief Concurrent loading of the HRTF, ILD and audio files listed in a manifest
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _ASSETLOADER_H_
+#define _ASSETLOADER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <BRTLibrary.h>
+
+#define ASSET_LOADER_MIN_THREADS        4           // Loading waits on file I/O, so it uses more threads than cores on small machines
+#define ASSET_AUDIO_DEFAULT_SECONDS     10.0f       // Longest excerpt of an audio asset when the manifest does not give one
+
+/** \brief Kinds of asset a manifest can list
+*/
+enum TAssetType { ASSET_HRTF, ASSET_ILD, ASSET_AUDIO };
+
+/** \brief One line of a manifest
+*/
+struct TAssetEntry {
+    TAssetType type;
+    std::string name;                               // Unique in the manifest
+    std::string filePath;
+    float audioSeconds = ASSET_AUDIO_DEFAULT_SECONDS;
+};
+
+/** \brief Result of loading an asset: the member of its type is set, or none if it could not be loaded
+*/
+struct TAsset {
+    TAssetType type = ASSET_HRTF;
+    std::shared_ptr<BRTServices::CHRTF> hrtf;
+    std::shared_ptr<BRTServices::CILD> ild;
+    std::shared_ptr<const std::vector<float>> samples;  // Mono audio
+
+    bool IsLoaded() const { return hrtf != nullptr || ild != nullptr || samples != nullptr; }
+};
+
+/** \brief Time an asset took, measured from the first request of the loader
+*/
+struct TAssetTiming {
+    std::string name;
+    TAssetType type;
+    double startMilliseconds;                       // When a thread took it
+    double loadMilliseconds;                        // Reading and processing
+    bool loaded;
+};
+
+/** \brief Functions reading each kind of asset. They are called from several loader threads at once, each thread with its own
+*	SOFA reader, so they must be thread-safe
+*/
+struct TAssetReaders {
+    std::function<std::shared_ptr<BRTServices::CHRTF>(BRTReaders::CSOFAReader&, const std::string&)> readHRTF;
+    std::function<std::shared_ptr<BRTServices::CILD>(BRTReaders::CSOFAReader&, const std::string&)> readILD;
+    std::function<bool(std::vector<float>&, const std::string&, float)> readAudio;
+};
+
+/** \brief Loads and processes assets concurrently in a pool of threads. Each request returns a future of the asset at once, which
+*	the caller awaits where it needs the asset (before listener->SetHRTF, for instance), so the time to have every asset is the
+*	time of the slowest one rather than the sum of all of them.
+*/
+class CAssetLoader {
+public:
+    /** \brief Starts the threads
+    *	\param [in] _readers
+    *	\param [in] _numberOfThreads 0 uses every core, and at least ASSET_LOADER_MIN_THREADS
+    */
+    CAssetLoader(const TAssetReaders& _readers, int _numberOfThreads = 0);
+
+    /** \brief Finishes the queued assets and joins the threads
+    */
+    ~CAssetLoader();
+
+    /** \brief Queues an asset
+    *	\param [in] _entry
+    *	\retval future of the asset
+    */
+    std::shared_future<TAsset> Load(const TAssetEntry& _entry);
+
+    /** \brief Queues every asset of a manifest, in its order
+    *	\param [in] _manifest
+    *	\retval future of each asset, by name
+    */
+    std::map<std::string, std::shared_future<TAsset>> Load(const std::vector<TAssetEntry>& _manifest);
+
+    /** \brief Blocks until every queued asset is loaded
+    */
+    void WaitUntilIdle();
+
+    int GetNumberOfThreads() const { return (int)threads.size(); }
+
+    /** \brief Timing of the assets loaded so far, in the order they finished
+    */
+    std::vector<TAssetTiming> GetTimings();
+
+    /** \brief Prints the timing of every asset loaded so far, and the total time since the first request
+    */
+    void PrintReport();
+
+private:
+    struct TJob {
+        TAssetEntry entry;
+        std::shared_ptr<std::promise<TAsset>> promise;
+    };
+
+    void WorkerLoop();
+    TAsset LoadAsset(BRTReaders::CSOFAReader& _sofaReader, const TAssetEntry& _entry);
+    double GetElapsedMilliseconds() const;
+
+    TAssetReaders readers;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobsFinished;
+    std::deque<TJob> jobs;
+    size_t jobsRunning;
+    bool stopRequested;
+    bool started;                                   // First request made, the clock runs from it
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<TAssetTiming> timings;
+    std::vector<std::thread> threads;
+};
+
+/** \brief Name of an asset type in manifests and reports
+*/
+const char* GetAssetTypeName(TAssetType _type);
+
+/** \brief Reads a manifest: one asset per line, "hrtf|ild|audio <name> <file> [seconds, audio only]"; lines starting with # are comments
+*	\param [in] _filePath
+*	\param [out] _manifest
+*	\retval false if the file could not be opened or has no valid entry. Invalid lines are reported and skipped
+*/
+bool ReadAssetManifest(const std::string& _filePath, std::vector<TAssetEntry>& _manifest);
+
+/** \brief Loads a manifest with one thread and with a pool of threads, printing the time of every asset, the total of each run
+*	and the time of the slowest asset, the bound of the concurrent run
+*	\param [in] _manifest
+*	\param [in] _readers
+*	\param [in] _numberOfThreads of the concurrent run, 0 as CAssetLoader
+*/
+void RunAssetLoadingBenchmark(const std::vector<TAssetEntry>& _manifest, const TAssetReaders& _readers, int _numberOfThreads = 0);
+
+#endif
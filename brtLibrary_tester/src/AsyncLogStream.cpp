@@ -0,0 +1,198 @@
+/**
+*
+* \brief Asynchronous log stream: threads push fixed size records to a lock-free queue, a writer thread outputs them
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "AsyncLogStream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "ProcessingStatistics.hpp"
+
+namespace {
+    thread_local TAsyncLogRecord pendingRecord = { 0, {} };     // Characters written by this thread and not pushed yet
+}
+
+//////////////////////////////
+// Stream buffer
+//////////////////////////////
+
+CAsyncLogStream::CBuffer::CBuffer() : queue(ASYNC_LOG_CAPACITY), writtenRecords(0), droppedRecords(0), reportedDrops(0)
+{
+}
+
+void CAsyncLogStream::CBuffer::PushPending()
+{
+    if (pendingRecord.length == 0) { return; }
+    if (!queue.Push(pendingRecord)) { droppedRecords.fetch_add(1, std::memory_order_relaxed); }
+    pendingRecord.length = 0;
+}
+
+CAsyncLogStream::CBuffer::int_type CAsyncLogStream::CBuffer::overflow(int_type _character)
+{
+    if (traits_type::eq_int_type(_character, traits_type::eof())) { return traits_type::not_eof(_character); }
+    pendingRecord.text[pendingRecord.length++] = traits_type::to_char_type(_character);
+    if (_character == '\n' || pendingRecord.length == ASYNC_LOG_RECORD_SIZE) { PushPending(); }
+    return _character;
+}
+
+std::streamsize CAsyncLogStream::CBuffer::xsputn(const char* _characters, std::streamsize _count)
+{
+    for (std::streamsize i = 0; i < _count;) {
+        size_t length = std::min<size_t>((size_t)(_count - i), ASYNC_LOG_RECORD_SIZE - pendingRecord.length);
+        const char* newLine = (const char*)memchr(_characters + i, '\n', length);
+        if (newLine != nullptr) { length = newLine - (_characters + i) + 1; }
+        memcpy(pendingRecord.text + pendingRecord.length, _characters + i, length);
+        pendingRecord.length += (uint32_t)length;
+        i += length;
+        if (newLine != nullptr || pendingRecord.length == ASYNC_LOG_RECORD_SIZE) { PushPending(); }
+    }
+    return _count;
+}
+
+int CAsyncLogStream::CBuffer::sync()
+{
+    PushPending();
+    return 0;
+}
+
+bool CAsyncLogStream::CBuffer::WriteQueued(std::ostream& _output)
+{
+    bool wrote = false;
+    TAsyncLogRecord record;
+    while (queue.Pop(record)) {
+        _output.write(record.text, record.length);
+        writtenRecords.fetch_add(1, std::memory_order_relaxed);
+        wrote = true;
+    }
+    size_t drops = droppedRecords.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+        _output << "[async log] " << drops - reportedDrops << " records dropped because the queue was full" << std::endl;
+        reportedDrops = drops;
+        wrote = true;
+    }
+    if (wrote) { _output.flush(); }
+    return wrote;
+}
+
+//////////////////////////////
+// Stream
+//////////////////////////////
+
+CAsyncLogStream::CAsyncLogStream() : std::ostream(&buffer), output(nullptr), stopRequested(false)
+{
+}
+
+CAsyncLogStream::~CAsyncLogStream()
+{
+    Stop();
+}
+
+void CAsyncLogStream::Start(std::ostream* _output)
+{
+    Stop();
+    if (_output == nullptr) { return; }
+    output = _output;
+    stopRequested.store(false, std::memory_order_release);
+    writer = std::thread(&CAsyncLogStream::WriterLoop, this);
+}
+
+void CAsyncLogStream::Stop()
+{
+    if (!writer.joinable()) { return; }
+    stopRequested.store(true, std::memory_order_release);
+    writer.join();
+    buffer.WriteQueued(*output);                                // Records pushed until the writer stopped
+}
+
+void CAsyncLogStream::WriterLoop()
+{
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        if (!buffer.WriteQueued(*output)) { std::this_thread::sleep_for(std::chrono::milliseconds(ASYNC_LOG_IDLE_SLEEP_MS)); }
+    }
+}
+
+//////////////////////////////
+// Benchmark
+//////////////////////////////
+
+namespace {
+    /// Warning as the error handler formats it, with the numbers of a source too close to the listener
+    void WriteWarning(std::ostream& _stream, size_t _source, float _distance) {
+        _stream << "WARNING in CListenerHRTFbasedModel: source " << _source << " is " << _distance
+            << " m from the listener, closer than the near field ILD table; the nearest distance is used" << std::endl;
+    }
+
+    void PrintStatistics(const char* _name, std::vector<double>& _blockTimes, double _deadline) {
+        TTimingStatistics statistics = ComputeTimingStatistics(_blockTimes, _deadline);
+        char row[256];
+        std::snprintf(row, sizeof(row), "%10s %10.4f %10.4f %10.4f %12zu", _name, statistics.mean, statistics.p99, statistics.max, statistics.blocksOverDeadline);
+        std::cout << row << std::endl;
+    }
+}
+
+void RunAsyncLogBenchmark(CAsyncLogStream& _log, size_t _warningsPerBurst, size_t _blockSize, int _sampleRate)
+{
+    std::ofstream logFile(ASYNC_LOG_BENCHMARK_FILEPATH, std::ios::trunc);
+    if (!logFile) {
+        std::cout << "Could not open " << ASYNC_LOG_BENCHMARK_FILEPATH << std::endl;
+        return;
+    }
+    double deadline = 1000.0 * _blockSize / _sampleRate;
+    std::cout << std::endl << "Log benchmark: " << _warningsPerBurst << " warnings every " << ASYNC_LOG_BENCHMARK_BURST_EVERY << " blocks, deadline "
+        << deadline << " ms, written to " << ASYNC_LOG_BENCHMARK_FILEPATH << std::endl;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%10s %10s %10s %10s %12s", "stream", "mean ms", "p99 ms", "max ms", "over deadline");
+    std::cout << row << std::endl;
+
+    // Each block sleeps the rest of its deadline, so the writer thread runs meanwhile as it would next to the audio thread
+    auto runBlocks = [&](std::ostream& _stream) {
+        std::vector<double> blockTimes;
+        auto nextBlock = std::chrono::steady_clock::now();
+        for (size_t block = 0; block < ASYNC_LOG_BENCHMARK_BLOCKS; block++) {
+            CStopwatch stopwatch;
+            if (block % ASYNC_LOG_BENCHMARK_BURST_EVERY == 0) {
+                for (size_t i = 0; i < _warningsPerBurst; i++) { WriteWarning(_stream, i, 0.05f + 0.001f * i); }
+            }
+            blockTimes.push_back(stopwatch.GetElapsedMilliseconds());
+            nextBlock += std::chrono::microseconds((long long)(1000.0 * deadline));
+            std::this_thread::sleep_until(nextBlock);
+        }
+        return blockTimes;
+    };
+
+    std::vector<double> directTimes = runBlocks(logFile);
+    PrintStatistics("direct", directTimes, deadline);
+
+    std::ostream* previousOutput = _log.GetOutput();
+    _log.Start(&logFile);
+    size_t writtenBefore = _log.GetWrittenRecords(), droppedBefore = _log.GetDroppedRecords();
+    std::vector<double> asyncTimes = runBlocks(_log);
+    _log.Stop();
+    PrintStatistics("async", asyncTimes, deadline);
+    std::cout << "Async records written " << _log.GetWrittenRecords() - writtenBefore << ", dropped " << _log.GetDroppedRecords() - droppedBefore
+        << " (queue of " << ASYNC_LOG_CAPACITY << " records)" << std::endl;
+    if (previousOutput != nullptr) { _log.Start(previousOutput); }
+}
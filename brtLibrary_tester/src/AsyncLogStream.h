@@ -0,0 +1,116 @@
+/**
+*
+* \brief Asynchronous log stream: threads push fixed size records to a lock-free queue, a writer thread outputs them
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _ASYNCLOGSTREAM_H_
+#define _ASYNCLOGSTREAM_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include "MPSCRingBuffer.hpp"
+
+#define ASYNC_LOG_RECORD_SIZE           248         // Characters of a record; longer lines take several records
+#define ASYNC_LOG_CAPACITY              1024        // Records the queue holds before new ones are dropped
+#define ASYNC_LOG_IDLE_SLEEP_MS         2           // Sleep of the writer thread when the queue is empty
+#define ASYNC_LOG_BENCHMARK_BLOCKS      200         // Blocks of the log benchmark
+#define ASYNC_LOG_BENCHMARK_WARNINGS    256         // Warnings per burst of the log benchmark, by default
+#define ASYNC_LOG_BENCHMARK_BURST_EVERY 20          // The benchmark raises its burst of warnings once every this many blocks
+#define ASYNC_LOG_BENCHMARK_FILEPATH    "async_log_benchmark.log"
+
+/** \brief Text of one line, or part of a long line, as it was written to the stream
+*/
+struct TAsyncLogRecord {
+    uint32_t length;
+    char text[ASYNC_LOG_RECORD_SIZE];
+};
+
+/** \brief Output stream that never blocks the thread writing to it, meant to be given to BRT_ERRORHANDLER.SetErrorLogStream so
+*	warnings raised in the audio thread do not wait for the console. Each thread gathers its characters in a record of its own;
+*	a new line, a flush (std::endl) or a full record pushes the record to a lock-free queue, and a writer thread outputs the
+*	records to the real stream. When the queue is full the record is dropped and counted, and the writer reports the drops.
+*	\details Writing does not lock or allocate, but the stream state (flags, precision) is shared by the threads as with any
+*	std::ostream. Records are kept in thread-local storage shared by every instance, so there must be one instance only.
+*/
+class CAsyncLogStream : public std::ostream {
+public:
+    CAsyncLogStream();
+    ~CAsyncLogStream();
+
+    /** \brief Starts the writer thread
+    *	\param [in] _output stream the records are written to, which must outlive the writer
+    */
+    void Start(std::ostream* _output);
+
+    /** \brief Writes the queued records and stops the writer thread. Records pushed later wait for the next Start
+    */
+    void Stop();
+
+    /** \brief Stream the records are written to, nullptr before the first Start
+    */
+    std::ostream* GetOutput() const { return output; }
+
+    size_t GetWrittenRecords() const { return buffer.writtenRecords.load(std::memory_order_relaxed); }
+    size_t GetDroppedRecords() const { return buffer.droppedRecords.load(std::memory_order_relaxed); }
+
+private:
+    class CBuffer : public std::streambuf {
+    public:
+        CBuffer();
+
+        void PushPending();
+        /// Outputs every queued record and the drops not reported yet
+        bool WriteQueued(std::ostream& _output);
+
+        CMPSCRingBuffer<TAsyncLogRecord> queue;
+        std::atomic<size_t> writtenRecords;
+        std::atomic<size_t> droppedRecords;
+        size_t reportedDrops;                                   // Only used by the writer
+
+    protected:
+        int_type overflow(int_type _character) override;
+        std::streamsize xsputn(const char* _characters, std::streamsize _count) override;
+        int sync() override;
+    };
+
+    void WriterLoop();
+
+    CBuffer buffer;
+    std::ostream* output;
+    std::thread writer;
+    std::atomic<bool> stopRequested;
+};
+
+/** \brief Simulates the audio thread raising a burst of warnings every ASYNC_LOG_BENCHMARK_BURST_EVERY blocks, written to a log file
+*	first directly, as the error handler writes to std::cout, and then through the asynchronous stream writing to the same file.
+*	Prints the block times against the deadline of each, and the records dropped. The stream is restarted with its output afterwards
+*	\param [in] _log the asynchronous log stream of the application
+*	\param [in] _warningsPerBurst
+*	\param [in] _blockSize samples per block
+*	\param [in] _sampleRate Hz
+*/
+void RunAsyncLogBenchmark(CAsyncLogStream& _log, size_t _warningsPerBurst, size_t _blockSize, int _sampleRate);
+
+#endif
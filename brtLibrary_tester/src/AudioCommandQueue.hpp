@@ -0,0 +1,173 @@
+/**
+*
+* \brief Wait-free queue of commands from a control thread to the audio thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _AUDIOCOMMANDQUEUE_HPP_
+#define _AUDIOCOMMANDQUEUE_HPP_
+
+#include <memory>
+#include <BRTLibrary.h>
+#include "SPSCRingBuffer.hpp"
+
+#define AUDIO_COMMAND_QUEUE_CAPACITY    256
+
+/** \brief Changes a control thread can ask the audio thread to make
+*/
+enum TAudioCommandType {
+    AUDIO_COMMAND_SET_SOURCE_TRANSFORM,
+    AUDIO_COMMAND_RESET_SOURCE_TRAJECTORY,
+    AUDIO_COMMAND_ENABLE_INTERPOLATION,
+    AUDIO_COMMAND_DISABLE_INTERPOLATION,
+    AUDIO_COMMAND_ENABLE_NEAR_FIELD_EFFECT,
+    AUDIO_COMMAND_DISABLE_NEAR_FIELD_EFFECT,
+    AUDIO_COMMAND_SET_HRTF,
+    AUDIO_COMMAND_SET_ILD,
+    AUDIO_COMMAND_SELECT_HRTF
+};
+
+/** \brief One command. Resources travel in heap holders: the audio thread swaps the holder contents with the resource it
+*	replaces, and the holder goes back to the control side to be deleted, so the audio thread never frees memory
+*/
+struct TAudioCommand {
+    TAudioCommandType type;
+    BRTSourceModel::CSourceSimpleModel* source = nullptr;      // AUDIO_COMMAND_SET_SOURCE_TRANSFORM
+    Common::CTransform transform;                               // AUDIO_COMMAND_SET_SOURCE_TRANSFORM
+    std::shared_ptr<BRTServices::CHRTF>* hrtf = nullptr;        // AUDIO_COMMAND_SET_HRTF and AUDIO_COMMAND_SELECT_HRTF
+    std::shared_ptr<BRTServices::CILD>* ild = nullptr;          // AUDIO_COMMAND_SET_ILD
+};
+
+/** \brief Bounded, wait-free queue of commands from one control thread to the audio thread, which executes them at the top of
+*	each block. Objects the audio thread uses are only modified there, so the control side needs no locks.
+*	\details Push must be called from one non real-time thread, CollectRetired from one non real-time thread (the same or
+*	another) and Drain only from the audio thread. Commands Drain is asked to hold wait, in order, in a preallocated queue of
+*	the audio thread.
+*/
+class CAudioCommandQueue {
+public:
+    CAudioCommandQueue() : commands(AUDIO_COMMAND_QUEUE_CAPACITY), held(AUDIO_COMMAND_QUEUE_CAPACITY), retired(AUDIO_COMMAND_QUEUE_CAPACITY) {}
+
+    ~CAudioCommandQueue() {
+        CollectRetired();
+        TAudioCommand command;
+        while (held.Pop(command)) { DeleteHolders(command); }
+        while (commands.Pop(command)) { DeleteHolders(command); }
+    }
+
+    CAudioCommandQueue(const CAudioCommandQueue&) = delete;
+    CAudioCommandQueue& operator=(const CAudioCommandQueue&) = delete;
+
+    /** \brief Sends a command
+    *	\retval false if the queue is full, the command (and its resources) is discarded
+    */
+    bool Push(const TAudioCommand& _command) {
+        if (commands.Push(_command)) { return true; }
+        DeleteHolders(_command);
+        return false;
+    }
+
+    bool PushCommand(TAudioCommandType _type) {
+        TAudioCommand command;
+        command.type = _type;
+        return Push(command);
+    }
+
+    bool PushSourceTransform(BRTSourceModel::CSourceSimpleModel* _source, const Common::CTransform& _transform) {
+        TAudioCommand command;
+        command.type = AUDIO_COMMAND_SET_SOURCE_TRANSFORM;
+        command.source = _source;
+        command.transform = _transform;
+        return Push(command);
+    }
+
+    bool PushHRTF(std::shared_ptr<BRTServices::CHRTF> _hrtf) {
+        TAudioCommand command;
+        command.type = AUDIO_COMMAND_SET_HRTF;
+        command.hrtf = new std::shared_ptr<BRTServices::CHRTF>(std::move(_hrtf));
+        return Push(command);
+    }
+
+    /** \brief Switches to an HRTF already in memory, with a crossfade. The holder carries back the HRTF it replaces
+    */
+    bool PushSelectHRTF(std::shared_ptr<BRTServices::CHRTF> _hrtf) {
+        TAudioCommand command;
+        command.type = AUDIO_COMMAND_SELECT_HRTF;
+        command.hrtf = new std::shared_ptr<BRTServices::CHRTF>(std::move(_hrtf));
+        return Push(command);
+    }
+
+    bool PushILD(std::shared_ptr<BRTServices::CILD> _ild) {
+        TAudioCommand command;
+        command.type = AUDIO_COMMAND_SET_ILD;
+        command.ild = new std::shared_ptr<BRTServices::CILD>(std::move(_ild));
+        return Push(command);
+    }
+
+    /** \brief Executes the pending commands. Wait-free, to be called from the audio thread at the top of a block
+    *	\param [in] _execute callable with signature void(TAudioCommand&). For resource commands it must leave in the holder the
+    *	resource it replaced, which is released later by the control thread
+    */
+    template <class TExecute>
+    void Drain(TExecute _execute) {
+        Drain(_execute, [](const TAudioCommand&) { return false; }, false);
+    }
+
+    /** \brief Executes the pending commands, except those that must wait. Wait-free, to be called from the audio thread at the top of a block
+    *	\param [in] _execute as in Drain(_execute)
+    *	\param [in] _isHoldable callable with signature bool(const TAudioCommand&), true for the commands that wait while _hold is set
+    *	\param [in] _hold true to keep holdable commands for a later Drain. Once it is false, held commands run first, in the order they came
+    */
+    template <class TExecute, class THoldable>
+    void Drain(TExecute _execute, THoldable _isHoldable, bool _hold) {
+        TAudioCommand command;
+        if (!_hold) {
+            while (retired.GetWriteAvailable() > 0 && held.Pop(command)) { Execute(_execute, command); }
+        }
+        while (retired.GetWriteAvailable() > 0 && held.GetWriteAvailable() > 0 && commands.Pop(command)) {     // Stops if the control side is late collecting
+            if (_isHoldable(command) && (_hold || held.GetReadAvailable() > 0)) { held.Push(command); }         // Never ahead of older held commands
+            else { Execute(_execute, command); }
+        }
+    }
+
+    /** \brief Deletes the holders of the resources the audio thread has replaced
+    */
+    void CollectRetired() {
+        TAudioCommand command;
+        while (retired.Pop(command)) { DeleteHolders(command); }
+    }
+
+private:
+    template <class TExecute>
+    void Execute(TExecute& _execute, TAudioCommand& _command) {
+        _execute(_command);
+        if (_command.hrtf != nullptr || _command.ild != nullptr) { retired.Push(_command); }
+    }
+
+    static void DeleteHolders(const TAudioCommand& _command) {
+        delete _command.hrtf;
+        delete _command.ild;
+    }
+
+    CSPSCRingBuffer<TAudioCommand> commands;                    // Control thread to audio thread
+    CSPSCRingBuffer<TAudioCommand> held;                        // Commands the audio thread keeps for later, written and read only by it
+    CSPSCRingBuffer<TAudioCommand> retired;                     // Audio thread back to control thread
+};
+
+#endif
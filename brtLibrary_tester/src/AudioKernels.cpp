@@ -0,0 +1,429 @@
+/**
+*
+* \brief SIMD sample format conversion, interleave and buffer kernels, dispatched at run time
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#include "AudioKernels.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define AUDIO_KERNELS_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define AUDIO_KERNELS_TARGET(_isa)                           // MSVC compiles any intrinsic without flags
+    #else
+        #define AUDIO_KERNELS_TARGET(_isa) __attribute__((target(_isa)))
+    #endif
+#endif
+
+namespace {
+    const float INT16_SCALE = 1.0f / 32768.0f;
+    const float INT32_SCALE = 1.0f / 2147483648.0f;                 // 24 bit samples are converted shifted to the top of 32 bits
+    const float HALF_EXPONENT_SCALE = 5.192296858534828e33f;        // 2^112: exponent bias of float minus that of half, also exact for subnormals
+
+    //////////////////////////////
+    // SCALAR, endian independent
+    //////////////////////////////
+
+    void ScalarConvertInt16ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++, _input += 2) {
+            _output[i] = (float)int16_t(_input[0] | (_input[1] << 8)) * INT16_SCALE;
+        }
+    }
+
+    void ScalarConvertInt24ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++, _input += 3) {
+            _output[i] = (float)int32_t(uint32_t(_input[0]) << 8 | uint32_t(_input[1]) << 16 | uint32_t(_input[2]) << 24) * INT32_SCALE;
+        }
+    }
+
+    void ScalarConvertInt32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++, _input += 4) {
+            _output[i] = (float)int32_t(uint32_t(_input[0]) | uint32_t(_input[1]) << 8 | uint32_t(_input[2]) << 16 | uint32_t(_input[3]) << 24) * INT32_SCALE;
+        }
+    }
+
+    void ScalarConvertFloat32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++, _input += 4) {
+            uint32_t bits = uint32_t(_input[0]) | uint32_t(_input[1]) << 8 | uint32_t(_input[2]) << 16 | uint32_t(_input[3]) << 24;
+            std::memcpy(&_output[i], &bits, sizeof(float));
+        }
+    }
+
+    void ScalarInterleave(const float* _left, const float* _right, float* _output, size_t _numberOfFrames) {
+        for (size_t i = 0; i < _numberOfFrames; i++) {
+            _output[2 * i] = _left[i];
+            _output[2 * i + 1] = _right[i];
+        }
+    }
+
+    /// Zeroing is left to memset, which the C library tunes for each CPU
+    bool IsPositiveZero(float _value) {
+        uint32_t bits;
+        std::memcpy(&bits, &_value, sizeof(bits));
+        return bits == 0;
+    }
+
+    void ScalarFill(float* _buffer, float _value, size_t _count) {
+        if (IsPositiveZero(_value)) { std::memset(_buffer, 0, _count * sizeof(float)); return; }
+        for (size_t i = 0; i < _count; i++) { _buffer[i] = _value; }
+    }
+
+    void ScalarAccumulate(float* _buffer, const float* _input, size_t _count) {
+        for (size_t i = 0; i < _count; i++) { _buffer[i] += _input[i]; }
+    }
+
+    /// Exponent and mantissa are moved to their float positions and the bias is fixed with a multiplication. Infinity and NaN
+    /// are not expected, the compact spectra are saturated when stored
+    void ScalarExpandHalfToFloat(const uint16_t* _input, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++) {
+            uint32_t magnitudeBits = uint32_t(_input[i] & 0x7fff) << 13;
+            float magnitude;
+            std::memcpy(&magnitude, &magnitudeBits, sizeof(float));
+            magnitude *= HALF_EXPONENT_SCALE;
+            _output[i] = (_input[i] & 0x8000) ? -magnitude : magnitude;
+        }
+    }
+
+    void ScalarExpandInt16ToFloat(const int16_t* _input, float _scale, float* _output, size_t _count) {
+        for (size_t i = 0; i < _count; i++) { _output[i] = (float)_input[i] * _scale; }
+    }
+
+    /// Lanes _firstLane to _numberOfLanes - 1. Every implementation uses this operation order, so results are bit-identical
+    void ScalarProcessBiquadLanesFrom(float* _samples, size_t _numberOfFrames, size_t _numberOfLanes, const float* _coefficients, float* _states, size_t _numberOfStages, size_t _firstLane) {
+        for (size_t stage = 0; stage < _numberOfStages; stage++) {
+            const float* coefficients = _coefficients + stage * 5 * _numberOfLanes;
+            float* states = _states + stage * 2 * _numberOfLanes;
+            for (size_t lane = _firstLane; lane < _numberOfLanes; lane++) {
+                float b0 = coefficients[lane], b1 = coefficients[_numberOfLanes + lane], b2 = coefficients[2 * _numberOfLanes + lane];
+                float a1 = coefficients[3 * _numberOfLanes + lane], a2 = coefficients[4 * _numberOfLanes + lane];
+                float s1 = states[lane], s2 = states[_numberOfLanes + lane];
+                for (size_t frame = 0; frame < _numberOfFrames; frame++) {
+                    float x = _samples[frame * _numberOfLanes + lane];
+                    float y = b0 * x + s1;
+                    s1 = (b1 * x - a1 * y) + s2;
+                    s2 = b2 * x - a2 * y;
+                    _samples[frame * _numberOfLanes + lane] = y;
+                }
+                states[lane] = s1;
+                states[_numberOfLanes + lane] = s2;
+            }
+        }
+    }
+
+    void ScalarProcessBiquadLanes(float* _samples, size_t _numberOfFrames, size_t _numberOfLanes, const float* _coefficients, float* _states, size_t _numberOfStages) {
+        ScalarProcessBiquadLanesFrom(_samples, _numberOfFrames, _numberOfLanes, _coefficients, _states, _numberOfStages, 0);
+    }
+
+    const TAudioKernels SCALAR_KERNELS = { "scalar", ScalarConvertInt16ToFloat, ScalarConvertInt24ToFloat, ScalarConvertInt32ToFloat,
+        ScalarConvertFloat32ToFloat, ScalarInterleave, ScalarFill, ScalarAccumulate, ScalarExpandHalfToFloat, ScalarExpandInt16ToFloat,
+        ScalarProcessBiquadLanes };
+
+#if defined(AUDIO_KERNELS_X86)
+
+    //////////////////////////////
+    // SSE (SSSE3), x86 is little endian
+    //////////////////////////////
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEConvertInt16ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m128 scale = _mm_set1_ps(INT16_SCALE);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m128i samples = _mm_loadu_si128((const __m128i*)(_input + 2 * i));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), samples), 16);       // Sign extension
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), samples), 16);
+            _mm_storeu_ps(_output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+            _mm_storeu_ps(_output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+        ScalarConvertInt16ToFloat(_input + 2 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEConvertInt24ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m128 scale = _mm_set1_ps(INT32_SCALE);
+        const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);     // Each sample to the top 24 bits
+        size_t i = 0;
+        for (; i + 6 <= _count; i += 4) {                       // 16 bytes are loaded to use 12
+            __m128i samples = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(_input + 3 * i)), shuffle);
+            _mm_storeu_ps(_output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scale));
+        }
+        ScalarConvertInt24ToFloat(_input + 3 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEConvertInt32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m128 scale = _mm_set1_ps(INT32_SCALE);
+        size_t i = 0;
+        for (; i + 4 <= _count; i += 4) {
+            __m128i samples = _mm_loadu_si128((const __m128i*)(_input + 4 * i));
+            _mm_storeu_ps(_output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scale));
+        }
+        ScalarConvertInt32ToFloat(_input + 4 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEConvertFloat32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        size_t i = 0;
+        for (; i + 4 <= _count; i += 4) { _mm_storeu_ps(_output + i, _mm_loadu_ps((const float*)(_input + 4 * i))); }
+        ScalarConvertFloat32ToFloat(_input + 4 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEInterleave(const float* _left, const float* _right, float* _output, size_t _numberOfFrames) {
+        size_t i = 0;
+        for (; i + 4 <= _numberOfFrames; i += 4) {
+            __m128 left = _mm_loadu_ps(_left + i);
+            __m128 right = _mm_loadu_ps(_right + i);
+            _mm_storeu_ps(_output + 2 * i, _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(_output + 2 * i + 4, _mm_unpackhi_ps(left, right));
+        }
+        ScalarInterleave(_left + i, _right + i, _output + 2 * i, _numberOfFrames - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEFill(float* _buffer, float _value, size_t _count) {
+        if (IsPositiveZero(_value)) { std::memset(_buffer, 0, _count * sizeof(float)); return; }
+        const __m128 value = _mm_set1_ps(_value);
+        size_t i = 0;
+        for (; i + 4 <= _count; i += 4) { _mm_storeu_ps(_buffer + i, value); }
+        ScalarFill(_buffer + i, _value, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEAccumulate(float* _buffer, const float* _input, size_t _count) {
+        size_t i = 0;
+        for (; i + 4 <= _count; i += 4) { _mm_storeu_ps(_buffer + i, _mm_add_ps(_mm_loadu_ps(_buffer + i), _mm_loadu_ps(_input + i))); }
+        ScalarAccumulate(_buffer + i, _input + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEExpandHalfToFloat(const uint16_t* _input, float* _output, size_t _count) {
+        const __m128 scale = _mm_set1_ps(HALF_EXPONENT_SCALE);
+        const __m128i magnitudeMask = _mm_set1_epi32(0x7fff);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m128i halves = _mm_loadu_si128((const __m128i*)(_input + i));
+            __m128i words[2] = { _mm_unpacklo_epi16(halves, _mm_setzero_si128()), _mm_unpackhi_epi16(halves, _mm_setzero_si128()) };
+            for (int w = 0; w < 2; w++) {
+                __m128i sign = _mm_slli_epi32(_mm_srli_epi32(words[w], 15), 31);
+                __m128 magnitude = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(words[w], magnitudeMask), 13)), scale);
+                _mm_storeu_ps(_output + i + 4 * w, _mm_or_ps(magnitude, _mm_castsi128_ps(sign)));
+            }
+        }
+        ScalarExpandHalfToFloat(_input + i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEExpandInt16ToFloat(const int16_t* _input, float _scale, float* _output, size_t _count) {
+        const __m128 scale = _mm_set1_ps(_scale);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m128i samples = _mm_loadu_si128((const __m128i*)(_input + i));
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), samples), 16);       // Sign extension
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(_mm_setzero_si128(), samples), 16);
+            _mm_storeu_ps(_output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+            _mm_storeu_ps(_output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+        ScalarExpandInt16ToFloat(_input + i, _scale, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("ssse3") void SSEProcessBiquadLanes(float* _samples, size_t _numberOfFrames, size_t _numberOfLanes, const float* _coefficients, float* _states, size_t _numberOfStages) {
+        size_t lanes = _numberOfLanes & ~size_t(3);
+        for (size_t stage = 0; stage < _numberOfStages; stage++) {
+            const float* coefficients = _coefficients + stage * 5 * _numberOfLanes;
+            float* states = _states + stage * 2 * _numberOfLanes;
+            for (size_t lane = 0; lane < lanes; lane += 4) {
+                __m128 b0 = _mm_loadu_ps(coefficients + lane), b1 = _mm_loadu_ps(coefficients + _numberOfLanes + lane), b2 = _mm_loadu_ps(coefficients + 2 * _numberOfLanes + lane);
+                __m128 a1 = _mm_loadu_ps(coefficients + 3 * _numberOfLanes + lane), a2 = _mm_loadu_ps(coefficients + 4 * _numberOfLanes + lane);
+                __m128 s1 = _mm_loadu_ps(states + lane), s2 = _mm_loadu_ps(states + _numberOfLanes + lane);
+                for (size_t frame = 0; frame < _numberOfFrames; frame++) {
+                    float* samples = _samples + frame * _numberOfLanes + lane;
+                    __m128 x = _mm_loadu_ps(samples);
+                    __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+                    s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+                    s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+                    _mm_storeu_ps(samples, y);
+                }
+                _mm_storeu_ps(states + lane, s1);
+                _mm_storeu_ps(states + _numberOfLanes + lane, s2);
+            }
+        }
+        ScalarProcessBiquadLanesFrom(_samples, _numberOfFrames, _numberOfLanes, _coefficients, _states, _numberOfStages, lanes);
+    }
+
+    const TAudioKernels SSE_KERNELS = { "sse", SSEConvertInt16ToFloat, SSEConvertInt24ToFloat, SSEConvertInt32ToFloat,
+        SSEConvertFloat32ToFloat, SSEInterleave, SSEFill, SSEAccumulate, SSEExpandHalfToFloat, SSEExpandInt16ToFloat,
+        SSEProcessBiquadLanes };
+
+    //////////////////////////////
+    // AVX2
+    //////////////////////////////
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ConvertInt16ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m256 scale = _mm256_set1_ps(INT16_SCALE);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(_input + 2 * i)));
+            _mm256_storeu_ps(_output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+        ScalarConvertInt16ToFloat(_input + 2 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ConvertInt24ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m256 scale = _mm256_set1_ps(INT32_SCALE);
+        const __m256i shuffle = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                                 -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+        size_t i = 0;
+        for (; i + 10 <= _count; i += 8) {                      // Two 16 byte loads, 12 bytes apart
+            const uint8_t* input = _input + 3 * i;
+            __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)input)),
+                                                    _mm_loadu_si128((const __m128i*)(input + 12)), 1);
+            __m256i samples = _mm256_shuffle_epi8(bytes, shuffle);
+            _mm256_storeu_ps(_output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+        ScalarConvertInt24ToFloat(_input + 3 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ConvertInt32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        const __m256 scale = _mm256_set1_ps(INT32_SCALE);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m256i samples = _mm256_loadu_si256((const __m256i*)(_input + 4 * i));
+            _mm256_storeu_ps(_output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+        ScalarConvertInt32ToFloat(_input + 4 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ConvertFloat32ToFloat(const uint8_t* _input, float* _output, size_t _count) {
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) { _mm256_storeu_ps(_output + i, _mm256_loadu_ps((const float*)(_input + 4 * i))); }
+        ScalarConvertFloat32ToFloat(_input + 4 * i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2Interleave(const float* _left, const float* _right, float* _output, size_t _numberOfFrames) {
+        size_t i = 0;
+        for (; i + 8 <= _numberOfFrames; i += 8) {
+            __m256 left = _mm256_loadu_ps(_left + i);
+            __m256 right = _mm256_loadu_ps(_right + i);
+            __m256 low = _mm256_unpacklo_ps(left, right);       // l0 r0 l1 r1 | l4 r4 l5 r5
+            __m256 high = _mm256_unpackhi_ps(left, right);      // l2 r2 l3 r3 | l6 r6 l7 r7
+            _mm256_storeu_ps(_output + 2 * i, _mm256_permute2f128_ps(low, high, 0x20));
+            _mm256_storeu_ps(_output + 2 * i + 8, _mm256_permute2f128_ps(low, high, 0x31));
+        }
+        ScalarInterleave(_left + i, _right + i, _output + 2 * i, _numberOfFrames - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2Fill(float* _buffer, float _value, size_t _count) {
+        if (IsPositiveZero(_value)) { std::memset(_buffer, 0, _count * sizeof(float)); return; }
+        const __m256 value = _mm256_set1_ps(_value);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) { _mm256_storeu_ps(_buffer + i, value); }
+        ScalarFill(_buffer + i, _value, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2Accumulate(float* _buffer, const float* _input, size_t _count) {
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) { _mm256_storeu_ps(_buffer + i, _mm256_add_ps(_mm256_loadu_ps(_buffer + i), _mm256_loadu_ps(_input + i))); }
+        ScalarAccumulate(_buffer + i, _input + i, _count - i);
+    }
+
+    /// Same bit manipulation as the scalar version; F16C would do it in one instruction, but it would need its own CPU check
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ExpandHalfToFloat(const uint16_t* _input, float* _output, size_t _count) {
+        const __m256 scale = _mm256_set1_ps(HALF_EXPONENT_SCALE);
+        const __m256i magnitudeMask = _mm256_set1_epi32(0x7fff);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m256i words = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(_input + i)));
+            __m256i sign = _mm256_slli_epi32(_mm256_srli_epi32(words, 15), 31);
+            __m256 magnitude = _mm256_mul_ps(_mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(words, magnitudeMask), 13)), scale);
+            _mm256_storeu_ps(_output + i, _mm256_or_ps(magnitude, _mm256_castsi256_ps(sign)));
+        }
+        ScalarExpandHalfToFloat(_input + i, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ExpandInt16ToFloat(const int16_t* _input, float _scale, float* _output, size_t _count) {
+        const __m256 scale = _mm256_set1_ps(_scale);
+        size_t i = 0;
+        for (; i + 8 <= _count; i += 8) {
+            __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(_input + i)));
+            _mm256_storeu_ps(_output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+        }
+        ScalarExpandInt16ToFloat(_input + i, _scale, _output + i, _count - i);
+    }
+
+    AUDIO_KERNELS_TARGET("avx2") void AVX2ProcessBiquadLanes(float* _samples, size_t _numberOfFrames, size_t _numberOfLanes, const float* _coefficients, float* _states, size_t _numberOfStages) {
+        size_t lanes = _numberOfLanes & ~size_t(7);
+        for (size_t stage = 0; stage < _numberOfStages; stage++) {
+            const float* coefficients = _coefficients + stage * 5 * _numberOfLanes;
+            float* states = _states + stage * 2 * _numberOfLanes;
+            for (size_t lane = 0; lane < lanes; lane += 8) {
+                __m256 b0 = _mm256_loadu_ps(coefficients + lane), b1 = _mm256_loadu_ps(coefficients + _numberOfLanes + lane), b2 = _mm256_loadu_ps(coefficients + 2 * _numberOfLanes + lane);
+                __m256 a1 = _mm256_loadu_ps(coefficients + 3 * _numberOfLanes + lane), a2 = _mm256_loadu_ps(coefficients + 4 * _numberOfLanes + lane);
+                __m256 s1 = _mm256_loadu_ps(states + lane), s2 = _mm256_loadu_ps(states + _numberOfLanes + lane);
+                for (size_t frame = 0; frame < _numberOfFrames; frame++) {
+                    float* samples = _samples + frame * _numberOfLanes + lane;
+                    __m256 x = _mm256_loadu_ps(samples);
+                    __m256 y = _mm256_add_ps(_mm256_mul_ps(b0, x), s1);             // No FMA, to round as the scalar code does
+                    s1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(b1, x), _mm256_mul_ps(a1, y)), s2);
+                    s2 = _mm256_sub_ps(_mm256_mul_ps(b2, x), _mm256_mul_ps(a2, y));
+                    _mm256_storeu_ps(samples, y);
+                }
+                _mm256_storeu_ps(states + lane, s1);
+                _mm256_storeu_ps(states + _numberOfLanes + lane, s2);
+            }
+        }
+        ScalarProcessBiquadLanesFrom(_samples, _numberOfFrames, _numberOfLanes, _coefficients, _states, _numberOfStages, lanes);
+    }
+
+    const TAudioKernels AVX2_KERNELS = { "avx2", AVX2ConvertInt16ToFloat, AVX2ConvertInt24ToFloat, AVX2ConvertInt32ToFloat,
+        AVX2ConvertFloat32ToFloat, AVX2Interleave, AVX2Fill, AVX2Accumulate, AVX2ExpandHalfToFloat, AVX2ExpandInt16ToFloat,
+        AVX2ProcessBiquadLanes };
+
+    bool CPUSupports(TAudioKernelsLevel _level) {
+    #if defined(_MSC_VER)
+        int registers[4];
+        __cpuid(registers, 0);
+        int maximumLeaf = registers[0];
+        __cpuid(registers, 1);
+        bool ssse3 = (registers[2] & (1 << 9)) != 0;
+        if (_level == AUDIO_KERNELS_SSE) { return ssse3; }
+        bool osSavesAVX = (registers[2] & (1 << 27)) != 0 && (registers[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        if (!osSavesAVX || maximumLeaf < 7) { return false; }
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+    #else
+        __builtin_cpu_init();
+        if (_level == AUDIO_KERNELS_SSE) { return __builtin_cpu_supports("ssse3"); }
+        return __builtin_cpu_supports("avx2");                  // Also checks that the OS saves the AVX registers
+    #endif
+    }
+#endif
+}
+
+const TAudioKernels* GetAudioKernels(TAudioKernelsLevel _level)
+{
+    if (_level == AUDIO_KERNELS_SCALAR) { return &SCALAR_KERNELS; }
+#if defined(AUDIO_KERNELS_X86)
+    if (_level == AUDIO_KERNELS_SSE && CPUSupports(AUDIO_KERNELS_SSE)) { return &SSE_KERNELS; }
+    if (_level == AUDIO_KERNELS_AVX2 && CPUSupports(AUDIO_KERNELS_AVX2)) { return &AVX2_KERNELS; }
+#endif
+    return nullptr;
+}
+
+const TAudioKernels& GetAudioKernels()
+{
+    static const TAudioKernels* bestKernels = GetAudioKernels(AUDIO_KERNELS_AVX2) ? GetAudioKernels(AUDIO_KERNELS_AVX2)
+        : GetAudioKernels(AUDIO_KERNELS_SSE) ? GetAudioKernels(AUDIO_KERNELS_SSE) : GetAudioKernels(AUDIO_KERNELS_SCALAR);
+    return *bestKernels;
+}
@@ -0,0 +1,62 @@
+/**
+*
+* \brief SIMD sample format conversion, interleave and buffer kernels, dispatched at run time
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _AUDIOKERNELS_H_
+#define _AUDIOKERNELS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/** \brief Instruction sets the kernels are implemented with
+*/
+enum TAudioKernelsLevel { AUDIO_KERNELS_SCALAR, AUDIO_KERNELS_SSE, AUDIO_KERNELS_AVX2 };
+
+/** \brief Kernels of the I/O edges of the audio path. Conversions read little-endian ".wav" samples at any alignment and
+*	scale integers to [-1, 1); expansions read the compact HRIR spectra. Every implementation gives bit-identical results.
+*/
+struct TAudioKernels {
+    const char* name;
+    void (*ConvertInt16ToFloat)(const uint8_t* _input, float* _output, size_t _count);
+    void (*ConvertInt24ToFloat)(const uint8_t* _input, float* _output, size_t _count);
+    void (*ConvertInt32ToFloat)(const uint8_t* _input, float* _output, size_t _count);
+    void (*ConvertFloat32ToFloat)(const uint8_t* _input, float* _output, size_t _count);
+    void (*Interleave)(const float* _left, const float* _right, float* _output, size_t _numberOfFrames);
+    void (*Fill)(float* _buffer, float _value, size_t _count);
+    void (*Accumulate)(float* _buffer, const float* _input, size_t _count);          // _buffer += _input
+    void (*ExpandHalfToFloat)(const uint16_t* _input, float* _output, size_t _count);                // IEEE half precision, finite
+    void (*ExpandInt16ToFloat)(const int16_t* _input, float _scale, float* _output, size_t _count);  // _output = _input * _scale
+    /// Cascades of transposed direct form II biquads, one per lane, run in place. _samples is [frame][lane]; _coefficients is
+    /// [stage][b0 b1 b2 a1 a2][lane] and _states [stage][s1 s2][lane]
+    void (*ProcessBiquadLanes)(float* _samples, size_t _numberOfFrames, size_t _numberOfLanes, const float* _coefficients, float* _states, size_t _numberOfStages);
+};
+
+/** \brief Returns the kernels of the best instruction set the CPU supports, selected on the first call
+*/
+const TAudioKernels& GetAudioKernels();
+
+/** \brief Returns the kernels of an instruction set
+*	\param [in] _level
+*	\retval nullptr if the CPU (or the build) does not support it
+*/
+const TAudioKernels* GetAudioKernels(TAudioKernelsLevel _level);
+
+#endif
@@ -0,0 +1,241 @@
+/**
+*
+* \brief Micro-benchmark of the audio I/O kernels
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#include "AudioKernelsBenchmark.h"
+#include "AudioKernels.h"
+#include "FixedSizeKernels.h"
+#include "PartitionedConvolver.h"
+#include "ProcessingStatistics.hpp"
+#include <BRTLibrary.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    volatile float benchmarkSink;           // Keeps the compiler from removing the measured work
+
+    /// Runs _kernel until KERNELS_BENCHMARK_SECONDS have passed and returns the throughput
+    double MeasureGigabytesPerSecond(const std::function<void()>& _kernel, size_t _bytesPerCall) {
+        _kernel();                                              // Warm up caches
+        size_t calls = 0;
+        CStopwatch stopwatch;
+        double elapsedMilliseconds = 0;
+        do {
+            _kernel();
+            calls++;
+            elapsedMilliseconds = stopwatch.GetElapsedMilliseconds();
+        } while (elapsedMilliseconds < 1000.0 * KERNELS_BENCHMARK_SECONDS);
+        return (double)calls * _bytesPerCall / (elapsedMilliseconds * 1e6);
+    }
+
+    /// Runs _kernel until KERNELS_BENCHMARK_SECONDS have passed and returns the mean time per call
+    double MeasureNanosecondsPerCall(const std::function<void()>& _kernel) {
+        _kernel();
+        size_t calls = 0;
+        CStopwatch stopwatch;
+        double elapsedMilliseconds = 0;
+        do {
+            _kernel();
+            calls++;
+            elapsedMilliseconds = stopwatch.GetElapsedMilliseconds();
+        } while (elapsedMilliseconds < 1000.0 * KERNELS_BENCHMARK_SECONDS);
+        return 1e6 * elapsedMilliseconds / calls;
+    }
+
+    //////////////////////////////
+    // Code replaced by the kernels
+    //////////////////////////////
+
+    /// Conversion as LoadWav did it: bytes to int16 array, then to float with push_back
+    void LegacyConvertInt16ToFloat(const std::vector<uint8_t>& _input, std::vector<float>& _output, size_t _count) {
+        std::vector<int16_t> sample(_count);
+        for (size_t i = 0; i < _count; i++) { sample[i] = int16_t(_input[2 * i] | _input[2 * i + 1] << 8); }
+        _output.clear();
+        for (size_t i = 0; i < _count; i++) { _output.push_back((float)sample[i] / (float)INT16_MAX); }
+    }
+
+    /// Copy as FillBuffer did it, with a bounds check per sample
+    void LegacyFillBuffer(const std::vector<float>& _samples, CMonoBuffer<float>& _output) {
+        for (size_t i = 0; i < _output.size(); i++) {
+            if (i < _samples.size()) { _output[i] = _samples[i]; }
+            else { _output[i] = 0.0f; }
+        }
+    }
+
+    /// Interleave as rtAudioCallback did it: Interlace in a stereo buffer, then copy sample by sample
+    void LegacyInterleave(const Common::CEarPair<CMonoBuffer<float>>& _input, CStereoBuffer<float>& _interlaced, float* _output) {
+        _interlaced.Interlace(_input.left, _input.right);
+        for (auto it = _interlaced.begin(); it != _interlaced.end(); it++) { *_output++ = *it; }
+    }
+
+    void PrintRow(const std::string& _kernel, double _legacy, const std::vector<double>& _gigabytesPerSecond) {
+        char row[256];
+        int length = std::snprintf(row, sizeof(row), "%12s", _kernel.c_str());
+        if (_legacy > 0) { length += std::snprintf(row + length, sizeof(row) - length, " %10.2f", _legacy); }
+        else { length += std::snprintf(row + length, sizeof(row) - length, " %10s", "-"); }
+        for (double value : _gigabytesPerSecond) { length += std::snprintf(row + length, sizeof(row) - length, " %10.2f", value); }
+        std::cout << row << std::endl;
+    }
+
+    void RunBenchmark(size_t _numberOfFrames) {
+        std::vector<const TAudioKernels*> kernelSets;
+        for (TAudioKernelsLevel level : { AUDIO_KERNELS_SCALAR, AUDIO_KERNELS_SSE, AUDIO_KERNELS_AVX2 }) {
+            if (GetAudioKernels(level) != nullptr) { kernelSets.push_back(GetAudioKernels(level)); }
+        }
+
+        std::vector<uint8_t> wavBytes(4 * _numberOfFrames);
+        for (size_t i = 0; i < wavBytes.size(); i++) { wavBytes[i] = uint8_t(i * 2654435761u >> 13); }
+        std::vector<float> samples(_numberOfFrames, 0.25f);
+        Common::CEarPair<CMonoBuffer<float>> stereo;
+        stereo.left.resize(_numberOfFrames, 0.5f);
+        stereo.right.resize(_numberOfFrames, -0.5f);
+        CMonoBuffer<float> mono(_numberOfFrames);
+        CStereoBuffer<float> interlaced;
+        std::vector<float> output(2 * _numberOfFrames);
+        size_t n = _numberOfFrames;
+
+        std::cout << std::endl << n << " frames (" << (n * sizeof(float)) / 1024 << " KiB per float channel), GB/s" << std::endl;
+        char header[256];
+        int length = std::snprintf(header, sizeof(header), "%12s %10s", "kernel", "current");
+        for (const TAudioKernels* kernels : kernelSets) { length += std::snprintf(header + length, sizeof(header) - length, " %10s", kernels->name); }
+        std::cout << header << std::endl;
+
+        auto measureAll = [&](const std::function<void(const TAudioKernels*)>& _call, size_t _bytes) {
+            std::vector<double> results;
+            for (const TAudioKernels* kernels : kernelSets) { results.push_back(MeasureGigabytesPerSecond([&]() { _call(kernels); }, _bytes)); }
+            return results;
+        };
+
+        double legacy = MeasureGigabytesPerSecond([&]() { LegacyConvertInt16ToFloat(wavBytes, samples, n); }, n * (2 + 4));
+        PrintRow("int16>float", legacy, measureAll([&](const TAudioKernels* k) { k->ConvertInt16ToFloat(wavBytes.data(), samples.data(), n); }, n * (2 + 4)));
+        PrintRow("int24>float", 0, measureAll([&](const TAudioKernels* k) { k->ConvertInt24ToFloat(wavBytes.data(), samples.data(), n); }, n * (3 + 4)));
+        PrintRow("int32>float", 0, measureAll([&](const TAudioKernels* k) { k->ConvertInt32ToFloat(wavBytes.data(), samples.data(), n); }, n * (4 + 4)));
+
+        legacy = MeasureGigabytesPerSecond([&]() { LegacyFillBuffer(samples, mono); }, n * (4 + 4));
+        PrintRow("copy", legacy, measureAll([&](const TAudioKernels* k) { k->ConvertFloat32ToFloat((const uint8_t*)samples.data(), mono.data(), n); }, n * (4 + 4)));
+
+        legacy = MeasureGigabytesPerSecond([&]() { LegacyInterleave(stereo, interlaced, output.data()); }, n * (8 + 8));
+        PrintRow("interleave", legacy, measureAll([&](const TAudioKernels* k) { k->Interleave(stereo.left.data(), stereo.right.data(), output.data(), n); }, n * (8 + 8)));
+
+        legacy = MeasureGigabytesPerSecond([&]() { mono.Fill(n, 0.0f); }, n * 4);
+        PrintRow("zero", legacy, measureAll([&](const TAudioKernels* k) { k->Fill(mono.data(), 0.0f, n); }, n * 4));
+
+        legacy = MeasureGigabytesPerSecond([&]() { stereo.left += stereo.right; }, n * (8 + 4));
+        PrintRow("accumulate", legacy, measureAll([&](const TAudioKernels* k) { k->Accumulate(stereo.left.data(), stereo.right.data(), n); }, n * (8 + 4)));
+
+        std::vector<uint16_t> halves(n, 0x3c00);
+        PrintRow("half>float", 0, measureAll([&](const TAudioKernels* k) { k->ExpandHalfToFloat(halves.data(), samples.data(), n); }, n * (2 + 4)));
+        PrintRow("q16>float", 0, measureAll([&](const TAudioKernels* k) { k->ExpandInt16ToFloat((const int16_t*)halves.data(), 1e-4f, samples.data(), n); }, n * (2 + 4)));
+
+        // Two stage cascades in 8 lanes over the same samples, as the near field filters of 4 sources
+        std::vector<float> biquadCoefficients(2 * 5 * 8, 0.0f);
+        std::vector<float> biquadStates(2 * 2 * 8, 0.0f);
+        for (size_t lane = 0; lane < 8; lane++) {
+            biquadCoefficients[0 * 8 + lane] = biquadCoefficients[5 * 8 + lane] = 0.5f;                 // b0
+            biquadCoefficients[3 * 8 + lane] = biquadCoefficients[8 * 8 + lane] = -0.25f;               // a1
+        }
+        PrintRow("biquad x8", 0, measureAll([&](const TAudioKernels* k) { k->ProcessBiquadLanes(samples.data(), n / 8, 8, biquadCoefficients.data(), biquadStates.data(), 2); }, n * (4 + 4)));
+
+        benchmarkSink = samples[n / 2] + mono[n / 2] + output[n] + stereo.left[n / 2];
+    }
+
+    /// Generic against fixed size kernels, and a convolver set up with each, for every block size of the dispatch table
+    void RunFixedSizeBenchmark() {
+        std::cout << std::endl << "Fixed size kernels (" << KERNELS_BENCHMARK_PARTITIONS << " partitions per convolver), ns per call, generic / fixed" << std::endl;
+        char row[256];
+        std::snprintf(row, sizeof(row), "%6s %21s %21s %21s %23s %10s", "block", "fft+ifft", "multiply-accumulate", "crossfade", "convolver block", "identical");
+        std::cout << row << std::endl;
+
+        bool wasEnabled = AreFixedSizeKernelsEnabled();
+        for (size_t blockSize = FIXED_SIZE_KERNELS_MIN_BLOCK; blockSize <= FIXED_SIZE_KERNELS_MAX_BLOCK; blockSize <<= 1) {
+            std::vector<float> filter(KERNELS_BENCHMARK_PARTITIONS * blockSize);
+            std::vector<float> input(2 * blockSize), spectrum(2 * blockSize + 2), accumulator(2 * blockSize + 2), output(2 * blockSize);
+            for (size_t i = 0; i < filter.size(); i++) { filter[i] = (float)((i * 2654435761u >> 12) & 1023) / 1024.0f - 0.5f; }
+            for (size_t i = 0; i < input.size(); i++) { input[i] = (float)((i * 40503u >> 5) & 1023) / 1024.0f - 0.5f; }
+
+            // Both variants are set up first and then measured in turns, keeping the best time, so load changes affect both alike
+            std::unique_ptr<CRealFFT> ffts[2];
+            CPartitionedFilter filters[2][2];
+            CUniformPartitionedConvolver convolvers[2];
+            std::vector<float> convolverOutputs[2];
+            std::vector<float> left(blockSize), right(blockSize);
+            size_t blocks[2] = { 0, 0 };
+            auto processBlock = [&](int _fixed) {                  // Filter changed every block, crossfaded as a moving source would be
+                convolvers[_fixed].SetFilter(&filters[_fixed][blocks[_fixed] & 1]);
+                convolvers[_fixed].Process(input.data() + (blocks[_fixed] & 1) * blockSize, left.data(), right.data());
+                blocks[_fixed]++;
+            };
+            for (int fixed = 0; fixed < 2; fixed++) {
+                SetFixedSizeKernelsEnabled(fixed == 1);
+                ffts[fixed].reset(new CRealFFT(2 * blockSize));
+                filters[fixed][0].Setup(blockSize, filter.data(), filter.data(), filter.size());
+                filters[fixed][1].Setup(blockSize, filter.data() + blockSize, filter.data(), filter.size() - blockSize);
+                convolvers[fixed].Setup(blockSize, KERNELS_BENCHMARK_PARTITIONS);
+                for (size_t i = 0; i < 2 * KERNELS_BENCHMARK_PARTITIONS; i++) {
+                    processBlock(fixed);
+                    convolverOutputs[fixed].insert(convolverOutputs[fixed].end(), left.begin(), left.end());
+                    convolverOutputs[fixed].insert(convolverOutputs[fixed].end(), right.begin(), right.end());
+                }
+            }
+            double times[2][4];
+            for (int round = 0; round < KERNELS_BENCHMARK_ROUNDS; round++) {
+                for (int fixed = 0; fixed < 2; fixed++) {
+                    CRealFFT& fft = *ffts[fixed];
+                    const TFixedSizeKernels& kernels = fft.GetKernels();
+                    double roundTimes[4] = {
+                        MeasureNanosecondsPerCall([&]() { fft.Forward(input.data(), spectrum.data()); fft.Inverse(spectrum.data(), output.data()); }),
+                        MeasureNanosecondsPerCall([&]() { kernels.ComplexMultiplyAccumulate(spectrum.data(), input.data(), accumulator.data(), blockSize + 1); }),
+                        MeasureNanosecondsPerCall([&]() { kernels.Crossfade(input.data(), output.data(), filter.data(), spectrum.data(), blockSize); }),
+                        MeasureNanosecondsPerCall([&]() { processBlock(fixed); }) };
+                    for (int kernel = 0; kernel < 4; kernel++) { times[fixed][kernel] = round == 0 ? roundTimes[kernel] : std::min(times[fixed][kernel], roundTimes[kernel]); }
+                }
+            }
+            bool identical = convolverOutputs[0].size() == convolverOutputs[1].size() &&
+                std::memcmp(convolverOutputs[0].data(), convolverOutputs[1].data(), convolverOutputs[0].size() * sizeof(float)) == 0;
+
+            int length = std::snprintf(row, sizeof(row), "%6zu", blockSize);
+            for (int kernel = 0; kernel < 4; kernel++) {
+                length += std::snprintf(row + length, sizeof(row) - length, kernel == 3 ? " %9.0f / %7.0f %4.2fx" : " %7.0f / %7.0f %4.2fx",
+                    times[0][kernel], times[1][kernel], times[0][kernel] / times[1][kernel]);
+            }
+            std::snprintf(row + length, sizeof(row) - length, " %10s", identical ? "yes" : "NO");
+            std::cout << row << std::endl;
+        }
+        std::cout << "Prototype only: these kernels serve the tester FFT and convolvers; the library fftsg, convolvers and CMonoBuffer"
+            << " the render path runs are unchanged" << std::endl;
+        SetFixedSizeKernelsEnabled(wasEnabled);
+    }
+}
+
+void RunAudioKernelsBenchmark()
+{
+    std::cout << std::endl << "Audio kernels benchmark (dispatched: " << GetAudioKernels().name << ")" << std::endl;
+    RunBenchmark(KERNELS_BENCHMARK_SMALL_FRAMES);
+    RunBenchmark(KERNELS_BENCHMARK_LARGE_FRAMES);
+    RunFixedSizeBenchmark();
+}
@@ -0,0 +1,39 @@
+/**
+*
+* \brief Micro-benchmark of the audio I/O kernels
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _AUDIOKERNELSBENCHMARK_H_
+#define _AUDIOKERNELSBENCHMARK_H_
+
+#define KERNELS_BENCHMARK_SMALL_FRAMES      4096            // One block, in cache
+#define KERNELS_BENCHMARK_LARGE_FRAMES      (1 << 22)       // Streaming from memory
+#define KERNELS_BENCHMARK_SECONDS           0.1             // Minimum time measured per kernel
+#define KERNELS_BENCHMARK_ROUNDS            3               // Turns of the generic and fixed size measurements, the best is kept
+#define KERNELS_BENCHMARK_PARTITIONS        8               // Filter partitions of the convolver measured per block size
+
+/** \brief Measures the throughput, in GB/s of bytes read plus written, of every kernel of every instruction set the CPU supports,
+*	and of the scalar code the kernels replaced (sample by sample conversion, bounds checked copy, interlace through a stereo buffer),
+*	for a block that fits in cache and for a large buffer. Then measures, for every block size with fixed size kernels, the time
+*	of the generic and the fixed size FFT, multiply-accumulate and crossfade, and of a convolver block with each
+*/
+void RunAudioKernelsBenchmark();
+
+#endif
@@ -25,22 +25,51 @@
 #endif
 
 int iBufferSize;
+int iSampleRate = SAMPLERATE;
 float resamplingStep = HRTFRESAMPLINGSTEP;
-bool doneTransverse = false, doneSagittal = false;
-int main()
+int main(int argc, char* argv[])
 {
-    //Input buffer size and reverb enable
-    std::cout << "Insert wished buffer size (256, 512, 1024, 2048, 4096...)\n(2048 at least recommended for linux)\t: ";
-    std::cin >> iBufferSize; std::cin.ignore();
+    THeadlessSettings headlessSettings;
+    ParseCommandLine(argc, argv, headlessSettings);
+
+    if (headlessSettings.mode != HEADLESS_NONE) {
+        // Headless mode, no audio device is opened and the buffer size comes from the command line
+        iBufferSize = headlessSettings.bufferSize;
+    }
+    else {
+        //Input buffer size and reverb enable
+        std::cout << "Insert wished buffer size (256, 512, 1024, 2048, 4096...)\n(2048 at least recommended for linux)\t: ";
+        std::cin >> iBufferSize; std::cin.ignore();
+    }
     
     // Configure BRT Error handler
     BRT_ERRORHANDLER.SetVerbosityMode(VERBOSITYMODE_ERRORSANDWARNINGS);
-    BRT_ERRORHANDLER.SetErrorLogStream(&std::cout, true);
+    asyncLog.Start(&std::cout);                     // Warnings raised in the audio thread must not wait for the console
+    BRT_ERRORHANDLER.SetErrorLogStream(&asyncLog, true);
 
     // Global Parametert setup    
-    globalParameters.SetSampleRate(SAMPLERATE);     // Setting sample rate
+    iSampleRate = headlessSettings.sampleRate;
+    globalParameters.SetSampleRate(iSampleRate);     // Setting sample rate
     globalParameters.SetBufferSize(iBufferSize);    // Setting buffer size
 
+    if (headlessSettings.mode == HEADLESS_HRTF_BENCHMARK) {
+        return RunHRTFBenchmark(headlessSettings.benchmarkFilePath, headlessSettings.baselineFilePath, headlessSettings.recordBaseline) ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_SAMPLE_RATE_REPORT) {
+        return SampleRateConversionReport() ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_LOG_BENCHMARK) {
+        RunAsyncLogBenchmark(asyncLog, headlessSettings.warningsPerBurst, iBufferSize, iSampleRate);
+        return 0;
+    }
+    if (headlessSettings.mode == HEADLESS_ASSET_LOADING_BENCHMARK) {
+        return AssetLoadingBenchmark(headlessSettings.assetManifestFilePath) ? 0 : 1;
+    }
+
+    // The start-up files are read and processed while the BRT listener and source are created
+    CAssetLoader startupLoader(GetAssetReaders());
+    StartLoadingStartupAssets(startupLoader);
+
     /////////////////////
     // Listener setup
     /////////////////////
@@ -50,11 +79,51 @@ int main()
 
     SourceSetup();
 
-    // Declaration and initialization of stereo buffer
-    outputBufferStereo.left.resize(iBufferSize);
-    outputBufferStereo.right.resize(iBufferSize);
+    // Declaration and initialization of the buffers used by the audio path
+    AudioBuffersSetup();
+
+    if (headlessSettings.mode == HEADLESS_OFFLINE_RENDER) {
+        ResetOrientationSource();
+        if (headlessSettings.enableOnlineInterpolation) {
+            listener->EnableInterpolation();
+            standbyListener->EnableInterpolation();
+        }
+        else {
+            listener->DisableInterpolation();
+            standbyListener->DisableInterpolation();
+        }
+        bool rendered = RenderOffline(headlessSettings.durationSeconds, headlessSettings.outputFilePath);
+        return rendered ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_HRTF_AB_RENDER) {
+        return RenderHRTFBankAB(headlessSettings.durationSeconds, HRTF_AB_FILEPATH) ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_KERNELS_BENCHMARK) {
+        RunAudioKernelsBenchmark();
+        return 0;
+    }
+    if (headlessSettings.mode == HEADLESS_HRTF_STORAGE_REPORT) {
+        return RunHRTFStorageReport(listenerAppliedHRTF, headlessSettings.storageResamplingStep, iBufferSize) ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_MULTI_LISTENER_BENCHMARK) {
+        MultiListenerBenchmark(headlessSettings.numberOfSources, headlessSettings.numberOfListeners);
+        return 0;
+    }
+    if (headlessSettings.mode == HEADLESS_CONVOLVER_BENCHMARK) {
+        return ConvolverBenchmark(headlessSettings.numberOfSources) ? 0 : 1;
+    }
+    if (headlessSettings.mode == HEADLESS_DIRECTIVITY_STRESS) {
+        DirectivityStressTest(headlessSettings.numberOfSources);
+        return 0;
+    }
+    if (headlessSettings.mode == HEADLESS_STRESS_TEST || headlessSettings.mode == HEADLESS_STRESS_SEARCH || headlessSettings.mode == HEADLESS_STRESS_NEAR_FIELD) {
+        StressTest(headlessSettings.mode == HEADLESS_STRESS_SEARCH ? 0 : headlessSettings.numberOfSources, headlessSettings.enableOnlineInterpolation, headlessSettings.numberOfThreads,
+            headlessSettings.mode == HEADLESS_STRESS_NEAR_FIELD);
+        return 0;
+    }
 
     AudioSetup();
+    telemetry.Start(iSampleRate);
 
     int modeOfTest;
     do
@@ -78,6 +147,7 @@ int main()
             // Test Interpolation Offline -- Semi-Transparent HRTF
                 ResetOrientationSource();
                 listener->DisableInterpolation();
+                standbyListener->DisableInterpolation();
                 AudioSetupAndStart();
 
                 int answer;
@@ -87,6 +157,7 @@ int main()
                 
                 // Stopping and closing the stream
                 audio->stopStream();
+                ReportRealTimeAllocations();
                 break;
 
             case 3:
@@ -99,6 +170,57 @@ int main()
 
                 // Stopping and closing the stream
                 audio->stopStream();
+                ReportRealTimeAllocations();
+                break;
+
+            case 4:
+            // Offline render -- Faster than real time, without audio device
+                TestOfflineRender();
+                break;
+
+            case 5:
+            // Stress test -- Many moving sources, block times against the deadline
+                TestStress();
+                break;
+
+            case 6:
+            // Audio kernels benchmark -- Throughput of the SIMD I/O kernels
+                RunAudioKernelsBenchmark();
+                break;
+
+            case 7:
+            // Convolver benchmark -- Latency and load of uniform and non-uniform partitioned convolution
+                TestConvolverBenchmark();
+                break;
+
+            case 8:
+            // HRTF storage -- Memory and error of the compact spectra formats
+                TestHRTFStorageReport();
+                break;
+
+            case 9:
+            // Sample rate conversion -- Time and error of converting every HRTF file to the other engine rates
+                SampleRateConversionReport();
+                break;
+
+            case 10:
+            // Multi-listener -- Cost per additional listener of the prototype renderer, with and without shared source spectra
+                TestMultiListenerBenchmark();
+                break;
+
+            case 11:
+            // Asynchronous log -- Block times of a burst of warnings written directly and through the log thread
+                TestAsyncLogBenchmark();
+                break;
+
+            case 12:
+            // Asset loading -- Time of each asset of a manifest, loaded one by one and on the loader thread pool
+                TestAssetLoadingBenchmark();
+                break;
+
+            case 13:
+            // Directivity stress -- Model cost per directivity source with exact, bucketed and shared SRTF spectra, and the error of the buckets
+                TestDirectivityStressTest();
                 break;
 
             default:
@@ -132,43 +254,74 @@ int main()
 
 void ResetOrientationSource()
 {
-    source1Azimuth = SOURCE1_INITIAL_AZIMUTH;
-    source1Elevation = SOURCE1_INITIAL_ELEVATION;
-    loopCounter = 0;
-    doneTransverse = false;
-    doneSagittal = false;
+    source1TrajectorySamples = 0;
 }
 
 void LoadHRTF()
 {
-    // Load HRTFs from SOFA files  
-    bool hrtfSofaLoaded1 = LoadSofaFile(SOFA4_FILEPATH);
+    // Load HRTFs from SOFA files, the listener one is already being loaded by the start-up asset loader
+    bool hrtfSofaLoaded1 = listenerHRTFAsset.valid() ? listenerHRTFAsset.get().IsLoaded() : LoadSofaFile(SOFA4_FILEPATH);
     //bool hrtfSofaLoaded2 = LoadSofaFile(SOFA2_FILEPATH);
     // Set one for the listener. We can change it at runtime    
     if (hrtfSofaLoaded1) {
-        listener->SetHRTF(HRTF_list[0]);
+        if (listenerHRTFAsset.valid()) {
+            std::lock_guard<std::mutex> lock(resourceListsMutex);
+            HRTF_list.push_back(listenerHRTFAsset.get().hrtf);
+            HRTF_filePaths.push_back(SOFA4_FILEPATH);
+        }
+        listenerAppliedHRTF = HRTF_list.back();
+        listener->SetHRTF(listenerAppliedHRTF);
+        standbyListener->SetHRTF(listenerAppliedHRTF);
     }
 }
 
 void AudioSetupAndStart()
 {
-    // Starting the stream
+    // Starting the stream, with the telemetry of the previous one cleared
+    telemetry.Reset();
     audio->startStream();
 }
 
+void AudioBuffersSetup()
+{
+    // Declaration and initialization of stereo buffer
+    outputBufferStereo.left.resize(iBufferSize);
+    outputBufferStereo.right.resize(iBufferSize);
+    bufferProcessed.left.resize(iBufferSize);
+    bufferProcessed.right.resize(iBufferSize);
+    standbyBufferProcessed.left.resize(iBufferSize);
+    standbyBufferProcessed.right.resize(iBufferSize);
+    source1Input.resize(iBufferSize);
+    CRTAllocationDetector::ResetCounters();
+}
+
+void ReportRealTimeAllocations()
+{
+    if (source1Stream.GetUnderrunFrames() > 0) {
+        std::cout << "Source streaming: " << source1Stream.GetUnderrunFrames() << " frames missed because the prefetch thread was late" << std::endl;
+    }
+    if (!CRTAllocationDetector::IsEnabled()) { return; }
+    std::cout << "RT allocation detector: " << CRTAllocationDetector::GetAllocationCount() << " allocations and "
+        << CRTAllocationDetector::GetDeallocationCount() << " deallocations from the audio path" << std::endl;
+    CRTAllocationDetector::ResetCounters();
+}
+
 void ListenerSetup()
 {
 
     brtManager.BeginSetup();
     listener = brtManager.CreateListener<BRTListenerModel::CListenerHRTFbasedModel>("listener1");
+    standbyListener = brtManager.CreateListener<BRTListenerModel::CListenerHRTFbasedModel>("listener2");
     brtManager.EndSetup();
     Common::CTransform listenerPosition = Common::CTransform();		 // Setting listener in (0,0,0)
     listenerPosition.SetPosition(Common::CVector3(0, 0, 0));
     listener->SetListenerTransform(listenerPosition);
+    standbyListener->SetListenerTransform(listenerPosition);
 
     // We can activate/deactivate different parameters of the listener in the following way
     //listener->DisableSpatialization();
     listener->DisableNearFieldEffect();
+    standbyListener->DisableNearFieldEffect();
 }
 
 int MenuTest()
@@ -180,6 +333,16 @@ int MenuTest()
     std::cout << "1:  Test Grid Interpolation Offline of a SOFA already interpolated." << std::endl;
     std::cout << "2:  Test Interpolation Offline with a Semi-Transparent HRTF." << std::endl;
     std::cout << "3:  Test Interpolation Online with a Semi-Transparent HRTF." << std::endl;
+    std::cout << "4:  Render Offline (faster than real time) to a .wav file." << std::endl;
+    std::cout << "5:  Stress Test with many moving sources." << std::endl;
+    std::cout << "6:  Benchmark the audio I/O kernels." << std::endl;
+    std::cout << "7:  Benchmark the prototype uniform and non-uniform partitioned convolvers (not used to render)." << std::endl;
+    std::cout << "8:  Report memory and error of the compact spectra formats of the tester convolvers." << std::endl;
+    std::cout << "9:  Report time and error of the sample rate conversion of the HRTF files." << std::endl;
+    std::cout << "10: Benchmark a prototype renderer sharing source spectra between several listeners." << std::endl;
+    std::cout << "11: Benchmark a burst of warnings written directly and through the asynchronous log." << std::endl;
+    std::cout << "12: Benchmark loading the assets of a manifest one by one and in parallel." << std::endl;
+    std::cout << "13: Benchmark a model of many directivity sources sharing one synthetic SRTF (not the library directivity source)." << std::endl;
     std::cout << "-1:  Exit Tests." << std::endl;
 
     //cout << "Please choose which audio output you wish to use: ";
@@ -190,7 +353,7 @@ int MenuTest()
         std::cin >> selectModeTest;
         std::cin.clear();
         std::cin.ignore(INT_MAX, '\n');
-    } while (!(selectModeTest == -1 || selectModeTest == 0 || selectModeTest == 1 || selectModeTest == 2 || selectModeTest == 3));
+    } while (!(selectModeTest == -1 || selectModeTest == 0 || selectModeTest == 1 || selectModeTest == 2 || selectModeTest == 3 || selectModeTest == 4 || selectModeTest == 5 || selectModeTest == 6 || selectModeTest == 7 || selectModeTest == 8 || selectModeTest == 9 || selectModeTest == 10 || selectModeTest == 11 || selectModeTest == 12 || selectModeTest == 13));
     return selectModeTest;
 }
 void SourceSetup()
@@ -199,12 +362,13 @@ void SourceSetup()
     source1BRT = brtManager.CreateSoundSource<BRTSourceModel::CSourceSimpleModel>("speech");      // Instatiate a BRT Sound Source
     listener->ConnectSoundSource(source1BRT);                                                     // Connecto Source to the listener
     brtManager.EndSetup();
-    LoadWav(samplesVectorSource1, SOURCE1_FILEPATH);											 // Loading .wav file        
-    source1Azimuth = SOURCE1_INITIAL_AZIMUTH;
-    source1Elevation = SOURCE1_INITIAL_ELEVATION;
-    source1Distance = SOURCE1_INITIAL_DISTANCE;
+    source1Stream.Open(SOURCE1_FILEPATH, globalParameters.GetSampleRate());                      // Streaming the .wav file, silent if it can not be played
+    if (source1Asset.valid() && source1Asset.get().IsLoaded()) { stressSourceSamples = *source1Asset.get().samples; }
+    else { LoadWavExcerpt(stressSourceSamples, SOURCE1_FILEPATH, STRESS_TEST_SOURCE_SECONDS, globalParameters.GetSampleRate()); }
+    LoadSourceTrajectory(source1TrajectoryFilePath);
+    source1Trajectory.Evaluate(0, 0, listener->GetListenerTransform().GetPosition());
     Common::CTransform sourceSpeechPosition = Common::CTransform();
-    sourceSpeechPosition.SetPosition(Spherical2Cartesians(source1Azimuth, source1Elevation, SOURCE1_INITIAL_DISTANCE));
+    sourceSpeechPosition.SetPosition(source1Trajectory.GetStartPosition(0));
     source1BRT->SetSourceTransform(sourceSpeechPosition);
 }
 
@@ -240,7 +404,7 @@ void AudioSetup()
     options.flags |= RTAUDIO_HOG_DEVICE;
     }
     }while(flag!='0');*/
-    options.numberOfBuffers = 4;                // Setting number of buffers used by RtAudio
+    options.numberOfBuffers = RTAUDIO_NUMBER_OF_BUFFERS;  // Setting number of buffers used by RtAudio
     options.priority = 1;                       // Setting stream thread priority
     unsigned int frameSize = iBufferSize;       // Declaring and initializing frame size variable because next statement needs it
 
@@ -249,7 +413,7 @@ void AudioSetup()
         audio->openStream(&outputParameters,     // Specified output parameters
             nullptr,			                  // Unspecified input parameters because there will not be input stream
             RTAUDIO_FLOAT32,	              // Output buffer will be 32-bit float
-            SAMPLERATE,			                    // Sample rate will be 44.1 kHz
+            iSampleRate,			                    // Sample rate will be 44.1 kHz
             &frameSize,		                // Frame size will be iBufferSize samples
             &rtAudioCallback,	            // Pointer to the function that will be called every time RtAudio needs the buffer to be filled
             nullptr,			                  // Unused pointer to get feedback
@@ -297,233 +461,476 @@ static int rtAudioCallback(void *outputBuffer, void *inputBuffer, unsigned int u
     // Setting the output buffer as float
     float * floatOutputBuffer = (float *)outputBuffer;
 
-    // Checking if there is underflow or overflow
-    if (status) std::cout << "stream over/underflow detected";
+    // Over/underflows are counted by the telemetry, never printed from here
+    CStopwatch callbackStopwatch;
+    telemetry.BeginBlock(uiBufferSize);
+    telemetry.RecordXruns((status & RTAUDIO_INPUT_OVERFLOW) != 0, (status & RTAUDIO_OUTPUT_UNDERFLOW) != 0);
+
+    ProcessBlock(floatOutputBuffer, uiBufferSize);
+
+    telemetry.RecordStage(TELEMETRY_CALLBACK, callbackStopwatch.GetElapsedMilliseconds());
+    telemetry.EndBlock();
+
+    return 0;
+}
+
+void ProcessBlock(float* interlacedOutput, unsigned int uiBufferSize)
+{
+    // Everything done from here on runs on the audio thread, and must not allocate
+    CRTAllocationDetector::CRealTimeScope realTimeScope;
+
+    const TAudioKernels& kernels = GetAudioKernels();
 
   	// Initializes buffer with zeros
-	  outputBufferStereo.left.Fill(uiBufferSize, 0.0f);
-	  outputBufferStereo.right.Fill(uiBufferSize, 0.0f);
+    kernels.Fill(outputBufferStereo.left.data(), 0.0f, uiBufferSize);
+    kernels.Fill(outputBufferStereo.right.data(), 0.0f, uiBufferSize);
+
 
+    // Moving the source
+    MoveSource(uiBufferSize);
 
     // Getting the processed audio
+    CStopwatch stageStopwatch;
     audioProcess(outputBufferStereo, uiBufferSize);
+    telemetry.RecordStage(TELEMETRY_AUDIO_PROCESS, stageStopwatch.GetElapsedMilliseconds());
 
-    // Declaration and initialization of interlaced audio vector for correct stereo output
-    CStereoBuffer<float> iOutput;
-    iOutput.Interlace(outputBufferStereo.left, outputBufferStereo.right);
-
-    // Buffer filling loop
-    for (auto it = iOutput.begin(); it != iOutput.end(); it++)
-    {
-        floatOutputBuffer[0] = *it;						 // Setting of value in actual buffer position
-        floatOutputBuffer = &floatOutputBuffer[1];				 // Updating pointer to next buffer position
-    }
-        
-    // Moving the source
-    MoveSource();
-    //MoveSource_CircularPathTransversePlane();
-    //MoveSource_CircularPathSagittalPlane();  // TODO Check if it is working well
-  
-    return 0;
+    // Interlacing straight into the output buffer for correct stereo output
+    stageStopwatch.Restart();
+    kernels.Interleave(outputBufferStereo.left.data(), outputBufferStereo.right.data(), interlacedOutput, uiBufferSize);
+    telemetry.RecordStage(TELEMETRY_INTERLEAVE, stageStopwatch.GetElapsedMilliseconds());
 }
 
 void audioProcess(Common::CEarPair<CMonoBuffer<float>> & bufferOutput, int uiBufferSize)
 {
-    // Declaration, initialization and filling mono buffers
-    CMonoBuffer<float> source1Input(uiBufferSize);	FillBuffer(source1Input, wavSamplePositionSource1, positionEndFrameSpeech, samplesVectorSource1);    
-    
-    // Declaration of stereo buffer
-    Common::CEarPair<CMonoBuffer<float>> bufferProcessed;
+    // Changes from the menu and resources loaded in background are applied at the block boundary
+    ExecuteAudioCommands();
+
+    // Filling mono buffers, preallocated in AudioBuffersSetup
+    source1Stream.FillBuffer(source1Input);
     
     source1BRT->SetBuffer(source1Input);           // Set samples in the sound source
     //sourceSteps->SetBuffer(stepsInput);             // Set samples in the sound source        
+    CStopwatch processAllStopwatch;
     brtManager.ProcessAll();                        // Process all	      
+    telemetry.RecordStage(TELEMETRY_PROCESS_ALL, processAllStopwatch.GetElapsedMilliseconds());
     listener->GetBuffers(bufferProcessed.left, bufferProcessed.right);          // Get out buffers
+    if (hrtfSwitch.active) { AdvanceHRTFSwitch(uiBufferSize); }
     
 
-    bufferOutput.left += bufferProcessed.left;
-    bufferOutput.right += bufferProcessed.right;
+    GetAudioKernels().Accumulate(bufferOutput.left.data(), bufferProcessed.left.data(), uiBufferSize);
+    GetAudioKernels().Accumulate(bufferOutput.right.data(), bufferProcessed.right.data(), uiBufferSize);
     
 }
 
-void FillBuffer(CMonoBuffer<float> &output, unsigned int& position, unsigned int& endFrame, std::vector<float>& samplesVector)
+bool SaveWav(const std::vector<float>& interlacedSamples, int numberOfChannels, const char* stringOut)
 {
-    position = endFrame + 1;							 // Set starting point as next sample of the end of last frame
-    if (position >= samplesVector.size())				 // If the end of the audio is met, the position variable must return to the beginning
-        position = 0;
+    FILE* wavFile = fopen(stringOut, "wb");										 // Opening of the wav file
+    if (wavFile == nullptr) {
+        std::cout << "Error creating the wav file " << stringOut << std::endl;
+        return false;
+    }
 
-    endFrame = position + output.size() - 1;			 // Set ending point as starting point plus frame size
-    for (int i = 0; i < output.size(); i++) {
-        if ((position + i) < samplesVector.size())
-            output[i] = (samplesVector[position + i]);	 // Fill with audio
-        else
-            output[i] = 0.0f;							 // Fill with zeros if the end of the audio is met
+    // Little-endian writers, needed for endian-independent wav writing (more info in http://soundfile.sapp.org/doc/WaveFormat/)
+    bool written = true;
+    auto writeBytes = [wavFile, &written](const void* bytes, size_t count) { written = fwrite(bytes, 1, count, wavFile) == count && written; };
+    auto writeUint16 = [&writeBytes](uint16_t value) { uint8_t bytes[2] = { uint8_t(value), uint8_t(value >> 8) }; writeBytes(bytes, 2); };
+    auto writeUint32 = [&writeBytes](uint32_t value) { uint8_t bytes[4] = { uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24) }; writeBytes(bytes, 4); };
+
+    uint32_t samplesCount = (uint32_t)interlacedSamples.size();
+    uint32_t framesCount = samplesCount / numberOfChannels;
+    uint32_t bytesCount = samplesCount * sizeof(float);
+
+    writeBytes("RIFF", 4);
+    writeUint32(4 + (8 + 18) + (8 + 4) + (8 + bytesCount));						 // WAVE id + fmt chunk + fact chunk + data chunk
+    writeBytes("WAVE", 4);
+
+    writeBytes("fmt ", 4);													 // 32-bit IEEE float format, so the output is not requantized
+    writeUint32(18);
+    writeUint16(3);																	 // WAVE_FORMAT_IEEE_FLOAT
+    writeUint16(numberOfChannels);
+    writeUint32(iSampleRate);
+    writeUint32(iSampleRate * numberOfChannels * sizeof(float));						 // Bytes per second
+    writeUint16(numberOfChannels * sizeof(float));									 // Block align
+    writeUint16(8 * sizeof(float));													 // Bits per sample
+    writeUint16(0);																	 // No extension
+
+    writeBytes("fact", 4);
+    writeUint32(4);
+    writeUint32(framesCount);
+
+    writeBytes("data", 4);
+    writeUint32(bytesCount);
+    for (float sample : interlacedSamples) {
+        uint32_t bits;
+        memcpy(&bits, &sample, sizeof(bits));
+        writeUint32(bits);
     }
+    written = fclose(wavFile) == 0 && written;
+    if (!written) { std::cout << "Error writing the wav file " << stringOut << std::endl; }
+    return written;
 }
 
-void LoadWav(std::vector<float>& samplesVector, const char* stringIn)
-{
-    struct WavHeader								 // Local declaration of wav header struct type (more info in http://soundfile.sapp.org/doc/WaveFormat/)
-    {												 // We only need the number of samples, so the rest will be unused assuming file is mono, 16-bit depth and 44.1kHz sampling rate
-        char		  fill[40];
-        uint32_t	bytesCount;
-    } wavHeader;
-
-    FILE* wavFile = fopen(stringIn, "rb");											 // Opening of the wav file
-    fread(&wavHeader, sizeof(wavHeader), 1, wavFile);								 // Reading of the 44 bytes of header to get the number of samples of the file
-    fseek(wavFile, sizeof(wavHeader), SEEK_SET);									 // Moving of the file pointer to the start of the audio samples
-
-    unsigned int samplesCount = wavHeader.bytesCount / 2;							 // Getting number of samples by dividing number of bytes by 2 because we are reading 16-bit samples
-    int16_t *sample; sample = new int16_t[samplesCount];							 // Declaration and initialization of 16-bit signed integer pointer
-    memset(sample, 0, sizeof(int16_t) * samplesCount);								 // Setting its size
-
-    uint8_t *byteSample; byteSample = new uint8_t[2 * samplesCount];				 // Declaration and initialization of 8-bit unsigned integer pointer
-    memset(byteSample, 0, sizeof(uint8_t) * 2 * samplesCount);						 // Setting its size
-
-    fread(byteSample, 1, 2 * samplesCount, wavFile);								 // Reading the whole file byte per byte, needed for endian-independent wav parsing
-
-    for (int i = 0; i < samplesCount; i++)
-        sample[i] = int16_t(byteSample[2 * i] | byteSample[2 * i + 1] << 8);		 // Conversion from two 8-bit unsigned integer to a 16-bit signed integer
+bool LoadSofaFile(std::string _filePath) {
+    std::shared_ptr<BRTServices::CHRTF> hrtf = ReadHRTF(sofaReader, _filePath, resamplingStep);
+    if (hrtf == nullptr) { return false; }
+    
+    std::lock_guard<std::mutex> lock(resourceListsMutex);
+    HRTF_list.push_back(hrtf);
+    HRTF_filePaths.push_back(_filePath);
+    return true;
+}
 
-    samplesVector.reserve(samplesCount);											 // Reserving memory for samples vector
+bool LoadILD( std::string _ildFilePath) {
+    std::shared_ptr<BRTServices::CILD> ild = ReadILD(sofaReader, _ildFilePath);
+    if (ild == nullptr) { return false; }
 
-    for (int i = 0; i < samplesCount; i++)
-        samplesVector.push_back((float)sample[i] / (float)INT16_MAX);				 // Converting samples to float to push them in samples vector
+    std::lock_guard<std::mutex> lock(resourceListsMutex);
+    ILD_list.push_back(ild);
+    return true;
 }
 
-bool LoadSofaFile(std::string _filePath) {
+std::shared_ptr<BRTServices::CHRTF> ReadHRTF(BRTReaders::CSOFAReader& _sofaReader, std::string _filePath, float _resamplingStep, TRawHRTFCachePartitions* _partitions) {
+    // A previous load with the same file contents and configuration may have left the raw table in the cache. It saves the
+    // SOFA read only, the library still resamples the grid in EndSetup
+    std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+    std::shared_ptr<BRTServices::CHRTF> cachedHRTF = rawHRTFCache.Load(_filePath, globalParameters.GetSampleRate(), globalParameters.GetBufferSize(), _resamplingStep, EXTRAPOLATION_METHOD, _partitions);
+    if (cachedHRTF != nullptr) {
+        std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now();
+        if (!cachedHRTF->EndSetup()) {
+            if (_partitions != nullptr) { _partitions->filters.clear(); }
+            std::cout << ("Error processing the HRTF restored from the raw table cache") << std::endl;
+            return nullptr;
+        }
+        std::chrono::duration<double, std::milli> restoreTime = setupStart - loadStart;
+        std::chrono::duration<double, std::milli> setupTime = std::chrono::steady_clock::now() - setupStart;
+        std::cout << "HRTF raw table restored from cache in " << restoreTime.count() << " ms, processed by EndSetup in " << setupTime.count() << " ms." << std::endl;
+        return cachedHRTF;
+    }
+
     std::shared_ptr<BRTServices::CHRTF> hrtf = std::make_shared<BRTServices::CHRTF>();
 
-    int sampleRateInSOFAFile = sofaReader.GetSampleRateFromSofa(_filePath);
+    std::unique_lock<std::mutex> lock(sofaFileMutex);               // netCDF is not thread-safe, SOFA reads take turns
+    int sampleRateInSOFAFile = _sofaReader.GetSampleRateFromSofa(_filePath);
     if (sampleRateInSOFAFile == -1) {
         std::cout << ("Error loading HRTF Sofa file") << std::endl;
-        return false;
+        return nullptr;
     }
-    if (globalParameters.GetSampleRate() != sampleRateInSOFAFile)
-    {
-        std::cout<<"The sample rate in HRTF SOFA file." << std::endl;
-        return false;
+    bool result;
+    if (globalParameters.GetSampleRate() == sampleRateInSOFAFile) {
+        result = _sofaReader.ReadHRTFFromSofa(_filePath, hrtf, _resamplingStep, EXTRAPOLATION_METHOD);
+        lock.unlock();
+    }
+    else {
+        // HRIRs at another rate are converted before the library processes them, the cache keeps the result for the engine rate
+        result = _sofaReader.ReadHRTFFromSofaWithoutProcess(_filePath, hrtf, _resamplingStep, EXTRAPOLATION_METHOD);
+        lock.unlock();
+        if (result) {
+            std::chrono::steady_clock::time_point conversionStart = std::chrono::steady_clock::now();
+            hrtf = ConvertHRTFSampleRate(hrtf, sampleRateInSOFAFile, globalParameters.GetSampleRate(), EXTRAPOLATION_METHOD);
+            std::chrono::duration<double, std::milli> conversionTime = std::chrono::steady_clock::now() - conversionStart;
+            std::cout << "HRTF converted from " << sampleRateInSOFAFile << " to " << globalParameters.GetSampleRate() << " Hz in " << conversionTime.count() << " ms." << std::endl;
+            if (hrtf != nullptr) { hrtf->SetResamplingStep(_resamplingStep); }
+            result = hrtf != nullptr && hrtf->EndSetup();
+        }
     }
-    bool result = sofaReader.ReadHRTFFromSofa(_filePath, hrtf, resamplingStep, EXTRAPOLATION_METHOD);
     if (result) {
-        std::cout << ("HRTF Sofa file loaded successfully.") << std::endl;
-        HRTF_list.push_back(hrtf);
-        return true;
+        std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStart;
+        std::cout << "HRTF Sofa file loaded successfully in " << loadTime.count() << " ms." << std::endl;
+        rawHRTFCache.Store(_filePath, globalParameters.GetSampleRate(), globalParameters.GetBufferSize(), _resamplingStep, EXTRAPOLATION_METHOD, hrtf, _partitions);
+        return hrtf;
     }
     else {
         std::cout << ("Error loading HRTF") << std::endl;
-        return false;
+        return nullptr;
     }
 }
 
-bool LoadILD( std::string _ildFilePath) {
+std::shared_ptr<BRTServices::CILD> ReadILD(BRTReaders::CSOFAReader& _sofaReader, std::string _ildFilePath) {
     std::shared_ptr<BRTServices::CILD> ild = std::make_shared<BRTServices::CILD>();
     
-    
-    int sampleRateInSOFAFile = sofaReader.GetSampleRateFromSofa(_ildFilePath);
+    std::unique_lock<std::mutex> lock(sofaFileMutex);
+    int sampleRateInSOFAFile = _sofaReader.GetSampleRateFromSofa(_ildFilePath);
     if (sampleRateInSOFAFile == -1) {
         std::cout << ("Error loading ILD Sofa file") << std::endl;
-        return false;
+        return nullptr;
     }
     if (globalParameters.GetSampleRate() != sampleRateInSOFAFile)
     {
-        std::cout << "The sample rate in ILD SOFA file" << std::endl;
-        return false;
+        // The ILD holds biquads designed for the rate of its file, which can not be resampled: the bundled file nearest to the
+        // engine rate is tried instead, and the load fails if that one does not match either
+        std::string nearestFilePath = GetNearFieldILDFilePath(globalParameters.GetSampleRate());
+        if (nearestFilePath != _ildFilePath) {
+            std::cout << "The sample rate in ILD SOFA file is " << sampleRateInSOFAFile << " Hz, loading " << nearestFilePath << " instead" << std::endl;
+            lock.unlock();
+            return ReadILD(_sofaReader, nearestFilePath);
+        }
+        std::cout << "Error loading ILD Sofa file: its filters are designed for " << sampleRateInSOFAFile << " Hz and there is no near field ILD file for "
+            << globalParameters.GetSampleRate() << " Hz" << std::endl;
+        return nullptr;
     }
     
-    bool result = sofaReader.ReadILDFromSofa(_ildFilePath, ild);
+    bool result = _sofaReader.ReadILDFromSofa(_ildFilePath, ild);
+    lock.unlock();
     if (result) {
         std::cout << "ILD Sofa file loaded successfully: " << std::endl;
-        ILD_list.push_back(ild);
-        return true;
+        return ild;
     }
     else {
         std::cout << "Error loading HRTF" << std::endl;
-        return false;
+        return nullptr;
     }            
 }
 
+std::string GetNearFieldILDFilePath(int _sampleRate) {
+    if (_sampleRate <= 46050) { return ILD_NearFieldEffect_44100; }          // Nearest bundled rate
+    if (_sampleRate >= 72000) { return ILD_NearFieldEffect_96000; }
+    return ILD_NearFieldEffect_48000;
+}
+
 ///////////////////////
-// SOURCE MOVEMENT
+// BACKGROUND LOADING
 ///////////////////////
 
-void MoveSource()
+void LoadHRTFInBackground(float _resamplingStep)
 {
-    if (loopCounter < 2)
+    std::cout << "Loading HRTF in background, audio keeps playing with the current one..." << std::endl;
+    CollectRetiredResources();
+
+    resourceLoader.Enqueue([_resamplingStep]() {
+        BRTReaders::CSOFAReader loaderSofaReader;                          // The global reader belongs to the menu thread
+        std::shared_ptr<BRTServices::CHRTF> hrtf = ReadHRTF(loaderSofaReader, SOFA4_FILEPATH, _resamplingStep);
+        if (hrtf == nullptr) { return; }
+        {
+            std::lock_guard<std::mutex> lock(resourceListsMutex);
+            if (HRTF_list.empty()) {
+                HRTF_list.push_back(hrtf);
+                HRTF_filePaths.push_back(SOFA4_FILEPATH);
+            }
+            else { HRTF_list[0] = hrtf; }                                 // The reloaded HRTF replaces the listener one
+        }
+        loaderCommands.PushHRTF(hrtf);
+        std::cout << "New HRTF ready, it is applied from the next audio block" << std::endl;
+    });
+}
+
+void LoadILDInBackground(std::string _ildFilePath)
+{
+    std::cout << "Loading ILD in background..." << std::endl;
+    CollectRetiredResources();
+
+    resourceLoader.Enqueue([_ildFilePath]() {
+        BRTReaders::CSOFAReader loaderSofaReader;
+        std::shared_ptr<BRTServices::CILD> ild = ReadILD(loaderSofaReader, _ildFilePath);
+        if (ild == nullptr) { return; }
+        {
+            std::lock_guard<std::mutex> lock(resourceListsMutex);
+            ILD_list.push_back(ild);
+        }
+        loaderCommands.PushILD(ild);
+    });
+}
+
+bool EnsureHRTFBank()
+{
+    if (hrtfBank.GetNumberOfHRTFs() > 0) { return true; }
+    std::shared_ptr<BRTServices::CHRTF> listenerHRTF;
     {
-        if (!doneTransverse) { doneTransverse = true; std::cout << std::endl << "Currently doing Transverse Plane Trajectory\n"; doneSagittal = false; }
-        MoveSource_CircularPathTransversePlane(loopCounter);
+        std::lock_guard<std::mutex> lock(resourceListsMutex);
+        if (!HRTF_list.empty()) { listenerHRTF = HRTF_list.front(); }                   // The listener one, also after a reload
     }
-    else
-    {
-        if (!doneSagittal) { doneSagittal = true; std::cout << std::endl << "Currently doing Sagittal Plane Trajectory\n"; doneTransverse = false; }
-        MoveSource_CircularPathSagittalPlane(loopCounter);
-        if (loopCounter == 3) { loopCounter = 0; source1Elevation = SOURCE1_INITIAL_ELEVATION; }
+    if (listenerHRTF == nullptr) {
+        std::cout << "There is no listener HRTF to start the HRTF bank with" << std::endl;
+        return false;
     }
+    CStopwatch stopwatch;
+    hrtfBank.Setup(iBufferSize);
+    hrtfBank.AddHRTF(listenerHRTF, SOFA4_FILEPATH);
+    std::cout << "HRTF bank set up with the listener HRTF in " << stopwatch.GetElapsedMilliseconds() << " ms" << std::endl;
+    return true;
 }
 
-void MoveSource_CircularPathTransversePlane(unsigned int& loopCounter) {
-    
-    Common::CVector3 newPosition;
-    source1Azimuth += SOURCE1_INITIAL_SPEED;
-    if (source1Azimuth > 360) { source1Azimuth = 0; loopCounter++; }
-    newPosition = Spherical2Cartesians(source1Azimuth, source1Elevation, source1Distance);
-    
-    Common::CTransform sourcePosition = source1BRT->GetCurrentSourceTransform();
-    sourcePosition.SetPosition(newPosition);
-    source1BRT->SetSourceTransform(sourcePosition);
-    //std::cout << "azimuth " << source1Azimuth << " elevation " << source1Elevation << std::endl;
+int PreloadHRTFBank(BRTReaders::CSOFAReader& _sofaReader)
+{
+    int added = 0;
+    for (const char* filePath : { SOFA3_FILEPATH, SOFA1_FILEPATH, SOFA2_FILEPATH }) {
+        TRawHRTFCachePartitions partitions;
+        partitions.storage = hrtfBank.GetStorage();
+        std::shared_ptr<BRTServices::CHRTF> hrtf = ReadHRTF(_sofaReader, filePath, resamplingStep, &partitions);
+        if (hrtf == nullptr) { continue; }
+        CStopwatch stopwatch;
+        // The HRIRs partitioned for the cache are taken as they are, they are only partitioned here when the cache is disabled
+        int index = partitions.filters.empty() ? hrtfBank.AddHRTF(hrtf, filePath) : hrtfBank.AddHRTF(hrtf, filePath, partitions.orientations, std::move(partitions.filters));
+        if (index < 0) {
+            std::cout << "The HRTF bank is full" << std::endl;
+            break;
+        }
+        std::cout << "HRTF " << index << " of the bank (" << filePath << ") added in " << stopwatch.GetElapsedMilliseconds() << " ms" << std::endl;
+        added++;
+    }
+    return added;
 }
 
-void MoveSource_CircularPathSagittalPlane(unsigned int& loopCounter) {
-
-    Common::CVector3 newPosition;
-    
-    if (source1Azimuth == 0) {
-        source1Elevation += SOURCE1_INITIAL_SPEED;    
-        if (source1Elevation > 90) {
-            source1Azimuth = 180;
-            source1Elevation = 90;
+void PreloadHRTFsInBackground()
+{
+    std::cout << "Preloading the other HRTFs of resources in background, audio keeps playing..." << std::endl;
+    resourceLoader.Enqueue([]() {
+        BRTReaders::CSOFAReader loaderSofaReader;
+        for (const char* filePath : { SOFA3_FILEPATH, SOFA1_FILEPATH, SOFA2_FILEPATH }) {
+            {
+                std::lock_guard<std::mutex> lock(resourceListsMutex);
+                if (std::find(HRTF_filePaths.begin(), HRTF_filePaths.end(), filePath) != HRTF_filePaths.end()) { continue; }
+            }
+            std::shared_ptr<BRTServices::CHRTF> hrtf = ReadHRTF(loaderSofaReader, filePath, resamplingStep);
+            if (hrtf == nullptr) { continue; }
+            std::lock_guard<std::mutex> lock(resourceListsMutex);
+            HRTF_list.push_back(hrtf);
+            HRTF_filePaths.push_back(filePath);
         }
-        if (std::trunc(source1Elevation * 10) / 10 == 0) 
-        { loopCounter++; }
+        std::lock_guard<std::mutex> lock(resourceListsMutex);
+        std::cout << HRTF_list.size() << " HRTFs resident" << std::endl;
+    });
+}
+
+void SelectResidentHRTF()
+{
+    std::vector<std::string> filePaths;
+    {
+        std::lock_guard<std::mutex> lock(resourceListsMutex);
+        filePaths = HRTF_filePaths;
     }
-    else if (source1Azimuth == 180) {
-        source1Elevation -= SOURCE1_INITIAL_SPEED;
-        if (source1Elevation < -90) {
-            source1Azimuth = 0;
-            source1Elevation = -90;
-        }
+    for (size_t i = 0; i < filePaths.size(); i++) { std::cout << i << ": " << filePaths[i] << std::endl; }
+    if (filePaths.empty()) { return; }
+    int index;
+    do {
+        std::cout << "Choose the HRTF to switch to: ";
+        std::cin >> index;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(index >= 0 && index < (int)filePaths.size()));
+
+    std::shared_ptr<BRTServices::CHRTF> hrtf;
+    {
+        std::lock_guard<std::mutex> lock(resourceListsMutex);
+        hrtf = HRTF_list[index];
     }
-        
-    newPosition = Spherical2Cartesians(source1Azimuth, source1Elevation, source1Distance);
+    CollectRetiredResources();
+    controlCommands.PushSelectHRTF(hrtf);
+}
 
-    Common::CTransform sourcePosition = source1BRT->GetCurrentSourceTransform();
-    sourcePosition.SetPosition(newPosition);
-    source1BRT->SetSourceTransform(sourcePosition);
+bool IsListenerCommand(const TAudioCommand& _command)
+{
+    return _command.type != AUDIO_COMMAND_SET_SOURCE_TRANSFORM && _command.type != AUDIO_COMMAND_RESET_SOURCE_TRAJECTORY;
+}
 
-    //std::cout << "azimuth " << source1Azimuth << " elevation " << source1Elevation << std::endl;
+void ExecuteAudioCommands()
+{
+    // The listeners are left as they are until the crossfade ends, a few blocks; sources keep moving meanwhile
+    controlCommands.Drain(ExecuteAudioCommand, IsListenerCommand, hrtfSwitch.active);
+    loaderCommands.Drain(ExecuteAudioCommand, IsListenerCommand, hrtfSwitch.active);
 }
 
-Common::CVector3 Spherical2Cartesians(float azimuth, float elevation, float radius) {
-    
-    
+void ExecuteAudioCommand(TAudioCommand& _command)
+{
+    switch (_command.type) {
+    case AUDIO_COMMAND_SET_SOURCE_TRANSFORM:
+        _command.source->SetSourceTransform(_command.transform);
+        break;
+    case AUDIO_COMMAND_RESET_SOURCE_TRAJECTORY:
+        ResetOrientationSource();
+        break;
+    // Settings go to both listeners, so an HRTF switch does not change them
+    case AUDIO_COMMAND_ENABLE_INTERPOLATION:
+        listener->EnableInterpolation();
+        standbyListener->EnableInterpolation();
+        break;
+    case AUDIO_COMMAND_DISABLE_INTERPOLATION:
+        listener->DisableInterpolation();
+        standbyListener->DisableInterpolation();
+        break;
+    case AUDIO_COMMAND_ENABLE_NEAR_FIELD_EFFECT:
+        listener->EnableNearFieldEffect();
+        standbyListener->EnableNearFieldEffect();
+        break;
+    case AUDIO_COMMAND_DISABLE_NEAR_FIELD_EFFECT:
+        listener->DisableNearFieldEffect();
+        standbyListener->DisableNearFieldEffect();
+        break;
+    case AUDIO_COMMAND_SET_HRTF:
+        // The applied HRTF keeps a reference, so SetHRTF frees nothing; the old one goes back in the holder
+        listener->SetHRTF(*_command.hrtf);
+        std::swap(listenerAppliedHRTF, *_command.hrtf);
+        // As when the stream was stopped to reload, trajectories start again with the new HRTF
+        ResetOrientationSource();
+        break;
+    case AUDIO_COMMAND_SET_ILD:
+        listener->SetILD(*_command.ild);
+        standbyListener->SetILD(*_command.ild);
+        std::swap(listenerAppliedILD, *_command.ild);
+        break;
+    case AUDIO_COMMAND_SELECT_HRTF:
+        // The new HRTF is already resident in HRTF_list, so this only copies a reference; the replaced HRTF goes back in the
+        // holder, and the current listener keeps its own reference until the crossfade ends. The standby listener takes the new
+        // HRTF and is connected to the source for the length of the switch only. Connecting may allocate inside the library,
+        // once per switch, and the RT allocation detector counts it
+        standbyListener->SetHRTF(*_command.hrtf);
+        standbyListener->ConnectSoundSource(source1BRT);
+        std::swap(listenerAppliedHRTF, *_command.hrtf);
+        hrtfSwitch.active = true;
+        hrtfSwitch.warmupBlocks = listenerAppliedHRTF->GetHRIRLength() / iBufferSize + 1;         // The HRIR, and the delays in the last block
+        break;
+    }
+}
 
-    float x = radius * std::cos(d2r(azimuth)) * std::cos (d2r(elevation));
-    float y = radius * std::sin(d2r(azimuth)) * std::cos (d2r(elevation));
-    float z = radius * std::sin(d2r(elevation));
+void AdvanceHRTFSwitch(int _bufferSize)
+{
+    if (hrtfSwitch.warmupBlocks > 0) {
+        hrtfSwitch.warmupBlocks--;
+        return;
+    }
+    standbyListener->GetBuffers(standbyBufferProcessed.left, standbyBufferProcessed.right);
+    for (int i = 0; i < _bufferSize; i++) {
+        float fadeIn = (float)(i + 1) / _bufferSize;
+        bufferProcessed.left[i] += fadeIn * (standbyBufferProcessed.left[i] - bufferProcessed.left[i]);
+        bufferProcessed.right[i] += fadeIn * (standbyBufferProcessed.right[i] - bufferProcessed.right[i]);
+    }
+    listener->DisconnectSoundSource(source1BRT);
+    std::swap(listener, standbyListener);
+    hrtfSwitch.active = false;
+}
 
-    Common::CVector3 pos = listener->GetListenerTransform().GetPosition();
+void CollectRetiredResources()
+{
+    controlCommands.CollectRetired();
+    resourceLoader.Enqueue([]() { loaderCommands.CollectRetired(); });     // The loader queue is collected by one thread, the loader
+}
 
-    pos.x = pos.x + x;
-    pos.y = pos.y + y;
-    pos.z = pos.z + z;
+///////////////////////
+// SOURCE MOVEMENT
+///////////////////////
 
-    return pos;
+void LoadSourceTrajectory(const std::string& _filePath)
+{
+    source1Trajectory.Clear();
+    if (source1Trajectory.LoadFromFile(_filePath)) { return; }
+
+    std::cout << "The source will stay at its initial position" << std::endl;
+    source1Trajectory.Clear();                                             // Paths read before the error are discarded
+    TTrajectoryPath staticPath;
+    staticPath.keyframes.push_back({ 0, SOURCE1_INITIAL_AZIMUTH, SOURCE1_INITIAL_ELEVATION, SOURCE1_INITIAL_DISTANCE });
+    source1Trajectory.AddPath(staticPath);
 }
 
-double d2r(double d) {
-    return (d / 180.0) * ((double)M_PI);
+void MoveSource(unsigned int uiBufferSize)
+{
+    // The source model takes one transform per block, so it gets the position in the middle of the block
+    double startTime = (double)source1TrajectorySamples / iSampleRate;
+    source1TrajectorySamples += uiBufferSize;
+    double endTime = (double)source1TrajectorySamples / iSampleRate;
+    source1Trajectory.Evaluate(startTime, endTime, listener->GetListenerTransform().GetPosition());
+
+    Common::CTransform sourcePosition = source1BRT->GetCurrentSourceTransform();
+    sourcePosition.SetPosition(source1Trajectory.GetCentrePosition(0));
+    source1BRT->SetSourceTransform(sourcePosition);
 }
 
 ///////////////////////
@@ -569,20 +976,21 @@ int TestOfflineInterpolation()
     do {
         std::cout << std::endl;
         std::cout << "Do you want to change the Resampling Step? Press 0." << std::endl;
+        std::cout << "Press 1 to show the callback telemetry, 2 to dump it as JSON." << std::endl;
         std::cout << "Press -1 to exit the test." << std::endl;
         std::cin >> answer;
         std::cin.clear();
         std::cin.ignore(INT_MAX, '\n');
-    } while (!(answer == 0 ||  answer == -1));
+    } while (!(answer == 0 || answer == 1 || answer == 2 || answer == -1));
 
     if (answer == 0)
     {
-        audio->stopStream();
-
+        // The stream keeps running while the new HRTF is loaded
         ChangeResamplingStep();
-
-        audio->startStream();
     }
+    else if (answer == 1) { telemetry.PrintTable(std::cout); }
+    else if (answer == 2) { telemetry.PrintJSON(std::cout); }
+    CollectRetiredResources();
     return answer;
 
 }
@@ -601,36 +1009,117 @@ int TestOnlineInterpolation()
         std::cout << "0: Press 0 if you want to Disabled Online Interpolation." << std::endl;
         std::cout << "1: Press 1 if you want to Activate Online Interpolation." << std::endl;
         std::cout << "2: Press 2 if you want to change HRTF Resampling Step." << std::endl;
+        std::cout << "3: Press 3 if you want to load the Near Field ILD." << std::endl;
+        std::cout << "4: Press 4 to show the callback telemetry." << std::endl;
+        std::cout << "5: Press 5 to dump the callback telemetry as JSON." << std::endl;
+        std::cout << "6: Press 6 to measure the lookup cost of the tester HRIR index (not the library render path)." << std::endl;
+        std::cout << "7: Press 7 to preload the other HRTFs of resources." << std::endl;
+        std::cout << "8: Press 8 to switch to a preloaded HRTF." << std::endl;
         std::cout << "-1: Exit" << std::endl;
 
         std::cin >> answer;
         std::cin.clear();
         std::cin.ignore(INT_MAX, '\n');
-    } while (!(answer == 0 || answer == 1 || answer == 2 || answer == -1));
+    } while (!(answer == 0 || answer == 1 || answer == 2 || answer == 3 || answer == 4 || answer == 5 || answer == 6 || answer == 7 || answer == 8 || answer == -1));
 
     if (answer == 0)
     {
-        listener->DisableInterpolation();
+        controlCommands.PushCommand(AUDIO_COMMAND_DISABLE_INTERPOLATION);
         std::cout << "Interpolation Online Disabled" << std::endl;
         answer == '0';
     }
     else if (answer == 1)
     {
-        listener->EnableInterpolation();
+        controlCommands.PushCommand(AUDIO_COMMAND_ENABLE_INTERPOLATION);
         std::cout << "Interpolation Online Enabled" << std::endl;
         answer == '0';
     }else if (answer == 2)
     {
-        audio->stopStream();
-
+        // The stream keeps running while the new HRTF is loaded
         ChangeResamplingStep();
-        
-        audio->startStream();
-
     }
+    else if (answer == 3)
+    {
+        LoadILDInBackground(GetNearFieldILDFilePath(globalParameters.GetSampleRate()));
+    }
+    else if (answer == 4) { telemetry.PrintTable(std::cout); }
+    else if (answer == 5) { telemetry.PrintJSON(std::cout); }
+    else if (answer == 6) { MeasureHRIRLookupCost(); }
+    else if (answer == 7) { PreloadHRTFsInBackground(); }
+    else if (answer == 8) { SelectResidentHRTF(); }
+    CollectRetiredResources();
     return answer;
 }
 
+void MeasureHRIRLookupCost()
+{
+    std::shared_ptr<BRTServices::CHRTF> hrtf;
+    {
+        std::lock_guard<std::mutex> lock(resourceListsMutex);
+        if (!HRTF_list.empty()) { hrtf = HRTF_list[0]; }
+    }
+    if (hrtf == nullptr) {
+        std::cout << "No HRTF loaded" << std::endl;
+        return;
+    }
+
+    CStopwatch stopwatch;
+    CHRTFSpatialIndex index;
+    index.Build(hrtf->GetRawHRTFTable());
+    double buildMilliseconds = stopwatch.GetElapsedMilliseconds();
+
+    // Directions of the source at the centre of every block of one loop of its trajectory, or of a minute if it does not loop
+    CTrajectoryEngine trajectory;
+    if (!trajectory.LoadFromFile(source1TrajectoryFilePath)) { return; }
+    double duration = trajectory.GetPath(0).keyframes.back().time;
+    if (!trajectory.GetPath(0).loop || duration <= 0) { duration = 60; }
+    std::vector<float> azimuths, elevations;
+    double blockSeconds = (double)iBufferSize / iSampleRate;
+    for (double time = 0; time < duration; time += blockSeconds) {
+        trajectory.Evaluate(time, time + blockSeconds, Common::CVector3(0, 0, 0));
+        for (int p = 0; p < trajectory.GetNumberOfPaths(); p++) {
+            Common::CVector3 position = trajectory.GetCentrePosition(p);
+            float distance = std::max(1e-6f, position.GetDistance());
+            float azimuth = std::atan2(position.y, position.x) * 180.0f / (float)M_PI;
+            float elevation = std::asin(std::max(-1.0f, std::min(1.0f, position.z / distance))) * 180.0f / (float)M_PI;
+            azimuths.push_back(azimuth < 0 ? azimuth + 360.0f : azimuth);
+            elevations.push_back(elevation < 0 ? elevation + 360.0f : elevation);
+        }
+    }
+
+    volatile int sink = 0;
+    size_t queries = azimuths.size();
+    int mismatches = 0;
+    TInterpolationTriangle triangle, linearTriangle;
+    stopwatch.Restart();
+    for (size_t i = 0; i < queries; i++) { sink = sink + index.FindNearestLinear(azimuths[i], elevations[i]); }
+    double nearestLinear = stopwatch.GetElapsedMilliseconds();
+    stopwatch.Restart();
+    for (size_t i = 0; i < queries; i++) { sink = sink + index.FindNearest(azimuths[i], elevations[i]); }
+    double nearestIndexed = stopwatch.GetElapsedMilliseconds();
+    stopwatch.Restart();
+    for (size_t i = 0; i < queries; i++) { sink = sink + index.FindTriangleLinear(azimuths[i], elevations[i], triangle); }
+    double triangleLinear = stopwatch.GetElapsedMilliseconds();
+    stopwatch.Restart();
+    for (size_t i = 0; i < queries; i++) { sink = sink + index.FindTriangle(azimuths[i], elevations[i], triangle); }
+    double triangleIndexed = stopwatch.GetElapsedMilliseconds();
+    for (size_t i = 0; i < queries; i++) {
+        bool found = index.FindTriangle(azimuths[i], elevations[i], triangle);
+        bool linearFound = index.FindTriangleLinear(azimuths[i], elevations[i], linearTriangle);
+        if (index.FindNearest(azimuths[i], elevations[i]) != index.FindNearestLinear(azimuths[i], elevations[i]) || found != linearFound ||
+            (found && memcmp(&triangle, &linearTriangle, sizeof(triangle)) != 0)) { mismatches++; }
+    }
+
+    double toNanosecondsPerQuery = 1e6 / std::max<size_t>(1, queries);
+    std::cout << "Tester HRIR index over the measured points of the listener HRTF (the library render path does not use it), " << index.GetNumberOfPoints() << " grid points, " << queries << " source blocks. Index built in " << buildMilliseconds
+        << " ms, " << index.GetAverageCandidatesPerCell() << " candidates per cell" << std::endl;
+    std::cout << "  nearest point:          " << nearestLinear * toNanosecondsPerQuery << " ns per source and block searching the grid, "
+        << nearestIndexed * toNanosecondsPerQuery << " ns with the index" << std::endl;
+    std::cout << "  interpolation triangle: " << triangleLinear * toNanosecondsPerQuery << " ns per source and block searching the grid, "
+        << triangleIndexed * toNanosecondsPerQuery << " ns with the index" << std::endl;
+    std::cout << "  " << mismatches << " queries with a different result" << std::endl;
+}
+
 void ChangeResamplingStep()
 {
     float _resamplingStep;
@@ -646,7 +1135,467 @@ void ChangeResamplingStep()
     resamplingStep = _resamplingStep;
     std::cout << "Resampling Step sets to: " << resamplingStep << std::endl;
 
-    LoadHRTF();
+    // The source orientation is reset by the audio thread when the new HRTF is applied
+    LoadHRTFInBackground(resamplingStep);
+}
 
+//////////////////////////////
+// OFFLINE RENDER
+//////////////////////////////
+
+void ParseCommandLine(int argc, char* argv[], THeadlessSettings& settings)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--offline" && i + 1 < argc) {
+            settings.mode = HEADLESS_OFFLINE_RENDER;
+            settings.durationSeconds = (float)std::atof(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.outputFilePath = argv[++i]; }
+        }
+        else if (argument == "--stress" && i + 1 < argc) {
+            settings.mode = HEADLESS_STRESS_TEST;
+            settings.numberOfSources = std::atoi(argv[++i]);
+        }
+        else if (argument == "--stress-near-field" && i + 1 < argc) {
+            settings.mode = HEADLESS_STRESS_NEAR_FIELD;
+            settings.numberOfSources = std::atoi(argv[++i]);
+        }
+        else if (argument == "--stress-directivity" && i + 1 < argc) {
+            settings.mode = HEADLESS_DIRECTIVITY_STRESS;
+            settings.numberOfSources = std::atoi(argv[++i]);
+        }
+        else if (argument == "--stress-search") {
+            settings.mode = HEADLESS_STRESS_SEARCH;
+        }
+        else if (argument == "--benchmark-kernels") {
+            settings.mode = HEADLESS_KERNELS_BENCHMARK;
+        }
+        else if (argument == "--benchmark-hrtf") {
+            settings.mode = HEADLESS_HRTF_BENCHMARK;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.benchmarkFilePath = argv[++i]; }
+        }
+        else if (argument == "--benchmark-convolver") {
+            settings.mode = HEADLESS_CONVOLVER_BENCHMARK;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.numberOfSources = std::atoi(argv[++i]); }
+        }
+        else if (argument == "--hrtf-ab") {
+            settings.mode = HEADLESS_HRTF_AB_RENDER;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.durationSeconds = (float)std::atof(argv[++i]); }
+        }
+        else if (argument == "--hrtf-storage") {
+            settings.mode = HEADLESS_HRTF_STORAGE_REPORT;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.storageResamplingStep = (float)std::atof(argv[++i]); }
+        }
+        else if (argument == "--baseline" && i + 1 < argc) {
+            settings.baselineFilePath = argv[++i];
+        }
+        else if (argument == "--record-baseline" && i + 1 < argc) {
+            settings.baselineFilePath = argv[++i];
+            settings.recordBaseline = true;
+        }
+        else if (argument == "--threads" && i + 1 < argc) {
+            settings.numberOfThreads = std::atoi(argv[++i]);
+        }
+        else if (argument == "--trajectory" && i + 1 < argc) {
+            source1TrajectoryFilePath = argv[++i];
+        }
+        else if (argument == "--sample-rate" && i + 1 < argc) {
+            settings.sampleRate = std::atoi(argv[++i]);
+        }
+        else if (argument == "--multi-listener" && i + 1 < argc) {
+            settings.mode = HEADLESS_MULTI_LISTENER_BENCHMARK;
+            settings.numberOfSources = std::atoi(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.numberOfListeners = std::atoi(argv[++i]); }
+        }
+        else if (argument == "--benchmark-log") {
+            settings.mode = HEADLESS_LOG_BENCHMARK;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.warningsPerBurst = std::atoi(argv[++i]); }
+        }
+        else if (argument == "--load-assets") {
+            settings.mode = HEADLESS_ASSET_LOADING_BENCHMARK;
+            if (i + 1 < argc && argv[i + 1][0] != '-') { settings.assetManifestFilePath = argv[++i]; }
+        }
+        else if (argument == "--sample-rate-report") {
+            settings.mode = HEADLESS_SAMPLE_RATE_REPORT;
+        }
+        else if (argument == "--buffer-size" && i + 1 < argc) {
+            settings.bufferSize = std::atoi(argv[++i]);
+        }
+        else if (argument == "--online-interpolation") {
+            settings.enableOnlineInterpolation = true;
+        }
+        else if (argument == "--abort-on-rt-allocation") {
+            CRTAllocationDetector::SetAbortOnAllocation(true);
+        }
+        else if (argument == "--no-hrtf-cache") {
+            rawHRTFCache.SetEnabled(false);
+        }
+        else {
+            std::cout << "Unknown argument: " << argument << std::endl;
+            std::cout << "Usage: " << argv[0] << " [--offline <seconds> [output.wav] | --stress <sources> | --stress-near-field <sources> | --stress-search | --stress-directivity <sources> | --benchmark-kernels | --benchmark-hrtf [results.json] [--baseline <file> | --record-baseline <file>] | --benchmark-convolver [sources] | --hrtf-storage [step] | --hrtf-ab [seconds] | --sample-rate-report | --multi-listener <sources> [listeners] | --benchmark-log [warnings] | --load-assets [manifest]] [--threads <n>] [--trajectory <file>] [--buffer-size <samples>] [--sample-rate <Hz>] [--online-interpolation] [--abort-on-rt-allocation] [--no-hrtf-cache]" << std::endl;
+        }
+    }
+    if (settings.durationSeconds <= 0 || settings.bufferSize <= 0 || settings.numberOfSources <= 0 || settings.numberOfThreads <= 0 || settings.storageResamplingStep <= 0 || settings.sampleRate <= 0 || settings.numberOfListeners <= 0 || settings.warningsPerBurst <= 0) {
+        std::cout << "Invalid offline render duration, buffer size, number of sources, number of threads, resampling step, sample rate, number of listeners or number of warnings" << std::endl;
+        exit(1);
+    }
+}
+
+bool RenderOffline(float durationSeconds, std::string outputFilePath)
+{
+    unsigned int numberOfBlocks = (unsigned int)std::ceil(durationSeconds * iSampleRate / iBufferSize);
+    std::vector<float> interlacedOutput((size_t)numberOfBlocks * iBufferSize * 2);		// Whole render is kept in memory and written at the end, so disk I/O is not timed
+
+    if (!source1Stream.IsOpen()) {
+        std::cout << "The source file can not be played, nothing to render" << std::endl;
+        return false;
+    }
+    std::cout << std::endl << "Rendering " << numberOfBlocks << " blocks of " << iBufferSize << " samples offline..." << std::endl;
+
+    source1Stream.SetWaitOnUnderrun(true);                      // Faster than real time: the render waits for the prefetch thread
+    std::clock_t cpuStart = std::clock();
+    std::chrono::steady_clock::time_point wallStart = std::chrono::steady_clock::now();
+
+    for (unsigned int block = 0; block < numberOfBlocks; block++) {
+        ProcessBlock(&interlacedOutput[(size_t)block * iBufferSize * 2], iBufferSize);
+    }
+
+    std::clock_t cpuEnd = std::clock();
+    std::chrono::steady_clock::time_point wallEnd = std::chrono::steady_clock::now();
+    source1Stream.SetWaitOnUnderrun(false);
+
+    double renderedSeconds = (double)numberOfBlocks * iBufferSize / iSampleRate;
+    double cpuSeconds = (double)(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+    double wallSeconds = std::chrono::duration<double>(wallEnd - wallStart).count();
+
+    std::cout << "Rendered audio:     " << renderedSeconds << " s" << std::endl;
+    std::cout << "CPU time:           " << cpuSeconds << " s" << std::endl;
+    std::cout << "Wall-clock time:    " << wallSeconds << " s" << std::endl;
+    if (cpuSeconds > 0) { std::cout << "Real-time factor:   " << renderedSeconds / cpuSeconds << " (rendered seconds per CPU second)" << std::endl; }
+    if (wallSeconds > 0) { std::cout << "Wall-clock speed:   " << renderedSeconds / wallSeconds << "x real time" << std::endl; }
+
+    ReportRealTimeAllocations();
+
+    if (!SaveWav(interlacedOutput, 2, outputFilePath.c_str())) { return false; }
+    std::cout << "Binaural output written to " << outputFilePath << std::endl;
+    return true;
+}
+
+void TestOfflineRender()
+{
+    float durationSeconds;
+    do {
+        std::cout << "Enter the duration of the render in seconds: ";
+        std::cin >> durationSeconds;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(durationSeconds > 0));
+
+    ResetOrientationSource();
+    RenderOffline(durationSeconds, OFFLINE_RENDER_FILEPATH);
     ResetOrientationSource();
-}
\ No newline at end of file
+}
+
+bool RenderHRTFBankAB(float durationSeconds, std::string outputFilePath)
+{
+    std::cout << std::endl << "Preloading the HRTF bank..." << std::endl;
+    CStopwatch stopwatch;
+    if (EnsureHRTFBank() && hrtfBank.GetNumberOfHRTFs() < 2) { PreloadHRTFBank(sofaReader); }
+    int numberOfHRTFs = hrtfBank.GetNumberOfHRTFs();
+    if (numberOfHRTFs < 2 || stressSourceSamples.empty()) {
+        std::cout << "The A/B render needs two HRTFs in the bank and the source audio" << std::endl;
+        return false;
+    }
+    std::cout << numberOfHRTFs << " HRTFs, " << hrtfBank.GetMemoryBytes() / 1048576.0 << " MB of partitioned HRIRs, loaded in "
+        << stopwatch.GetElapsedMilliseconds() << " ms" << std::endl;
+
+    // The same render twice: switching filters with a one block crossfade, and at once
+    CUniformPartitionedConvolver crossfaded, switched;
+    crossfaded.Setup(iBufferSize, hrtfBank.GetMaxPartitions());
+    switched.Setup(iBufferSize, hrtfBank.GetMaxPartitions());
+    size_t numberOfBlocks = (size_t)std::ceil(durationSeconds * iSampleRate / iBufferSize);
+    size_t blockSwitchInterval = std::max<size_t>(1, (size_t)(HRTF_AB_SWITCH_SECONDS * iSampleRate / iBufferSize));
+    std::vector<float> interlacedOutput(numberOfBlocks * iBufferSize * 2), switchedOutput(numberOfBlocks * iBufferSize);
+    std::vector<float> input(iBufferSize), left(iBufferSize), right(iBufferSize);
+    std::vector<double> switchBlockTimes, otherBlockTimes, selectTimes;
+    std::vector<size_t> hrtfSwitches;
+    double blockSeconds = (double)iBufferSize / iSampleRate;
+    size_t sourcePosition = 0;
+
+    for (size_t block = 0; block < numberOfBlocks; block++) {
+        source1Trajectory.Evaluate(block * blockSeconds, (block + 1) * blockSeconds, Common::CVector3(0, 0, 0));
+        Common::CVector3 position = source1Trajectory.GetCentrePosition(0);
+        float distance = std::max(1e-6f, position.GetDistance());
+        float azimuth = std::atan2(position.y, position.x) * 180.0f / (float)M_PI;
+        float elevation = std::asin(std::max(-1.0f, std::min(1.0f, position.z / distance))) * 180.0f / (float)M_PI;
+        int hrtfIndex = (int)((block / blockSwitchInterval) % numberOfHRTFs);
+        if (block > 0 && block % blockSwitchInterval == 0) { hrtfSwitches.push_back(block); }
+
+        for (int i = 0; i < iBufferSize; i++, sourcePosition = (sourcePosition + 1) % stressSourceSamples.size()) { input[i] = stressSourceSamples[sourcePosition]; }
+
+        stopwatch.Restart();
+        const CPartitionedFilter* filter = hrtfBank.FindFilter(hrtfIndex, azimuth < 0 ? azimuth + 360.0f : azimuth, elevation < 0 ? elevation + 360.0f : elevation);
+        crossfaded.SetFilter(filter);
+        selectTimes.push_back(stopwatch.GetElapsedMilliseconds());
+        size_t crossfades = crossfaded.GetNumberOfCrossfades();
+        crossfaded.Process(input.data(), left.data(), right.data());
+        double blockTime = stopwatch.GetElapsedMilliseconds();
+        (crossfaded.GetNumberOfCrossfades() != crossfades ? switchBlockTimes : otherBlockTimes).push_back(blockTime);
+        GetAudioKernels().Interleave(left.data(), right.data(), &interlacedOutput[block * iBufferSize * 2], iBufferSize);
+
+        switched.SetFilter(filter, false);
+        switched.Process(input.data(), &switchedOutput[block * iBufferSize], right.data());
+    }
+
+    // Largest step between consecutive left samples where the HRTF changes, relative to the largest step inside the blocks
+    auto stepRatio = [&](const float* _samples, size_t _stride) {
+        double boundaryStep = 0, interiorStep = 0;
+        for (size_t n = 1; n < numberOfBlocks * iBufferSize; n++) {
+            double step = std::fabs(_samples[n * _stride] - _samples[(n - 1) * _stride]);
+            if (n % iBufferSize != 0) { interiorStep = std::max(interiorStep, step); }
+        }
+        for (size_t block : hrtfSwitches) {
+            size_t n = block * iBufferSize;
+            boundaryStep = std::max(boundaryStep, (double)std::fabs(_samples[n * _stride] - _samples[(n - 1) * _stride]));
+        }
+        return interiorStep > 0 ? boundaryStep / interiorStep : 0.0;
+    };
+
+    double deadline = 1000.0 * iBufferSize / iSampleRate;
+    TTimingStatistics switchStatistics = ComputeTimingStatistics(switchBlockTimes, deadline);
+    TTimingStatistics otherStatistics = ComputeTimingStatistics(otherBlockTimes, deadline);
+    TTimingStatistics selectStatistics = ComputeTimingStatistics(selectTimes, deadline);
+    std::cout << hrtfSwitches.size() << " HRTF switches every " << HRTF_AB_SWITCH_SECONDS << " s, " << crossfaded.GetNumberOfCrossfades()
+        << " crossfaded blocks (the source also moves between grid points)" << std::endl;
+    std::cout << "Filter selection: " << 1e6 * selectStatistics.mean << " ns per block, " << 1e6 * selectStatistics.max << " ns at most" << std::endl;
+    PrintTimingStatisticsHeader("blocks");
+    PrintTimingStatisticsRow("steady", otherStatistics);
+    PrintTimingStatisticsRow("crossfade", switchStatistics);
+    std::cout << "Largest step at an HRTF switch over the largest step inside the blocks: " << stepRatio(interlacedOutput.data(), 2)
+        << " crossfaded, " << stepRatio(switchedOutput.data(), 1) << " switched at once" << std::endl;
+
+    if (!SaveWav(interlacedOutput, 2, outputFilePath.c_str())) { return false; }
+    std::cout << "Binaural output written to " << outputFilePath << std::endl;
+    return true;
+}
+
+//////////////////////////////
+// STRESS TEST
+//////////////////////////////
+
+void StressTest(int _numberOfSources, bool _enableOnlineInterpolation, int _numberOfThreads, bool _enableNearField)
+{
+    TStressTestSettings settings;
+    settings.enableOnlineInterpolation = _enableOnlineInterpolation;
+    settings.numberOfThreads = _numberOfThreads;
+
+    if (_enableNearField) {
+        settings.nearFieldILD = ReadILD(sofaReader, GetNearFieldILDFilePath(iSampleRate));
+        if (settings.nearFieldILD == nullptr || _numberOfSources <= 0) { return; }
+        settings.numberOfSources = _numberOfSources;
+        std::cout << std::endl << "Near field stress test: " << _numberOfSources << " moving sources, buffer size " << iBufferSize << ", " << _numberOfThreads << " thread(s)" << std::endl;
+        RunNearFieldStressTest(listenerAppliedHRTF, stressSourceSamples, settings);
+        return;
+    }
+
+    if (_numberOfSources > 0) {
+        settings.numberOfSources = _numberOfSources;
+        std::cout << std::endl << "Stress test: " << _numberOfSources << " moving sources, buffer size " << iBufferSize << ", " << _numberOfThreads << " thread(s)" << std::endl;
+        if (_numberOfThreads > 1) {
+            RunStressTestThreadComparison(listenerAppliedHRTF, stressSourceSamples, settings);
+            return;
+        }
+        TTimingStatistics statistics = RunStressTest(listenerAppliedHRTF, stressSourceSamples, settings);
+        PrintTimingStatisticsHeader("sources");
+        PrintTimingStatisticsRow(std::to_string(_numberOfSources), statistics);
+        return;
+    }
+
+    // The HRTF partitions depend on the buffer size, so it is loaded again (or taken from the cache) for each one
+    std::cout << std::endl << "Stress test: searching the maximum number of sources for each buffer size" << std::endl;
+    RunStressTestBufferSizeSweep([](int _bufferSize) {
+        globalParameters.SetBufferSize(_bufferSize);                        // ReadHRTF partitions and keys the cache with the global buffer size
+        return ReadHRTF(sofaReader, SOFA4_FILEPATH, resamplingStep);
+    }, stressSourceSamples, settings);
+}
+
+void TestStress()
+{
+    int numberOfSources;
+    do {
+        std::cout << "Enter the number of sources (0 to search the maximum for every buffer size): ";
+        std::cin >> numberOfSources;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfSources >= 0));
+
+    int numberOfThreads;
+    do {
+        std::cout << "Enter the number of threads (1 for serial processing, " << std::thread::hardware_concurrency() << " cores available): ";
+        std::cin >> numberOfThreads;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfThreads >= 1));
+
+    int nearField = 0;
+    if (numberOfSources > 0) {
+        do {
+            std::cout << "Enter 1 to measure the near field effect cost per source, 0 otherwise: ";
+            std::cin >> nearField;
+            std::cin.clear();
+            std::cin.ignore(INT_MAX, '\n');
+        } while (!(nearField == 0 || nearField == 1));
+    }
+
+    StressTest(numberOfSources, true, numberOfThreads, nearField == 1);
+}
+
+bool ConvolverBenchmark(int _numberOfSources)
+{
+    return RunConvolverBenchmark(BRIR_FILEPATH, iSampleRate, RTAUDIO_NUMBER_OF_BUFFERS, _numberOfSources);
+}
+
+void TestConvolverBenchmark()
+{
+    int numberOfSources;
+    do {
+        std::cout << "Enter the number of sources: ";
+        std::cin >> numberOfSources;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfSources >= 1));
+
+    ConvolverBenchmark(numberOfSources);
+}
+
+void TestHRTFStorageReport()
+{
+    float step;
+    do {
+        std::cout << "Enter the resampling step of the grid, in degrees: ";
+        std::cin >> step;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(step > 0));
+
+    RunHRTFStorageReport(listenerAppliedHRTF, step, iBufferSize);
+}
+
+bool SampleRateConversionReport()
+{
+    std::vector<std::string> hrtfFilePaths = { SOFA1_FILEPATH, SOFA2_FILEPATH, SOFA3_FILEPATH, SOFA4_FILEPATH };
+    std::vector<std::string> ildFilePaths = { ILD_NearFieldEffect_44100, ILD_NearFieldEffect_48000, ILD_NearFieldEffect_96000 };
+    return RunSampleRateConversionReport(hrtfFilePaths, ildFilePaths);
+}
+
+void MultiListenerBenchmark(int _numberOfSources, int _numberOfListeners)
+{
+    if (EnsureHRTFBank() && hrtfBank.GetNumberOfHRTFs() < 2) { PreloadHRTFBank(sofaReader); }           // Listeners take the HRTFs of the bank in turn
+    RunMultiListenerBenchmark(hrtfBank, stressSourceSamples, _numberOfSources, _numberOfListeners);
+}
+
+void TestMultiListenerBenchmark()
+{
+    int numberOfSources;
+    do {
+        std::cout << "Enter the number of sources: ";
+        std::cin >> numberOfSources;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfSources >= 1));
+
+    int numberOfListeners;
+    do {
+        std::cout << "Enter the maximum number of listeners (1 to " << MULTI_LISTENER_MAX_LISTENERS << "): ";
+        std::cin >> numberOfListeners;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfListeners >= 1 && numberOfListeners <= MULTI_LISTENER_MAX_LISTENERS));
+
+    MultiListenerBenchmark(numberOfSources, numberOfListeners);
+}
+
+void TestAsyncLogBenchmark()
+{
+    int warningsPerBurst;
+    do {
+        std::cout << "Enter the number of warnings raised at once: ";
+        std::cin >> warningsPerBurst;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(warningsPerBurst >= 1));
+
+    RunAsyncLogBenchmark(asyncLog, warningsPerBurst, iBufferSize, iSampleRate);
+}
+
+TAssetReaders GetAssetReaders()
+{
+    TAssetReaders readers;
+    readers.readHRTF = [](BRTReaders::CSOFAReader& _sofaReader, const std::string& _filePath) { return ReadHRTF(_sofaReader, _filePath, resamplingStep); };
+    readers.readILD = [](BRTReaders::CSOFAReader& _sofaReader, const std::string& _filePath) {
+        // Every ILD of the manifest is read as it is, ReadILD would load the file of the engine rate for all of them
+        std::shared_ptr<BRTServices::CILD> ild = std::make_shared<BRTServices::CILD>();
+        std::lock_guard<std::mutex> lock(sofaFileMutex);
+        return _sofaReader.ReadILDFromSofa(_filePath, ild) ? ild : nullptr;
+    };
+    readers.readAudio = [](std::vector<float>& _samples, const std::string& _filePath, float _maximumSeconds) {
+        return LoadWavExcerpt(_samples, _filePath, _maximumSeconds, globalParameters.GetSampleRate());
+    };
+    return readers;
+}
+
+void StartLoadingStartupAssets(CAssetLoader& _loader)
+{
+    TAssetEntry hrtfEntry;
+    hrtfEntry.type = ASSET_HRTF;
+    hrtfEntry.name = "listener";
+    hrtfEntry.filePath = SOFA4_FILEPATH;
+    TAssetEntry sourceEntry;
+    sourceEntry.type = ASSET_AUDIO;
+    sourceEntry.name = "source1";
+    sourceEntry.filePath = SOURCE1_FILEPATH;
+    sourceEntry.audioSeconds = STRESS_TEST_SOURCE_SECONDS;
+    listenerHRTFAsset = _loader.Load(hrtfEntry);
+    source1Asset = _loader.Load(sourceEntry);
+}
+
+bool AssetLoadingBenchmark(std::string _manifestFilePath)
+{
+    std::vector<TAssetEntry> manifest;
+    if (!ReadAssetManifest(_manifestFilePath, manifest)) { return false; }
+
+    // Every run reads and processes the files, none is taken from the raw HRTF table cache
+    bool cacheEnabled = rawHRTFCache.IsEnabled();
+    rawHRTFCache.SetEnabled(false);
+    RunAssetLoadingBenchmark(manifest, GetAssetReaders());
+    rawHRTFCache.SetEnabled(cacheEnabled);
+    return true;
+}
+
+void TestAssetLoadingBenchmark()
+{
+    std::string manifestFilePath;
+    std::cout << "Enter the asset manifest file, or nothing for " << ASSET_MANIFEST_FILEPATH << ": ";
+    std::getline(std::cin, manifestFilePath);
+    if (manifestFilePath.empty()) { manifestFilePath = ASSET_MANIFEST_FILEPATH; }
+
+    AssetLoadingBenchmark(manifestFilePath);
+}
+
+void DirectivityStressTest(int _numberOfSources)
+{
+    RunDirectivityStressTest(stressSourceSamples, _numberOfSources, iBufferSize, iSampleRate);
+}
+
+void TestDirectivityStressTest()
+{
+    int numberOfSources;
+    do {
+        std::cout << "Enter the number of directivity sources: ";
+        std::cin >> numberOfSources;
+        std::cin.clear();
+        std::cin.ignore(INT_MAX, '\n');
+    } while (!(numberOfSources >= 1));
+
+    DirectivityStressTest(numberOfSources);
+}
@@ -23,57 +23,146 @@
 #define _BASICSPATIALISATIONRTAUDIO_H_
 
 #define SAMPLERATE 48000
-//#define SOFA1_FILEPATH "../../resources/hrtf.sofa"
-//#define SOFA2_FILEPATH "../../resources/0_IRC_1008_R_HRIR.sofa"
+#define SOFA1_FILEPATH "../../resources/hrtf.sofa"
+#define SOFA2_FILEPATH "../../resources/0_IRC_1008_R_HRIR.sofa"
 #define SOFA3_FILEPATH "../../resources/ListenResamp15.sofa"
 #define SOFA4_FILEPATH "../../resources/SOFATransparentFront.sofa"
 #define SOURCE1_FILEPATH "../../resources/WhiteNoise_16bits_48000.wav"
+#define SOURCE1_TRAJECTORY_FILEPATH "../../resources/source1_trajectory.txt"
 //#define SOURCE2_FILEPATH "../../resources/speech.wav"
 #define HRTFRESAMPLINGSTEP 15
 #define ILD_NearFieldEffect_44100 "../../resources/NearFieldCompensation_ILD_44100.sofa"
 #define ILD_NearFieldEffect_48000 "../../resources/NearFieldCompensation_ILD_48000.sofa"
 #define ILD_NearFieldEffect_96000 "../../resources/NearFieldCompensation_ILD_96000.sofa"
+#define BRIR_FILEPATH "../../resources/brir.sofa"
 #define EXTRAPOLATION_METHOD "NearestPoint"
+#define RAW_HRTF_CACHE_DIRECTORY "hrtf_cache"
+#define OFFLINE_RENDER_FILEPATH "BRTLibraryTester_offline.wav"
+#define HRTF_BENCHMARK_FILEPATH "hrtf_benchmark.json"
+#define OFFLINE_RENDER_DEFAULT_DURATION   10
+#define OFFLINE_RENDER_DEFAULT_BUFFERSIZE 512
+#define STRESS_TEST_SOURCE_SECONDS 30
+#define RTAUDIO_NUMBER_OF_BUFFERS 4
+#define HRTF_STORAGE_DEFAULT_STEP 5
+#define HRTF_AB_SWITCH_SECONDS 1.0
+#define HRTF_AB_FILEPATH "BRTLibraryTester_hrtf_ab.wav"
+#define ASSET_MANIFEST_FILEPATH "../../resources/assets_manifest.txt"
 
 #define SOURCE1_INITIAL_AZIMUTH     0
 #define SOURCE1_INITIAL_ELEVATION   0
 #define SOURCE1_INITIAL_DISTANCE    2
-#define SOURCE1_INITIAL_SPEED       0.1
 
 
 #include <cstdio>
 #include <cstring>
+#include <ctime>
+#include <chrono>
 #include <RtAudio.h>
 #include <BRTLibrary.h>
 #include "ServiceModules/HRTFTester.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include "RTAllocationDetector.h"
+#include "AudioCommandQueue.hpp"
+#include "BackgroundLoader.hpp"
+#include "TrajectoryEngine.h"
+#include "RawHRTFCache.hpp"
+#include "StressTest.h"
+#include "StreamingAudioSource.h"
+#include "AudioKernels.h"
+#include "AudioKernelsBenchmark.h"
+#include "HRTFBenchmark.h"
+#include "GridResampler.h"
+#include "HRTFSpatialIndex.h"
+#include "ConvolverBenchmark.h"
+#include "HRTFStorageReport.h"
+#include "HRTFBank.h"
+#include "SampleRateConverter.h"
+#include "SampleRateConversionReport.h"
+#include "MultiListenerRenderer.h"
+#include "AsyncLogStream.h"
+#include "AssetLoader.h"
+#include "DirectivityRenderer.h"
+#include "RealTimeTelemetry.h"
+
+/** \brief State of a switch to an HRTF of the bank, see AdvanceHRTFSwitch
+*/
+struct THRTFSwitch {
+    bool active = false;                                                                        // The standby listener has the new HRTF and is connected to the source
+    int warmupBlocks = 0;                                                                       // Blocks it still renders unheard before the crossfade
+};
 
 std::shared_ptr<RtAudio>						audio;												 // Pointer to RtAudio API
 
 Common::CGlobalParameters globalParameters;                                                     // Class where the global BRT parameters are defined.
 BRTBase::CBRTManager brtManager;                                                                // BRT global manager interface
+// The audio thread swaps both pointers at the end of an HRTF switch. While the stream runs the menu thread changes the listeners
+// through commands only, and uses these pointers again once the stream is stopped
 std::shared_ptr<BRTListenerModel::CListenerHRTFbasedModel> listener;                            // Pointer to listener model
+std::shared_ptr<BRTListenerModel::CListenerHRTFbasedModel> standbyListener;                     // Same settings, connected to the source only while an HRTF switch crossfades to it
 std::shared_ptr<BRTSourceModel::CSourceSimpleModel> source1BRT;                               // Pointers to each audio source model
 //std::shared_ptr<BRTSourceModel::CSourceSimpleModel> sourceSteps;                                // Pointers to each audio source model
 
 BRTReaders::CSOFAReader sofaReader;                                                             // SOFA reader provide by BRT Library
 BRTServices::CHRTFTester hrtfTester;
 
-std::vector<std::shared_ptr<BRTServices::CHRTF>> HRTF_list;                                     // List of HRTFs sofa loaded
+std::vector<std::shared_ptr<BRTServices::CHRTF>> HRTF_list;                                     // List of HRTFs sofa loaded, the listener one first; the listener can switch to any of them
+std::vector<std::string> HRTF_filePaths;                                                        // SOFA file of each HRTF of HRTF_list
 std::vector<std::shared_ptr<BRTServices::CILD>> ILD_list;                                       // List of NearField coeffients loaded
+CRawHRTFCache rawHRTFCache(RAW_HRTF_CACHE_DIRECTORY);                                           // Raw HRIR tables stored on disk, keyed by SOFA contents and configuration
+std::mutex resourceListsMutex;                                                                  // Guards HRTF_list, HRTF_filePaths and ILD_list, also written by the loader thread
+std::mutex sofaFileMutex;                                                                       // Serializes the SOFA file reads, netCDF/HDF5 under the readers is not thread safe
+
+CAudioCommandQueue controlCommands;                                                             // Changes asked from the menu thread, executed by the audio thread
+CAudioCommandQueue loaderCommands;                                                              // Resources loaded in background, installed by the audio thread
+std::shared_ptr<BRTServices::CHRTF> listenerAppliedHRTF;                                        // HRTF currently set in the listener, owned by the audio thread while the stream runs
+std::shared_ptr<BRTServices::CILD> listenerAppliedILD;                                          // ILD currently set in the listener, owned by the audio thread while the stream runs
+CHRTFBank hrtfBank;                                                                             // Partitioned HRTFs of the --hrtf-ab render and the multi-listener benchmark, set up on first use
+THRTFSwitch hrtfSwitch;                                                                         // Switch to a preloaded HRTF in progress, owned by the audio thread
+std::shared_future<TAsset> listenerHRTFAsset;                                                   // Listener HRTF loaded at start-up, awaited by LoadHRTF
+std::shared_future<TAsset> source1Asset;                                                        // Source 1 excerpt loaded at start-up, awaited by SourceSetup
 
 //Common::CTransform						sourcePosition;										 // Storages the position of the steps source
-float source1Azimuth;
-float source1Elevation;
-float source1Distance;
+CTrajectoryEngine						source1Trajectory;									 // Keyframed path of source 1
+std::string								source1TrajectoryFilePath = SOURCE1_TRAJECTORY_FILEPATH;	 // Can be changed with --trajectory
+unsigned long long						source1TrajectorySamples = 0;						 // Samples rendered since the trajectory started, owned by the audio thread
 
 Common::CEarPair<CMonoBuffer<float>>	outputBufferStereo;									 // Stereo buffer containing processed audio
-std::vector<float>						samplesVectorSource1;			                     // Storages the audio from the wav files
-//std::vector<float>						samplesVectorSteps;			                        // Storages the audio from the wav files
+Common::CEarPair<CMonoBuffer<float>>	bufferProcessed;									 // Stereo buffer where the listener output is copied, preallocated
+Common::CEarPair<CMonoBuffer<float>>	standbyBufferProcessed;								 // Output of the standby listener during an HRTF switch, preallocated
+CMonoBuffer<float>						source1Input;										 // Mono buffer with the source 1 input of the current frame, preallocated
+CStreamingAudioSource					source1Stream;										 // Audio of source 1, streamed from the wav file by a prefetch thread
+std::vector<float>						stressSourceSamples;			                     // Excerpt of the source 1 audio, played by the stress test sources
+
+CRealTimeTelemetry                      telemetry;                                           // Stage timings and xruns of every audio callback
+CAsyncLogStream                         asyncLog;                                            // Error handler output, written to the console by its own thread
 
-unsigned int							wavSamplePositionSource1, positionEndFrameSpeech,	 // Storages, respectively, the starting and ending position of the frame being rendered for each source
-                                        wavSamplePositionSteps,  positionEndFrameSteps ;
+CBackgroundLoader                       resourceLoader;                                      // Loader thread. Declared after everything its jobs use, so it is destroyed (joined) first
 
-unsigned int                            loopCounter = 0;
+/** \brief Tests that can be run headless, without audio device
+*/
+enum THeadlessMode { HEADLESS_NONE, HEADLESS_OFFLINE_RENDER, HEADLESS_STRESS_TEST, HEADLESS_STRESS_SEARCH, HEADLESS_KERNELS_BENCHMARK, HEADLESS_HRTF_BENCHMARK, HEADLESS_CONVOLVER_BENCHMARK, HEADLESS_HRTF_STORAGE_REPORT, HEADLESS_HRTF_AB_RENDER, HEADLESS_STRESS_NEAR_FIELD, HEADLESS_SAMPLE_RATE_REPORT, HEADLESS_MULTI_LISTENER_BENCHMARK, HEADLESS_LOG_BENCHMARK, HEADLESS_ASSET_LOADING_BENCHMARK, HEADLESS_DIRECTIVITY_STRESS };
+
+/** \brief Settings of the headless modes, taken from the command line
+*/
+struct THeadlessSettings {
+    THeadlessMode mode = HEADLESS_NONE;                                                        // Interactive tester if none
+    float durationSeconds = OFFLINE_RENDER_DEFAULT_DURATION;                                   // Seconds of audio to render
+    int bufferSize = OFFLINE_RENDER_DEFAULT_BUFFERSIZE;                                        // Buffer size in samples
+    std::string outputFilePath = OFFLINE_RENDER_FILEPATH;                                      // Binaural output ".wav" file
+    std::string benchmarkFilePath = HRTF_BENCHMARK_FILEPATH;                                   // JSON results of the HRTF benchmark
+    std::string baselineFilePath;                                                              // HRTF benchmark results to compare with, none if empty
+    bool recordBaseline = false;                                                               // Store the HRTF benchmark results in baselineFilePath instead
+    bool enableOnlineInterpolation = false;                                                    // Render with the listener online interpolation enabled
+    int numberOfSources = 32;                                                                  // Sources of the stress tests and the convolver benchmark
+    int numberOfThreads = 1;                                                                   // Threads of the stress test, more than 1 compares serial and parallel
+    float storageResamplingStep = HRTF_STORAGE_DEFAULT_STEP;                                   // Grid of the HRTF storage report, in degrees
+    int sampleRate = SAMPLERATE;                                                               // Engine sample rate, HRTFs at other rates are converted on load
+    int numberOfListeners = MULTI_LISTENER_MAX_LISTENERS;                                      // Listeners of the multi-listener benchmark
+    int warningsPerBurst = ASYNC_LOG_BENCHMARK_WARNINGS;                                       // Warnings raised at once in the log benchmark
+    std::string assetManifestFilePath = ASSET_MANIFEST_FILEPATH;                               // Assets of the asset loading benchmark
+};
 
 
 
@@ -90,6 +179,15 @@ int SelectAudioDevice();
 
 void AudioSetup();
 
+/** \brief Allocates every buffer used by the audio path, so that processing a block never allocates memory
+*/
+void AudioBuffersSetup();
+
+/** \brief Prints how many allocations have been done from the audio path since the last report, when the detector is enabled,
+*	and the source frames lost to streaming underruns since the start
+*/
+void ReportRealTimeAllocations();
+
 void SourceSetup();
 
 void ListenerSetup();
@@ -98,21 +196,25 @@ void AudioSetupAndStart();
 
 void LoadHRTF();
 
+/** \brief Restarts the source trajectory. The trajectory belongs to the audio thread while the stream runs: other threads send
+*	AUDIO_COMMAND_RESET_SOURCE_TRAJECTORY instead
+*/
 void ResetOrientationSource();
 
-/** \brief Fills a buffer with the correct audio frame from the input float vector
-*	\param [out] output output buffer
-*	\param [in,out] position starting position of the frame to be processed
-*	\param [in,out] endChunk ending position of the frame to be processed
-*	\param [in] samplesVector float vector containing the whole audio
+/** \brief Saves an interlaced buffer as a 32-bit float ".wav" file at the engine sample rate
+*	\param [in] interlacedSamples interlaced samples of all channels
+*	\param [in] numberOfChannels number of interlaced channels
+*	\param [in] stringOut name of the ".wav" file to write
+*	\retval false if the file could not be created or written
 */
-void FillBuffer(CMonoBuffer<float>& output, unsigned int & position, unsigned int & endChunk, std::vector<float>& samplesVector);
+bool SaveWav(const std::vector<float>& interlacedSamples, int numberOfChannels, const char* stringOut);
 
-/** \brief Loads a mono, 16-bit, 44.1kHz ".wav" file
-*	\param [out] samplesVector float vector that will storage the whole audio
-*	\param [in] stringIn name of the ".wav" file to open
+/** \brief Processes one block: renders the scene, interlaces it into the output and moves the source.
+*	It is shared by the RtAudio callback and the offline render, so both run exactly the same path
+*	\param [out] interlacedOutput stereo interlaced output, with room for 2 * uiBufferSize samples
+*	\param [in] uiBufferSize size of buffer in samples
 */
-void LoadWav(std::vector<float>& samplesVector, const char* stringIn);
+void ProcessBlock(float* interlacedOutput, unsigned int uiBufferSize);
 
 /** \brief This function is called each time RtAudio needs a buffer to output
 *	\param [out] outputBuffer output buffer to be filled
@@ -139,30 +241,113 @@ bool LoadSofaFile(std::string _filePath);
 */
 bool LoadILD(std::string _ildFilePath);
 
-void MoveSource();
+/**
+ * @brief Reads and processes an HRTF SOFA file with certain resampling Step, converting its HRIRs to the engine sample rate if needed
+ * @param _sofaReader reader to use, each thread needs its own one
+ * @param _filePath 
+ * @param _resamplingStep 
+ * @param _partitions if not nullptr, filled with its HRIRs partitioned with the buffer size, restored from the raw table cache or computed when the cache is written
+ * @return the HRTF, or nullptr if it could not be loaded
+*/
+std::shared_ptr<BRTServices::CHRTF> ReadHRTF(BRTReaders::CSOFAReader& _sofaReader, std::string _filePath, float _resamplingStep, TRawHRTFCachePartitions* _partitions = nullptr);
+
+/**
+ * @brief Reads an ILD SOFA file. If its sample rate is not the engine one, the bundled near field ILD of the nearest rate is read instead
+ * @param _sofaReader reader to use, each thread needs its own one
+ * @param _ildFilePath 
+ * @return the ILD, or nullptr if it could not be loaded
+*/
+std::shared_ptr<BRTServices::CILD> ReadILD(BRTReaders::CSOFAReader& _sofaReader, std::string _ildFilePath);
+
+/**
+ * @brief Loads the listener HRTF in the loader thread. The stream keeps running with the current HRTF until the new one is
+ * swapped in by the audio thread at a block boundary
+ * @param _resamplingStep 
+*/
+void LoadHRTFInBackground(float _resamplingStep);
+
+/**
+ * @brief Loads the near field ILD in the loader thread and swaps it into the listener at a block boundary
+ * @param _ildFilePath 
+*/
+void LoadILDInBackground(std::string _ildFilePath);
+
+/**
+ * @brief Sets the HRTF bank up with the listener HRTF as its first one, unless it already is. Called from the menu thread,
+ * before anything else uses the bank. Only the --hrtf-ab render and the multi-listener benchmark use the bank, live HRTF
+ * switching takes the HRTFs of HRTF_list
+ * @return false if there is no listener HRTF
+*/
+bool EnsureHRTFBank();
+
+/**
+ * @brief Reads the other HRTF SOFA files of resources and adds them to the HRTF bank, set up with EnsureHRTFBank
+ * @param _sofaReader reader of the calling thread
+ * @return number of HRTFs added
+*/
+int PreloadHRTFBank(BRTReaders::CSOFAReader& _sofaReader);
+
+/**
+ * @brief Reads, in the loader thread, the other HRTF SOFA files of resources not yet in HRTF_list, and adds them to it
+*/
+void PreloadHRTFsInBackground();
+
+/**
+ * @brief Asks for an HRTF of HRTF_list and sends it to the audio thread, which crossfades the listener output to it (see AdvanceHRTFSwitch)
+*/
+void SelectResidentHRTF();
+
+/**
+ * @brief Tells the commands that change a listener, which wait while an HRTF switch is in progress, from those that move a source
+ * @param _command
+ * @return true for every command but source transforms and trajectory resets
+*/
+bool IsListenerCommand(const TAudioCommand& _command);
+
+/**
+ * @brief Runs one block of an HRTF switch, after the listeners have been processed: while the standby listener, which has the
+ * new HRTF, fills its convolution and delay lines the current output is kept; then the output is crossfaded to the standby
+ * listener over one block, the old listener is disconnected from the source and both listeners swap roles. Called by the audio thread
+ * @param _bufferSize samples of bufferProcessed
+*/
+void AdvanceHRTFSwitch(int _bufferSize);
 
 /**
- * @brief Move the source in the transverse plane, with a circular trajectory
- * @param loopCounter 
+ * @brief Executes the commands sent by the menu and loader threads: source transforms, listener flags and HRTF/ILD swaps.
+ * Called by the audio thread at the start of each block. While an HRTF switch is in progress, listener commands wait until it
+ * ends, in order; source commands still run
 */
-void MoveSource_CircularPathTransversePlane(unsigned int& loopCounter);
+void ExecuteAudioCommands();
 
 /**
- * @brief Move the source in the Sagittal plane, with a circular trajectory
- * @param loopCounter 
+ * @brief Executes one command on the audio thread
+ * @param _command for HRTF and ILD swaps, the replaced resource is left in the command holder
 */
-void MoveSource_CircularPathSagittalPlane(unsigned int& loopCounter);
+void ExecuteAudioCommand(TAudioCommand& _command);
 
 /**
- * @brief Convert spherical coordinates to Cartesians
- * @param azimuth 
- * @param elevation 
- * @param radius 
+ * @brief Releases the HRTF and ILD replaced by the audio thread. Called from the menu thread
+*/
+void CollectRetiredResources();
+
+/**
+ * @brief Returns the near field ILD file that matches a sample rate
+ * @param _sampleRate 
  * @return 
 */
-Common::CVector3 Spherical2Cartesians(float azimuth, float elevation, float radius);
+std::string GetNearFieldILDFilePath(int _sampleRate);
+
+/**
+ * @brief Loads the source 1 trajectory. If the file cannot be read, the source stays at its initial position
+ * @param _filePath 
+*/
+void LoadSourceTrajectory(const std::string& _filePath);
 
-double d2r(double d);
+/**
+ * @brief Moves the source to where its trajectory is in the middle of the next block, and advances the trajectory time
+ * @param uiBufferSize 
+*/
+void MoveSource(unsigned int uiBufferSize);
 
 int MenuTest();
 
@@ -172,6 +357,13 @@ int MenuTest();
 */
 void TestGridCreationMain(std::string _filePath);
 
+/**
+ * @brief Measures, along the source trajectory, the cost of finding the nearest HRIR and the interpolation triangle for one
+ * source in one block, searching the measured points of the listener HRTF and with a CHRTFSpatialIndex, and checks both agree.
+ * Both searches are tester code: the library render path keeps its own lookups, which this does not measure
+*/
+void MeasureHRIRLookupCost();
+
 /**
  * @brief Method that tests the (not) interpolation of a SOFA already interpolated
  * @param _filePath 
@@ -184,5 +376,126 @@ int TestOnlineInterpolation();
 
 void ChangeResamplingStep();
 
+/**
+ * @brief Reads the command line options of the headless modes
+ * @param argc 
+ * @param argv 
+ * @param settings headless settings, filled with the options found. Its mode is HEADLESS_NONE for the interactive tester
+*/
+void ParseCommandLine(int argc, char* argv[], THeadlessSettings& settings);
+
+/**
+ * @brief Renders the scene as fast as possible, without audio device, writes the result to a .wav file and reports the real-time factor
+ * @param durationSeconds seconds of audio to render
+ * @param outputFilePath binaural output .wav file
+ * @return 
+*/
+bool RenderOffline(float durationSeconds, std::string outputFilePath);
+
+/**
+ * @brief Interactive version of the offline render, launched from the tests menu
+*/
+void TestOfflineRender();
+
+/**
+ * @brief Renders the source along its trajectory with the HRIRs of the HRTF bank, switching HRTF every HRTF_AB_SWITCH_SECONDS,
+ * with a crossfade and at once. Reports the cost of selecting filters and of crossfade blocks, and the discontinuity at the switches
+ * @param durationSeconds seconds of audio to render
+ * @param outputFilePath binaural output .wav file, crossfaded
+ * @return false if there are not two HRTFs in the bank
+*/
+bool RenderHRTFBankAB(float durationSeconds, std::string outputFilePath);
+
+/**
+ * @brief Runs the stress test with many moving sources
+ * @param _numberOfSources sources to connect to the listener; 0 searches the maximum that meets the deadline at every buffer size
+ * @param _enableOnlineInterpolation 
+ * @param _numberOfThreads threads processing the sources; with more than 1 a single test is run both serially and in parallel
+ * @param _enableNearField loads the near field ILD and measures the near field effect cost per source, needs _numberOfSources
+*/
+void StressTest(int _numberOfSources, bool _enableOnlineInterpolation, int _numberOfThreads, bool _enableNearField = false);
+
+/**
+ * @brief Interactive version of the stress test, launched from the tests menu
+*/
+void TestStress();
+
+/**
+ * @brief Runs the convolver benchmark with the BRIRs of BRIR_FILEPATH
+ * @param _numberOfSources
+ * @return false if the BRIRs cannot be read
+*/
+bool ConvolverBenchmark(int _numberOfSources);
+
+/**
+ * @brief Interactive version of the convolver benchmark, launched from the tests menu
+*/
+void TestConvolverBenchmark();
+
+/**
+ * @brief Interactive version of the HRTF storage report, launched from the tests menu
+*/
+void TestHRTFStorageReport();
+
+/**
+ * @brief Times the conversion of every bundled HRTF file to the engine sample rates it is not sampled at
+ * @return false if a file could not be converted
+*/
+bool SampleRateConversionReport();
+
+/**
+ * @brief Preloads the HRTF bank and renders the same moving sources for 1 to _numberOfListeners listeners, reporting the cost per additional listener
+ * @param _numberOfSources
+ * @param _numberOfListeners
+*/
+void MultiListenerBenchmark(int _numberOfSources, int _numberOfListeners);
+
+/**
+ * @brief Interactive version of the multi-listener benchmark, launched from the tests menu
+*/
+void TestMultiListenerBenchmark();
+
+/**
+ * @brief Interactive version of the log benchmark, launched from the tests menu
+*/
+void TestAsyncLogBenchmark();
+
+/**
+ * @brief Readers used by the asset loader: the tester HRTF path with the current resampling step, ILD files read as they are and wav excerpts
+ * @return the readers
+*/
+TAssetReaders GetAssetReaders();
+
+/**
+ * @brief Starts loading the listener HRTF and the source 1 excerpt in parallel, LoadHRTF and SourceSetup wait for them
+ * @param _loader loader of the start-up assets
+*/
+void StartLoadingStartupAssets(CAssetLoader& _loader);
+
+/**
+ * @brief Loads the assets of a manifest one by one and on the loader thread pool, reporting the time of each asset
+ * @param _manifestFilePath 
+ * @return false if the manifest could not be read
+*/
+bool AssetLoadingBenchmark(std::string _manifestFilePath);
+
+/**
+ * @brief Interactive version of the asset loading benchmark, launched from the tests menu
+*/
+void TestAssetLoadingBenchmark();
+
+/**
+ * @brief Renders up to _numberOfSources directivity sources with the same SRTF, computing the SRTF spectrum at the orientation of
+ * each source, at its bucket per source and once per block for all of them, and reports the cost of each and the error of the buckets.
+ * A benchmark of the tester model, with a synthetic SRTF: the library directivity source is not used
+ * @param _numberOfSources
+*/
+void DirectivityStressTest(int _numberOfSources);
+
+/**
+ * @brief Interactive version of the directivity stress test, launched from the tests menu
+*/
+void TestDirectivityStressTest();
+
 
 #endif
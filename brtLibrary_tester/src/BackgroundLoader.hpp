@@ -0,0 +1,100 @@
+/**
+*
+* \brief Background thread where slow resources (SOFA files...) are loaded
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _BACKGROUNDLOADER_HPP_
+#define _BACKGROUNDLOADER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/** \brief Runs loading jobs, one after another, in a single background thread, so that the menu and the audio
+*	thread never wait for file I/O. The thread is started with the first job and joined on destruction.
+*/
+class CBackgroundLoader {
+public:
+    CBackgroundLoader() : stopRequested(false), jobRunning(false) {}
+
+    ~CBackgroundLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopRequested = true;
+        }
+        jobAvailable.notify_all();
+        if (workerThread.joinable()) { workerThread.join(); }
+    }
+
+    /** \brief Queues a job to be run in the loader thread
+    *	\param [in] _job
+    */
+    void Enqueue(std::function<void()> _job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(_job));
+            if (!workerThread.joinable()) { workerThread = std::thread(&CBackgroundLoader::WorkerLoop, this); }
+        }
+        jobAvailable.notify_one();
+    }
+
+    /** \brief Returns true if there are jobs queued or running
+    */
+    bool IsBusy() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobRunning || !jobs.empty();
+    }
+
+    /** \brief Blocks until every queued job has finished
+    */
+    void WaitUntilIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobsFinished.wait(lock, [this] { return !jobRunning && jobs.empty(); });
+    }
+
+private:
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            jobAvailable.wait(lock, [this] { return stopRequested || !jobs.empty(); });
+            if (jobs.empty()) { return; }           // Stop requested and nothing left to do
+            std::function<void()> job = std::move(jobs.front());
+            jobs.pop_front();
+            jobRunning = true;
+            lock.unlock();
+            job();
+            lock.lock();
+            jobRunning = false;
+            if (jobs.empty()) { jobsFinished.notify_all(); }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobsFinished;
+    std::deque<std::function<void()>> jobs;
+    std::thread workerThread;
+    bool stopRequested;
+    bool jobRunning;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+*
+* \brief Filter spectra stored in 32 bit float, half precision or 16 bit integers with a scale per spectrum
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "CompactSpectra.h"
+#include <cmath>
+#include <cstring>
+
+const char* GetSpectrumStorageName(TSpectrumStorage _storage)
+{
+    switch (_storage) {
+    case SPECTRUM_STORAGE_FLOAT16: return "float16";
+    case SPECTRUM_STORAGE_INT16: return "int16";
+    default: return "float32";
+    }
+}
+
+uint16_t FloatToHalf(float _value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &_value, sizeof(bits));
+    uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+    uint32_t magnitude = bits & 0x7fffffff;
+    if (magnitude >= 0x477fefff) { return magnitude > 0x7f800000 ? uint16_t(sign | 0x7e00) : uint16_t(sign | 0x7bff); }    // NaN, or saturated
+    if (magnitude < 0x38800000) {
+        // Subnormal half: the value is rounded to a multiple of 2^-24 by adding 0.5 (float addition rounds to nearest even)
+        float absolute;
+        std::memcpy(&absolute, &magnitude, sizeof(absolute));
+        float shifted = absolute + 0.5f;
+        uint32_t shiftedBits;
+        std::memcpy(&shiftedBits, &shifted, sizeof(shiftedBits));
+        return uint16_t(sign | (shiftedBits - 0x3f000000));
+    }
+    uint32_t oddMantissa = (magnitude >> 13) & 1;
+    magnitude += 0xc8000fff + oddMantissa;                  // Rebias the exponent (-112 << 23) and round to nearest even
+    return uint16_t(sign | (magnitude >> 13));
+}
+
+CCompactSpectra::CCompactSpectra() : storage(SPECTRUM_STORAGE_FLOAT32), numberOfSpectra(0), spectrumSize(0), kernels(&GetAudioKernels())
+{
+}
+
+void CCompactSpectra::Setup(TSpectrumStorage _storage, size_t _numberOfSpectra, size_t _spectrumSize)
+{
+    storage = _storage;
+    numberOfSpectra = _numberOfSpectra;
+    spectrumSize = _spectrumSize;
+    size_t values = numberOfSpectra * spectrumSize;
+    floatSpectra.assign(storage == SPECTRUM_STORAGE_FLOAT32 ? values : 0, 0.0f);
+    halfSpectra.assign(storage == SPECTRUM_STORAGE_FLOAT16 ? values : 0, 0);
+    integerSpectra.assign(storage == SPECTRUM_STORAGE_INT16 ? values : 0, 0);
+    scales.assign(storage == SPECTRUM_STORAGE_INT16 ? numberOfSpectra : 0, 0.0f);
+    // Shrink what a previous setup left
+    floatSpectra.shrink_to_fit();
+    halfSpectra.shrink_to_fit();
+    integerSpectra.shrink_to_fit();
+    scales.shrink_to_fit();
+}
+
+void CCompactSpectra::Store(size_t _index, const float* _spectrum)
+{
+    size_t first = _index * spectrumSize;
+    if (storage == SPECTRUM_STORAGE_FLOAT32) {
+        std::memcpy(&floatSpectra[first], _spectrum, spectrumSize * sizeof(float));
+    }
+    else if (storage == SPECTRUM_STORAGE_FLOAT16) {
+        for (size_t i = 0; i < spectrumSize; i++) { halfSpectra[first + i] = FloatToHalf(_spectrum[i]); }
+    }
+    else {
+        float peak = 0;
+        for (size_t i = 0; i < spectrumSize; i++) { peak = std::max(peak, std::fabs(_spectrum[i])); }
+        float scale = peak > 0 ? peak / 32767.0f : 1.0f;
+        scales[_index] = scale;
+        for (size_t i = 0; i < spectrumSize; i++) {
+            long value = std::lround(_spectrum[i] / scale);
+            integerSpectra[first + i] = int16_t(std::min(32767L, std::max(-32767L, value)));
+        }
+    }
+}
+
+const float* CCompactSpectra::Read(size_t _index, float* _scratch) const
+{
+    size_t first = _index * spectrumSize;
+    if (storage == SPECTRUM_STORAGE_FLOAT32) { return &floatSpectra[first]; }
+    if (storage == SPECTRUM_STORAGE_FLOAT16) { kernels->ExpandHalfToFloat(&halfSpectra[first], _scratch, spectrumSize); }
+    else { kernels->ExpandInt16ToFloat(&integerSpectra[first], scales[_index], _scratch, spectrumSize); }
+    return _scratch;
+}
+
+size_t CCompactSpectra::GetMemoryBytes() const
+{
+    return floatSpectra.size() * sizeof(float) + halfSpectra.size() * sizeof(uint16_t) + integerSpectra.size() * sizeof(int16_t) + scales.size() * sizeof(float);
+}
@@ -0,0 +1,93 @@
+/**
+*
+* \brief Filter spectra stored in 32 bit float, half precision or 16 bit integers with a scale per spectrum
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _COMPACTSPECTRA_H_
+#define _COMPACTSPECTRA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AudioKernels.h"
+
+/** \brief Formats the filter spectra can be kept in
+*/
+enum TSpectrumStorage { SPECTRUM_STORAGE_FLOAT32, SPECTRUM_STORAGE_FLOAT16, SPECTRUM_STORAGE_INT16 };
+
+/** \brief Name of a storage format, for reports
+*/
+const char* GetSpectrumStorageName(TSpectrumStorage _storage);
+
+/** \brief Set of spectra of the same size, such as the partitions of a filter. In SPECTRUM_STORAGE_FLOAT16 each value is rounded
+*	to the nearest half precision number (saturated to +-65504). In SPECTRUM_STORAGE_INT16 each spectrum is scaled so its largest
+*	real or imaginary part is 32767, and the scale is kept. Compact spectra are expanded to float with the SIMD kernels when read.
+*	Only the tester partitioned convolvers and the HRTF bank use this class; the HRTFs the library renders with stay in 32 bit float.
+*/
+class CCompactSpectra {
+public:
+    CCompactSpectra();
+
+    /** \brief Allocates the spectra, all zero
+    *	\param [in] _storage
+    *	\param [in] _numberOfSpectra
+    *	\param [in] _spectrumSize floats of each spectrum
+    */
+    void Setup(TSpectrumStorage _storage, size_t _numberOfSpectra, size_t _spectrumSize);
+
+    /** \brief Converts a spectrum to the storage format
+    *	\param [in] _index
+    *	\param [in] _spectrum spectrum size floats
+    */
+    void Store(size_t _index, const float* _spectrum);
+
+    /** \brief Reads a spectrum. Does not allocate
+    *	\param [in] _index
+    *	\param [in] _scratch spectrum size floats, where compact spectra are expanded
+    *	\retval the spectrum: the stored one in SPECTRUM_STORAGE_FLOAT32, _scratch otherwise
+    */
+    const float* Read(size_t _index, float* _scratch) const;
+
+    TSpectrumStorage GetStorage() const { return storage; }
+    size_t GetNumberOfSpectra() const { return numberOfSpectra; }
+    size_t GetSpectrumSize() const { return spectrumSize; }
+
+    /** \brief Bytes taken by the spectra and their scales
+    */
+    size_t GetMemoryBytes() const;
+
+private:
+    TSpectrumStorage storage;
+    size_t numberOfSpectra;
+    size_t spectrumSize;
+    std::vector<float> floatSpectra;
+    std::vector<uint16_t> halfSpectra;
+    std::vector<int16_t> integerSpectra;
+    std::vector<float> scales;                      // Of each integer spectrum
+    const TAudioKernels* kernels;
+};
+
+/** \brief Converts a float to IEEE half precision, rounding to nearest even and saturating to the largest finite half
+*/
+uint16_t FloatToHalf(float _value);
+
+#endif
@@ -0,0 +1,188 @@
+/**
+*
+* \brief Latency and load of the uniform and non-uniform partitioned convolvers
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "ConvolverBenchmark.h"
+#include "PartitionedConvolver.h"
+#include "ProcessingStatistics.hpp"
+#include "SampleRateConverter.h"
+#include <SOFA.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    enum TConvolverMode { CONVOLVER_UNIFORM, CONVOLVER_NONUNIFORM_INLINE, CONVOLVER_NONUNIFORM_BACKGROUND };
+
+    struct TConvolverConfiguration {
+        const char* name;
+        TConvolverMode mode;
+        size_t blockSize;
+    };
+
+    volatile float benchmarkSink;           // Keeps the compiler from removing the measured work
+
+    /// Left and right impulse responses of every measurement of a SOFA file (Data.IR is [measurement][receiver][sample]), converted to _sampleRate
+    bool ReadBRIRs(const std::string& _filePath, int _sampleRate, std::vector<std::vector<float>>& _left, std::vector<std::vector<float>>& _right) {
+        std::vector<double> samples, fileRate;
+        size_t numberOfMeasurements, numberOfReceivers, length;
+        try {
+            sofa::File file(_filePath);
+            numberOfMeasurements = file.GetNumMeasurements();
+            numberOfReceivers = file.GetNumReceivers();
+            length = file.GetNumDataSamples();
+            file.GetDataIR(samples);
+            if (!file.GetValues(fileRate, "Data.SamplingRate") || fileRate.empty()) { return false; }
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+        if (numberOfMeasurements == 0 || numberOfReceivers != 2 || length == 0 || samples.size() != numberOfMeasurements * numberOfReceivers * length) { return false; }
+
+        CPolyphaseResampler resampler;
+        bool convert = (int)fileRate[0] != _sampleRate;
+        if (convert && !resampler.Setup((int)fileRate[0], _sampleRate)) { return false; }
+        std::vector<float> input(length);
+        for (size_t m = 0; m < numberOfMeasurements; m++) {
+            for (size_t r = 0; r < 2; r++) {
+                const double* measured = &samples[(m * numberOfReceivers + r) * length];
+                for (size_t i = 0; i < length; i++) { input[i] = (float)measured[i]; }
+                std::vector<std::vector<float>>& filters = r == 0 ? _left : _right;
+                filters.push_back(std::vector<float>());
+                std::vector<float>& output = filters.back();
+                if (!convert) {
+                    output = input;
+                    continue;
+                }
+                output.resize(resampler.GetOutputLength(length));
+                resampler.Process(input.data(), length, output.data());
+            }
+        }
+        if (convert) { std::cout << "BRIRs converted from " << fileRate[0] << " Hz to " << _sampleRate << " Hz" << std::endl; }
+        return true;
+    }
+
+    void PrintHeader() {
+        char line[256];
+        snprintf(line, sizeof(line), "%18s %6s %11s %10s %10s %10s %10s %8s %8s %6s", "convolver", "block", "latency ms", "p50 ms", "p99 ms", "max ms", "deadline", "load %", "misses", "late");
+        std::cout << line << std::endl;
+    }
+
+    void PrintRow(const TConvolverConfiguration& _configuration, double _latency, const TTimingStatistics& _statistics, size_t _lateTails) {
+        char line[256];
+        double load = 100.0 * _statistics.p50 / _statistics.deadline;
+        snprintf(line, sizeof(line), "%18s %6zu %11.1f %10.4f %10.4f %10.4f %10.4f %8.1f %8zu %6zu", _configuration.name, _configuration.blockSize, _latency,
+            _statistics.p50, _statistics.p99, _statistics.max, _statistics.deadline, load, _statistics.blocksOverDeadline, _lateTails);
+        std::cout << line << std::endl;
+    }
+}
+
+bool RunConvolverBenchmark(const std::string& _brirFilePath, int _sampleRate, int _numberOfBuffers, int _numberOfSources)
+{
+    std::vector<std::vector<float>> leftFilters, rightFilters;
+    if (!ReadBRIRs(_brirFilePath, _sampleRate, leftFilters, rightFilters)) {
+        std::cout << "Error reading the BRIRs of " << _brirFilePath << std::endl;
+        return false;
+    }
+
+    const TConvolverConfiguration configurations[] = {
+        { "uniform", CONVOLVER_UNIFORM, CONVOLVER_BENCHMARK_REFERENCE_BLOCK },
+        { "uniform", CONVOLVER_UNIFORM, 256 },
+        { "uniform", CONVOLVER_UNIFORM, 128 },
+        { "non-uniform inline", CONVOLVER_NONUNIFORM_INLINE, 256 },
+        { "non-uniform inline", CONVOLVER_NONUNIFORM_INLINE, 128 },
+        { "non-uniform thread", CONVOLVER_NONUNIFORM_BACKGROUND, 256 },
+        { "non-uniform thread", CONVOLVER_NONUNIFORM_BACKGROUND, 128 },
+    };
+
+    std::cout << std::endl << "Convolver benchmark: " << _numberOfSources << " sources, " << leftFilters.size() << " BRIRs of " << leftFilters[0].size()
+        << " samples from " << _brirFilePath << ", " << _numberOfBuffers << " device buffers" << std::endl;
+    PrintHeader();
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    for (const TConvolverConfiguration& configuration : configurations) {
+        size_t blockSize = configuration.blockSize;
+        CConvolutionTailWorker tailWorker;                  // Declared first, so it outlives the convolvers it serves
+        std::vector<std::unique_ptr<CUniformPartitionedConvolver>> uniformConvolvers;
+        std::vector<std::unique_ptr<CNonUniformPartitionedConvolver>> nonUniformConvolvers;
+        for (int s = 0; s < _numberOfSources; s++) {
+            const std::vector<float>& leftFilter = leftFilters[s % leftFilters.size()];
+            const std::vector<float>& rightFilter = rightFilters[s % rightFilters.size()];
+            if (configuration.mode == CONVOLVER_UNIFORM) {
+                uniformConvolvers.emplace_back(new CUniformPartitionedConvolver());
+                uniformConvolvers.back()->Setup(blockSize, leftFilter.data(), rightFilter.data(), leftFilter.size());
+            }
+            else {
+                nonUniformConvolvers.emplace_back(new CNonUniformPartitionedConvolver());
+                CConvolutionTailWorker* worker = configuration.mode == CONVOLVER_NONUNIFORM_BACKGROUND ? &tailWorker : nullptr;
+                nonUniformConvolvers.back()->Setup(blockSize, 0, leftFilter.data(), rightFilter.data(), leftFilter.size(), worker);
+            }
+        }
+        if (configuration.mode == CONVOLVER_NONUNIFORM_BACKGROUND) { tailWorker.Start(); }
+
+        std::vector<float> input(blockSize), left(blockSize), right(blockSize), mixLeft(blockSize), mixRight(blockSize);
+        for (float& sample : input) { sample = noise(generator); }
+        size_t numberOfBlocks = (size_t)(CONVOLVER_BENCHMARK_SECONDS * _sampleRate / blockSize);
+        std::vector<double> blockTimes;
+        blockTimes.reserve(numberOfBlocks);
+
+        // Blocks are released at the rate a device would ask for them, so a background thread gets the time it would really have
+        std::chrono::duration<double> period((double)blockSize / _sampleRate);
+        std::chrono::steady_clock::time_point release = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numberOfBlocks; b++) {
+            std::this_thread::sleep_until(release);
+            CStopwatch stopwatch;
+            std::fill(mixLeft.begin(), mixLeft.end(), 0.0f);
+            std::fill(mixRight.begin(), mixRight.end(), 0.0f);
+            for (int s = 0; s < _numberOfSources; s++) {
+                if (configuration.mode == CONVOLVER_UNIFORM) { uniformConvolvers[s]->Process(input.data(), left.data(), right.data()); }
+                else { nonUniformConvolvers[s]->Process(input.data(), left.data(), right.data()); }
+                for (size_t i = 0; i < blockSize; i++) {
+                    mixLeft[i] += left[i];
+                    mixRight[i] += right[i];
+                }
+            }
+            blockTimes.push_back(stopwatch.GetElapsedMilliseconds());
+            release += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+        }
+        tailWorker.Stop();
+        benchmarkSink = mixLeft[0] + mixRight[blockSize - 1];
+
+        size_t lateTails = 0;
+        for (const auto& convolver : nonUniformConvolvers) { lateTails += convolver->GetLateTails(); }
+        double latency = 1000.0 * blockSize * _numberOfBuffers / _sampleRate;
+        TTimingStatistics statistics = ComputeTimingStatistics(blockTimes, 1000.0 * blockSize / _sampleRate);
+        PrintRow(configuration, latency, statistics, lateTails);
+    }
+    std::cout << "Latency is the output buffering only (block size x device buffers). Load is the median callback time over the deadline;"
+        << " late counts the tails the background thread had not finished when their output was due" << std::endl;
+    std::cout << "Prototype only: these convolvers are not used by the tester's render path, which renders with the library,"
+        << " so the latencies above are not realised and live rendering still needs the library buffer sizes" << std::endl;
+    return true;
+}
@@ -0,0 +1,48 @@
+/**
+*
+* \brief Latency and load of the uniform and non-uniform partitioned convolvers
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _CONVOLVERBENCHMARK_H_
+#define _CONVOLVERBENCHMARK_H_
+
+#include <string>
+
+#define CONVOLVER_BENCHMARK_SECONDS         3.0         // Audio simulated for every configuration, paced in real time
+#define CONVOLVER_BENCHMARK_REFERENCE_BLOCK 2048        // Buffer size the uniform convolver needs on Linux
+
+/** \brief Convolves _numberOfSources sources with the measured BRIRs of a SOFA file, source i with measurement i modulo their
+*	number, block by block and paced as an audio callback would be, with the uniform convolver at
+*	CONVOLVER_BENCHMARK_REFERENCE_BLOCK, 256 and 128 samples, and with the non-uniform convolver at 256 and 128 samples, computing
+*	the tail in the callback and on a background thread. Prints, for each, the output latency with _numberOfBuffers device
+*	buffers, the callback time percentiles, the load and the late tails.
+*	\details The partitioned convolvers are not part of any render path of the tester, which renders with the library; this only
+*	measures them.
+*	\param [in] _brirFilePath SOFA file with two receivers. BRIRs at another sample rate are converted to _sampleRate
+*	\param [in] _sampleRate
+*	\param [in] _numberOfBuffers buffers queued by the audio device
+*	\param [in] _numberOfSources
+*	\retval false if the file cannot be read
+*/
+bool RunConvolverBenchmark(const std::string& _brirFilePath, int _sampleRate, int _numberOfBuffers, int _numberOfSources);
+
+#endif
@@ -0,0 +1,361 @@
+/**
+*
+* \brief Directivity (SRTF) rendering of many sources, with the SRTF spectra of each orientation bucket shared in a block
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+
+#include "DirectivityRenderer.h"
+#include "ProcessingStatistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    const float PI = 3.14159265358979323846f;
+    const float TALKER_CORNER_FREQUENCY = 1000.0f;      // Hz at which the talker is half way between omnidirectional and directional
+    const float TALKER_BACK_GAIN = 0.25f;               // Gain behind a directional talker
+
+    /// Talkers in rows in front of the listener, which faces the X axis, one metre between rows
+    Common::CVector3 GetTalkerPosition(size_t _source) {
+        size_t row = _source / 8;
+        float azimuth = (-60.0f + 120.0f * (_source % 8) / 7.0f + 7.5f * (row % 2)) * PI / 180.0f;
+        float distance = 2.0f + row;
+        return Common::CVector3(distance * std::cos(azimuth), distance * std::sin(azimuth), 0);
+    }
+
+    /// Each talker faces the listener and turns its head, out of phase with the others
+    float GetTalkerFacingAzimuth(size_t _source, const Common::CVector3& _position, double _time) {
+        float towardsListener = std::atan2(-_position.y, -_position.x) * 180.0f / PI;
+        return towardsListener + DIRECTIVITY_HEAD_TURN * (float)std::sin(2.0 * PI * _time / DIRECTIVITY_HEAD_TURN_PERIOD + 2.399963 * _source);
+    }
+
+    void FillSourceInputs(const std::vector<float>& _sourceSamples, size_t _block, size_t _blockSize, std::vector<std::vector<float>>& _inputs) {
+        for (size_t s = 0; s < _inputs.size(); s++) {
+            size_t position = (_sourceSamples.size() * s / _inputs.size() + _block * _blockSize) % _sourceSamples.size();    // Decorrelated inputs
+            for (size_t i = 0; i < _blockSize; i++, position = (position + 1) % _sourceSamples.size()) { _inputs[s][i] = _sourceSamples[position]; }
+        }
+    }
+}
+
+CSRTF::CSRTF() : blockSize(0), azimuthStep(360), elevationStep(180), numberOfAzimuths(1), numberOfElevations(2)
+{
+}
+
+void CSRTF::Setup(size_t _blockSize, int _sampleRate, float _measuredStep)
+{
+    blockSize = _blockSize;
+    numberOfAzimuths = std::max<size_t>(1, (size_t)std::lround(360.0f / _measuredStep));
+    numberOfElevations = std::max<size_t>(2, (size_t)std::lround(180.0f / _measuredStep) + 1);
+    azimuthStep = 360.0f / numberOfAzimuths;
+    elevationStep = 180.0f / (numberOfElevations - 1);
+
+    size_t spectrumSize = GetSpectrumSize();
+    table.assign(numberOfAzimuths * numberOfElevations * spectrumSize, 0.0f);
+    for (size_t e = 0; e < numberOfElevations; e++) {
+        for (size_t a = 0; a < numberOfAzimuths; a++) {
+            float elevation = (-90.0f + e * elevationStep) * PI / 180.0f;
+            float azimuth = a * azimuthStep * PI / 180.0f;
+            float front = 0.5f + 0.5f * std::cos(elevation) * std::cos(azimuth);     // 1 in front of the talker, 0 behind
+            float* spectrum = table.data() + (e * numberOfAzimuths + a) * spectrumSize;
+            for (size_t bin = 0; bin <= blockSize; bin++) {
+                float frequency = (float)bin * _sampleRate / (2 * blockSize);
+                float directional = frequency / (frequency + TALKER_CORNER_FREQUENCY);
+                spectrum[2 * bin] = 1.0f - directional + directional * (TALKER_BACK_GAIN + (1.0f - TALKER_BACK_GAIN) * front);
+            }
+        }
+    }
+}
+
+void CSRTF::ComputeSpectrum(float _azimuth, float _elevation, float* _spectrum) const
+{
+    float azimuthPosition = _azimuth / azimuthStep;
+    float azimuthFloor = std::floor(azimuthPosition);
+    size_t a0 = (size_t)azimuthFloor % numberOfAzimuths;
+    size_t a1 = (a0 + 1) % numberOfAzimuths;
+    float azimuthWeight = azimuthPosition - azimuthFloor;
+
+    float elevationPosition = (std::max(-90.0f, std::min(90.0f, _elevation)) + 90.0f) / elevationStep;
+    size_t e0 = std::min(numberOfElevations - 2, (size_t)elevationPosition);
+    float elevationWeight = std::min(1.0f, elevationPosition - e0);
+
+    const float* s00 = GetTableSpectrum(a0, e0);
+    const float* s10 = GetTableSpectrum(a1, e0);
+    const float* s01 = GetTableSpectrum(a0, e0 + 1);
+    const float* s11 = GetTableSpectrum(a1, e0 + 1);
+    float w00 = (1.0f - azimuthWeight) * (1.0f - elevationWeight);
+    float w10 = azimuthWeight * (1.0f - elevationWeight);
+    float w01 = (1.0f - azimuthWeight) * elevationWeight;
+    float w11 = azimuthWeight * elevationWeight;
+    size_t spectrumSize = GetSpectrumSize();
+    for (size_t i = 0; i < spectrumSize; i++) { _spectrum[i] = w00 * s00[i] + w10 * s10[i] + w01 * s01[i] + w11 * s11[i]; }
+}
+
+CSRTFBuckets::CSRTFBuckets() : azimuthStep(360), elevationStep(180), numberOfAzimuths(1), numberOfElevations(1)
+{
+}
+
+void CSRTFBuckets::Setup(float _bucketStep)
+{
+    numberOfAzimuths = std::max<size_t>(1, (size_t)std::lround(360.0f / _bucketStep));
+    numberOfElevations = std::max<size_t>(1, (size_t)std::lround(180.0f / _bucketStep));
+    azimuthStep = 360.0f / numberOfAzimuths;
+    elevationStep = 180.0f / numberOfElevations;
+}
+
+size_t CSRTFBuckets::GetBucket(float _azimuth, float _elevation) const
+{
+    size_t azimuthIndex = (size_t)std::max(0.0f, _azimuth / azimuthStep) % numberOfAzimuths;
+    size_t elevationIndex = std::min(numberOfElevations - 1, (size_t)std::max(0.0f, (_elevation + 90.0f) / elevationStep));
+    return elevationIndex * numberOfAzimuths + azimuthIndex;
+}
+
+void CSRTFBuckets::GetBucketOrientation(size_t _bucket, float& _azimuth, float& _elevation) const
+{
+    _azimuth = ((_bucket % numberOfAzimuths) + 0.5f) * azimuthStep;
+    _elevation = -90.0f + ((_bucket / numberOfAzimuths) + 0.5f) * elevationStep;
+}
+
+CSRTFBucketCache::CSRTFBucketCache() : srtf(nullptr), buckets(nullptr), block(0), maxSlots(0), usedSlots(0)
+{
+}
+
+void CSRTFBucketCache::Setup(const CSRTF& _srtf, const CSRTFBuckets& _buckets, size_t _maxBucketsPerBlock)
+{
+    srtf = &_srtf;
+    buckets = &_buckets;
+    block = 0;
+    bucketBlocks.assign(_buckets.GetNumberOfBuckets(), 0);
+    bucketSlots.assign(_buckets.GetNumberOfBuckets(), 0);
+    maxSlots = std::max<size_t>(1, std::min(_maxBucketsPerBlock, _buckets.GetNumberOfBuckets()));
+    slots.assign(maxSlots * _srtf.GetSpectrumSize(), 0.0f);
+    usedSlots = 0;
+}
+
+void CSRTFBucketCache::BeginBlock()
+{
+    block++;
+    if (block == 0) {                                   // Wrapped around, blocks of 2^32 blocks ago could look current
+        std::fill(bucketBlocks.begin(), bucketBlocks.end(), 0);
+        block = 1;
+    }
+    usedSlots = 0;
+}
+
+const float* CSRTFBucketCache::GetSpectrum(size_t _bucket)
+{
+    size_t spectrumSize = srtf->GetSpectrumSize();
+    if (bucketBlocks[_bucket] == block) { return slots.data() + bucketSlots[_bucket] * spectrumSize; }
+
+    float azimuth, elevation;
+    buckets->GetBucketOrientation(_bucket, azimuth, elevation);
+    if (usedSlots == maxSlots) {
+        // More buckets than Setup was told: the last slot is recomputed for each of them and not kept
+        float* spectrum = slots.data() + (maxSlots - 1) * spectrumSize;
+        srtf->ComputeSpectrum(azimuth, elevation, spectrum);
+        return spectrum;
+    }
+    float* spectrum = slots.data() + usedSlots * spectrumSize;
+    srtf->ComputeSpectrum(azimuth, elevation, spectrum);
+    bucketBlocks[_bucket] = block;
+    bucketSlots[_bucket] = (uint32_t)usedSlots++;
+    return spectrum;
+}
+
+CDirectivityRenderer::CDirectivityRenderer() : spectraMode(DIRECTIVITY_SHARED), blockSize(0), computedSpectra(0)
+{
+}
+
+void CDirectivityRenderer::Setup(const std::vector<const CSRTF*>& _srtfs, size_t _numberOfSources, float _bucketStep, TDirectivitySpectra _spectra)
+{
+    srtfs = _srtfs;
+    blockSize = _srtfs.front()->GetBlockSize();
+    spectraMode = _spectra;
+    buckets.Setup(_bucketStep);
+
+    caches.clear();
+    if (spectraMode == DIRECTIVITY_SHARED) {
+        caches.resize(srtfs.size());
+        for (size_t i = 0; i < srtfs.size(); i++) { caches[i].Setup(*srtfs[i], buckets, _numberOfSources); }
+    }
+    fft.reset(new CRealFFT(2 * blockSize));
+    sources.clear();
+    sources.resize(_numberOfSources);
+    for (TSource& source : sources) {
+        source.overlap.assign(blockSize, 0.0f);
+        source.output.assign(blockSize, 0.0f);
+    }
+    size_t spectrumSize = fft->GetSpectrumSize();
+    padded.assign(2 * blockSize, 0.0f);
+    spectrum.assign(spectrumSize, 0.0f);
+    filtered.assign(spectrumSize, 0.0f);
+    sourceSRTF.assign(spectrumSize, 0.0f);
+    result.assign(2 * blockSize, 0.0f);
+    computedSpectra = 0;
+}
+
+void CDirectivityRenderer::SetSource(size_t _source, size_t _srtfIndex, const Common::CVector3& _position, float _facingAzimuth)
+{
+    sources[_source].srtfIndex = _srtfIndex;
+    sources[_source].position = _position;
+    sources[_source].facingAzimuth = _facingAzimuth;
+}
+
+void CDirectivityRenderer::Process(const float* const* _sourceInputs)
+{
+    const TFixedSizeKernels& kernels = fft->GetKernels();
+    for (CSRTFBucketCache& cache : caches) { cache.BeginBlock(); }
+    computedSpectra = 0;
+
+    for (size_t s = 0; s < sources.size(); s++) {
+        TSource& source = sources[s];
+        // Orientation of the listener seen from the source
+        Common::CVector3 direction(listenerPosition.x - source.position.x, listenerPosition.y - source.position.y, listenerPosition.z - source.position.z);
+        float distance = std::max(1e-6f, direction.GetDistance());
+        float azimuth = std::fmod(std::atan2(direction.y, direction.x) * 180.0f / PI - source.facingAzimuth, 360.0f);
+        if (azimuth < 0) { azimuth += 360.0f; }
+        float elevation = std::asin(std::max(-1.0f, std::min(1.0f, direction.z / distance))) * 180.0f / PI;
+
+        const float* srtfSpectrum = sourceSRTF.data();
+        if (spectraMode == DIRECTIVITY_SHARED) { srtfSpectrum = caches[source.srtfIndex].GetSpectrum(buckets.GetBucket(azimuth, elevation)); }
+        else if (spectraMode == DIRECTIVITY_BUCKETED) {
+            float bucketAzimuth, bucketElevation;
+            buckets.GetBucketOrientation(buckets.GetBucket(azimuth, elevation), bucketAzimuth, bucketElevation);
+            srtfs[source.srtfIndex]->ComputeSpectrum(bucketAzimuth, bucketElevation, sourceSRTF.data());
+            computedSpectra++;
+        }
+        else {
+            srtfs[source.srtfIndex]->ComputeSpectrum(azimuth, elevation, sourceSRTF.data());
+            computedSpectra++;
+        }
+
+        // Overlap-add: the second half of the padded input stays zero
+        std::copy(_sourceInputs[s], _sourceInputs[s] + blockSize, padded.begin());
+        fft->Forward(padded.data(), spectrum.data());
+        std::fill(filtered.begin(), filtered.end(), 0.0f);
+        kernels.ComplexMultiplyAccumulate(spectrum.data(), srtfSpectrum, filtered.data(), blockSize + 1);
+        fft->Inverse(filtered.data(), result.data());
+        for (size_t i = 0; i < blockSize; i++) {
+            source.output[i] = result[i] + source.overlap[i];
+            source.overlap[i] = result[blockSize + i];
+        }
+    }
+    for (const CSRTFBucketCache& cache : caches) { computedSpectra += cache.GetComputedSpectra(); }
+}
+
+void RunDirectivityStressTest(const std::vector<float>& _sourceSamples, size_t _numberOfSources, size_t _blockSize, int _sampleRate)
+{
+    if (_sourceSamples.empty() || _numberOfSources == 0) {
+        std::cout << "The directivity stress test needs the source audio" << std::endl;
+        return;
+    }
+    double blockSeconds = (double)_blockSize / _sampleRate;
+    double deadline = 1000.0 * blockSeconds;
+
+    CSRTF talker;
+    talker.Setup(_blockSize, _sampleRate, DIRECTIVITY_MEASURED_STEP);
+    std::vector<const CSRTF*> srtfs(1, &talker);
+
+    std::cout << std::endl << "Directivity sources: up to " << _numberOfSources << " talkers with the same SRTF, buffer size " << _blockSize << ", buckets of "
+        << DIRECTIVITY_BUCKET_STEP << " degrees" << std::endl;
+    std::cout << "The error is that of the shared output against exact spectra at the orientation of each source. Bucketed and shared spectra are"
+        << " evaluated at the same bucket centres, so their match only shows that sharing is deterministic." << std::endl;
+    std::cout << "Model benchmark: a synthetic SRTF and the tester renderer, not the library directivity source or its SRTF convolver,"
+        << " which the tester does not use; the timings say nothing about library directivity sources" << std::endl;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%8s %10s %12s %10s %12s %12s %10s %12s %10s", "sources", "exact ms", "bucketed ms", "shared ms", "shared us/s", "spectra", "error dB",
+        "max error", "same bits");
+    std::cout << row << std::endl;
+
+    std::vector<size_t> sourceCounts;
+    for (size_t count = 1; count < _numberOfSources; count *= 2) { sourceCounts.push_back(count); }
+    sourceCounts.push_back(_numberOfSources);
+
+    for (size_t numberOfSources : sourceCounts) {
+        std::vector<std::vector<float>> inputs(numberOfSources, std::vector<float>(_blockSize));
+        std::vector<const float*> inputPointers(numberOfSources);
+        for (size_t s = 0; s < numberOfSources; s++) { inputPointers[s] = inputs[s].data(); }
+
+        CDirectivityRenderer exact, bucketed, shared;
+        exact.Setup(srtfs, numberOfSources, DIRECTIVITY_BUCKET_STEP, DIRECTIVITY_EXACT);
+        bucketed.Setup(srtfs, numberOfSources, DIRECTIVITY_BUCKET_STEP, DIRECTIVITY_BUCKETED);
+        shared.Setup(srtfs, numberOfSources, DIRECTIVITY_BUCKET_STEP, DIRECTIVITY_SHARED);
+
+        std::vector<double> exactTimes, bucketedTimes, sharedTimes;
+        size_t sharedSpectra = 0;
+        bool identical = true;
+        double squaredDifference = 0, squaredReference = 0, maximumDifference = 0;
+        for (size_t block = 0; block < DIRECTIVITY_WARMUP_BLOCKS + DIRECTIVITY_MEASURED_BLOCKS; block++) {
+            bool measured = block >= DIRECTIVITY_WARMUP_BLOCKS;
+            FillSourceInputs(_sourceSamples, block, _blockSize, inputs);
+            for (size_t s = 0; s < numberOfSources; s++) {
+                Common::CVector3 position = GetTalkerPosition(s);
+                float facingAzimuth = GetTalkerFacingAzimuth(s, position, (block + 0.5) * blockSeconds);
+                exact.SetSource(s, 0, position, facingAzimuth);
+                bucketed.SetSource(s, 0, position, facingAzimuth);
+                shared.SetSource(s, 0, position, facingAzimuth);
+            }
+
+            CStopwatch stopwatch;
+            exact.Process(inputPointers.data());
+            if (measured) { exactTimes.push_back(stopwatch.GetElapsedMilliseconds()); }
+
+            stopwatch.Restart();
+            bucketed.Process(inputPointers.data());
+            if (measured) { bucketedTimes.push_back(stopwatch.GetElapsedMilliseconds()); }
+
+            stopwatch.Restart();
+            shared.Process(inputPointers.data());
+            if (measured) {
+                sharedTimes.push_back(stopwatch.GetElapsedMilliseconds());
+                sharedSpectra += shared.GetComputedSpectraPerBlock();
+            }
+
+            for (size_t s = 0; s < numberOfSources; s++) {
+                identical = identical && memcmp(bucketed.GetOutput(s), shared.GetOutput(s), _blockSize * sizeof(float)) == 0;
+                if (!measured) { continue; }
+                const float* reference = exact.GetOutput(s);
+                const float* output = shared.GetOutput(s);
+                for (size_t i = 0; i < _blockSize; i++) {
+                    double difference = (double)output[i] - reference[i];
+                    squaredDifference += difference * difference;
+                    squaredReference += (double)reference[i] * reference[i];
+                    maximumDifference = std::max(maximumDifference, std::fabs(difference));
+                }
+            }
+        }
+
+        double exactMean = ComputeTimingStatistics(exactTimes, deadline).mean;
+        double bucketedMean = ComputeTimingStatistics(bucketedTimes, deadline).mean;
+        double sharedMean = ComputeTimingStatistics(sharedTimes, deadline).mean;
+        char spectra[32];
+        std::snprintf(spectra, sizeof(spectra), "%zu/%.1f", numberOfSources, (double)sharedSpectra / DIRECTIVITY_MEASURED_BLOCKS);
+        char error[32];
+        if (squaredDifference > 0 && squaredReference > 0) { std::snprintf(error, sizeof(error), "%.1f", 10.0 * std::log10(squaredDifference / squaredReference)); }
+        else { std::snprintf(error, sizeof(error), "%s", squaredDifference > 0 ? "undefined" : "-inf"); }
+        std::snprintf(row, sizeof(row), "%8zu %10.4f %12.4f %10.4f %12.3f %12s %10s %12.3g %10s", numberOfSources, exactMean, bucketedMean, sharedMean,
+            1000.0 * sharedMean / numberOfSources, spectra, error, maximumDifference, identical ? "yes" : "NO");
+        std::cout << row << std::endl;
+    }
+}
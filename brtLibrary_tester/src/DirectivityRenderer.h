@@ -0,0 +1,231 @@
+/**
+*
+* \brief Model benchmark of directivity (SRTF) rendering of many sources, with the SRTF spectra of each orientation bucket shared
+* in a block. The library CSourceDirectivityModel and its SRTF convolver are not used, so the results are those of this model only
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+
+#ifndef _DIRECTIVITYRENDERER_H_
+#define _DIRECTIVITYRENDERER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <BRTLibrary.h>
+#include "FFT.h"
+
+#define DIRECTIVITY_MEASURED_STEP       30.0f       // Degrees between the orientations of the SRTF table, in azimuth and elevation
+#define DIRECTIVITY_BUCKET_STEP         5.0f        // Degrees of the orientation buckets the SRTF is evaluated at
+#define DIRECTIVITY_WARMUP_BLOCKS       20
+#define DIRECTIVITY_MEASURED_BLOCKS     200
+#define DIRECTIVITY_HEAD_TURN           20.0f       // Degrees each talker turns its head away from the listener, at most
+#define DIRECTIVITY_HEAD_TURN_PERIOD    4.0f        // Seconds of a head turn
+
+/** \brief Source directivity transfer function of a talker, tabulated at the orientations of a regular azimuth and elevation grid.
+*	Spectra are real, zero phase gains with the layout of CRealFFT for twice the block size.
+*	\details The talker is omnidirectional at low frequencies and radiates more to the front as the frequency rises, which stands
+*	for a measured SRTF: no SRTF file ships with the tester.
+*/
+class CSRTF {
+public:
+    CSRTF();
+
+    /** \brief Tabulates the talker directivity
+    *	\param [in] _blockSize block size of the sources, the spectra are for transforms of twice this size
+    *	\param [in] _sampleRate
+    *	\param [in] _measuredStep degrees between the orientations of the table
+    */
+    void Setup(size_t _blockSize, int _sampleRate, float _measuredStep);
+
+    size_t GetBlockSize() const { return blockSize; }
+
+    /** \brief Number of floats of a spectrum
+    */
+    size_t GetSpectrumSize() const { return 2 * blockSize + 2; }
+
+    /** \brief Interpolates bilinearly the spectra of the four table orientations around an orientation. Does not allocate
+    *	\param [in] _azimuth of the listener seen from the source, in degrees [0, 360)
+    *	\param [in] _elevation of the listener seen from the source, in degrees [-90, 90]
+    *	\param [out] _spectrum GetSpectrumSize() floats
+    */
+    void ComputeSpectrum(float _azimuth, float _elevation, float* _spectrum) const;
+
+private:
+    const float* GetTableSpectrum(size_t _azimuthIndex, size_t _elevationIndex) const { return table.data() + (_elevationIndex * numberOfAzimuths + _azimuthIndex) * GetSpectrumSize(); }
+
+    size_t blockSize;
+    float azimuthStep;
+    float elevationStep;
+    size_t numberOfAzimuths;
+    size_t numberOfElevations;                      // From -90 to 90 degrees
+    std::vector<float> table;                       // [elevation][azimuth][spectrum]
+};
+
+/** \brief Orientations quantized to buckets of a regular grid. The buckets cover azimuths [0, 360) and elevations [-90, 90]
+*/
+class CSRTFBuckets {
+public:
+    CSRTFBuckets();
+
+    void Setup(float _bucketStep);
+
+    size_t GetNumberOfBuckets() const { return numberOfAzimuths * numberOfElevations; }
+
+    /** \brief Bucket of an orientation
+    *	\param [in] _azimuth degrees [0, 360)
+    *	\param [in] _elevation degrees [-90, 90]
+    */
+    size_t GetBucket(float _azimuth, float _elevation) const;
+
+    /** \brief Orientation the SRTF of a bucket is evaluated at, its centre
+    */
+    void GetBucketOrientation(size_t _bucket, float& _azimuth, float& _elevation) const;
+
+private:
+    float azimuthStep;
+    float elevationStep;
+    size_t numberOfAzimuths;
+    size_t numberOfElevations;
+};
+
+/** \brief Spectra of the buckets of one SRTF used in the current block. The first source of a bucket computes its spectrum and
+*	the others of the same block reuse it. Everything is allocated in Setup.
+*/
+class CSRTFBucketCache {
+public:
+    CSRTFBucketCache();
+
+    /** \brief Allocates the spectra. The SRTF and the buckets must outlive the cache
+    *	\param [in] _srtf
+    *	\param [in] _buckets
+    *	\param [in] _maxBucketsPerBlock most buckets used in a block, the number of sources using the SRTF
+    */
+    void Setup(const CSRTF& _srtf, const CSRTFBuckets& _buckets, size_t _maxBucketsPerBlock);
+
+    /** \brief Forgets the spectra of the previous block
+    */
+    void BeginBlock();
+
+    /** \brief Returns the spectrum of a bucket, computing it if no source has used the bucket in this block. Does not allocate
+    *	\param [in] _bucket
+    */
+    const float* GetSpectrum(size_t _bucket);
+
+    /** \brief Spectra computed in the current block
+    */
+    size_t GetComputedSpectra() const { return usedSlots; }
+
+private:
+    const CSRTF* srtf;
+    const CSRTFBuckets* buckets;
+    uint32_t block;                                 // Number of the current block, never 0
+    std::vector<uint32_t> bucketBlocks;             // Block in which each bucket was computed last
+    std::vector<uint32_t> bucketSlots;              // Slot of each bucket computed in the current block
+    std::vector<float> slots;                       // [slot][spectrum]
+    size_t maxSlots;
+    size_t usedSlots;
+};
+
+/** \brief Orientation at which a source of CDirectivityRenderer gets its SRTF spectrum
+*/
+enum TDirectivitySpectra {
+    DIRECTIVITY_EXACT,                              // Each source computes the spectrum of its own orientation
+    DIRECTIVITY_BUCKETED,                           // Each source computes the spectrum of the centre of its bucket
+    DIRECTIVITY_SHARED                              // The spectrum of a bucket centre is computed once per block for all the sources of its SRTF
+};
+
+/** \brief Filters the input of each source with the SRTF of the orientation of the listener seen from it, by overlap-add with
+*	transforms of twice the block size, as the SRTF convolver of a directivity source does.
+*	\details With shared spectra, every SRTF has a CSRTFBucketCache. Bucketed and shared spectra are evaluated at the same bucket
+*	centres, so they give the same output bits; their error is that of the buckets, measured against exact spectra. The renderer
+*	is not used by the render path of the tester, which renders with the library; it is only measured by the stress test.
+*/
+class CDirectivityRenderer {
+public:
+    CDirectivityRenderer();
+
+    /** \brief Allocates the sources. The SRTFs must outlive the renderer
+    *	\param [in] _srtfs SRTFs the sources can use, of the same block size
+    *	\param [in] _numberOfSources
+    *	\param [in] _bucketStep degrees of the orientation buckets, unused with exact spectra
+    *	\param [in] _spectra orientation the spectra are computed at
+    */
+    void Setup(const std::vector<const CSRTF*>& _srtfs, size_t _numberOfSources, float _bucketStep, TDirectivitySpectra _spectra);
+
+    void SetListenerPosition(const Common::CVector3& _position) { listenerPosition = _position; }
+
+    /** \brief Sets the SRTF, position and heading of a source, which stands upright
+    *	\param [in] _source
+    *	\param [in] _srtfIndex in the SRTFs of Setup
+    *	\param [in] _position
+    *	\param [in] _facingAzimuth degrees the source faces, measured from the X axis
+    */
+    void SetSource(size_t _source, size_t _srtfIndex, const Common::CVector3& _position, float _facingAzimuth);
+
+    /** \brief Filters one block of every source. Does not allocate
+    *	\param [in] _sourceInputs block size samples of each source
+    */
+    void Process(const float* const* _sourceInputs);
+
+    const float* GetOutput(size_t _source) const { return sources[_source].output.data(); }
+
+    /** \brief SRTF spectra computed in the last block
+    */
+    size_t GetComputedSpectraPerBlock() const { return computedSpectra; }
+
+private:
+    struct TSource {
+        size_t srtfIndex = 0;
+        Common::CVector3 position;
+        float facingAzimuth = 0;
+        std::vector<float> overlap;                 // Tail of the previous blocks
+        std::vector<float> output;
+    };
+
+    std::vector<const CSRTF*> srtfs;
+    CSRTFBuckets buckets;
+    std::vector<CSRTFBucketCache> caches;           // One per SRTF, empty without shared spectra
+    TDirectivitySpectra spectraMode;
+    size_t blockSize;
+    std::unique_ptr<CRealFFT> fft;
+    Common::CVector3 listenerPosition;
+    std::vector<TSource> sources;
+    std::vector<float> padded;
+    std::vector<float> spectrum;
+    std::vector<float> filtered;
+    std::vector<float> sourceSRTF;                  // Spectrum of a source, without shared spectra
+    std::vector<float> result;
+    size_t computedSpectra;
+};
+
+/** \brief Renders 1 to _numberOfSources talkers facing the listener and turning their heads, all with the same SRTF, through
+*	CDirectivityRenderer with exact, bucketed and shared spectra. Prints the block time of each, the time per source with shared
+*	spectra, the spectra computed per block, the error of the shared output against the exact one and whether the bucketed and
+*	shared outputs match
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _numberOfSources
+*	\param [in] _blockSize
+*	\param [in] _sampleRate
+*/
+void RunDirectivityStressTest(const std::vector<float>& _sourceSamples, size_t _numberOfSources, size_t _blockSize, int _sampleRate);
+
+#endif
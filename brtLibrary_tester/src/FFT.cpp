@@ -0,0 +1,71 @@
+/**
+*
+* \brief Real-input FFT of power of two sizes, for the partitioned convolvers
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "FFT.h"
+#include <cmath>
+
+namespace {
+    const double PI = 3.14159265358979323846;
+}
+
+CRealFFT::CRealFFT(size_t _size) : size(_size), kernels(&GetFixedSizeKernels(_size / 2)), work(_size + 2)
+{
+    size_t half = size / 2;
+    for (size_t length = 2; length <= half; length <<= 1) {
+        for (size_t k = 0; k < length / 2; k++) {                       // The values the stage used to read every half / length twiddles
+            stageTwiddles.push_back((float)std::cos(2 * PI * (k * (half / length)) / half));
+            stageTwiddles.push_back((float)-std::sin(2 * PI * (k * (half / length)) / half));
+        }
+    }
+    for (size_t k = 0; k <= half; k++) {
+        realTwiddles.push_back((float)std::cos(2 * PI * k / size));
+        realTwiddles.push_back((float)-std::sin(2 * PI * k / size));
+    }
+    for (size_t i = 0, j = 0; i < half; i++) {
+        if (i < j) { bitReversal.push_back(i); bitReversal.push_back(j); }
+        size_t bit = half >> 1;
+        for (; bit > 0 && (j & bit); bit >>= 1) { j ^= bit; }
+        j |= bit;
+    }
+}
+
+TRealFFTTables CRealFFT::GetTables() const
+{
+    return { size, stageTwiddles.data(), realTwiddles.data(), bitReversal.data(), bitReversal.size() };
+}
+
+void CRealFFT::Forward(const float* _input, float* _spectrum)
+{
+    kernels->RealForward(GetTables(), _input, _spectrum, work.data());
+}
+
+void CRealFFT::Inverse(const float* _spectrum, float* _output)
+{
+    kernels->RealInverse(GetTables(), _spectrum, _output, work.data());
+}
+
+void ComplexMultiplyAccumulate(const float* _a, const float* _b, float* _accumulator, size_t _bins)
+{
+    GetGenericKernels().ComplexMultiplyAccumulate(_a, _b, _accumulator, _bins);
+}
@@ -0,0 +1,84 @@
+/**
+*
+* \brief Real-input FFT of power of two sizes, for the partitioned convolvers
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#ifndef _FFT_H_
+#define _FFT_H_
+
+#include <cstddef>
+#include <vector>
+#include "FixedSizeKernels.h"
+
+/** \brief FFT of real signals, computed as a complex FFT of half the size. Tables are computed in the constructor, so transforms
+*	do not allocate. Spectra hold bins 0 to size / 2 as interleaved real and imaginary parts (size + 2 floats).
+*	An instance keeps a work buffer, so it must not be shared by threads. The transforms of 256 to 8192 samples run the kernels
+*	compiled for that size, chosen in the constructor.
+*/
+class CRealFFT {
+public:
+    /** \brief Prepares the transforms and selects their kernels
+    *	\param [in] _size number of real samples, a power of two, at least 4
+    */
+    CRealFFT(size_t _size);
+
+    size_t GetSize() const { return size; }
+
+    /** \brief Kernels of the block size this transform is used with, half its size
+    */
+    const TFixedSizeKernels& GetKernels() const { return *kernels; }
+
+    /** \brief Number of floats of a spectrum
+    */
+    size_t GetSpectrumSize() const { return size + 2; }
+
+    /** \brief Forward transform, not scaled
+    *	\param [in] _input size samples
+    *	\param [out] _spectrum size + 2 floats
+    */
+    void Forward(const float* _input, float* _spectrum);
+
+    /** \brief Inverse transform, scaled by 1 / size so Inverse(Forward(x)) = x
+    *	\param [in] _spectrum size + 2 floats
+    *	\param [out] _output size samples
+    */
+    void Inverse(const float* _spectrum, float* _output);
+
+private:
+    TRealFFTTables GetTables() const;
+
+    size_t size;
+    const TFixedSizeKernels* kernels;
+    std::vector<float> stageTwiddles;               // e^(-2 pi i k / length), k < length / 2, of each butterfly length, the shortest first
+    std::vector<float> realTwiddles;                // e^(-2 pi i k / size), k <= size / 2
+    std::vector<size_t> bitReversal;                // Pairs of indices swapped by the permutation
+    std::vector<float> work;
+};
+
+/** \brief Multiplies two spectra bin by bin and adds the result
+*	\param [in] _a
+*	\param [in] _b
+*	\param [in,out] _accumulator
+*	\param [in] _bins number of complex bins
+*/
+void ComplexMultiplyAccumulate(const float* _a, const float* _b, float* _accumulator, size_t _bins);
+
+#endif
@@ -0,0 +1,193 @@
+/**
+*
+* \brief Processing kernels compiled for each power of two block size, chosen once at setup
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "FixedSizeKernels.h"
+#include <atomic>
+#include <utility>
+
+#if defined(_MSC_VER)
+    #define FIXED_SIZE_RESTRICT __restrict
+#else
+    #define FIXED_SIZE_RESTRICT __restrict__
+#endif
+
+namespace {
+    std::atomic<bool> fixedSizeKernelsEnabled(true);
+
+    // Every kernel is written once, for a block size BLOCK known at compile time; BLOCK = 0 takes it from the arguments instead
+
+    /// One radix 2 stage of the complex FFT, over butterflies _length points apart
+    template <size_t HALF, size_t LENGTH>
+    inline void ComplexFFTStage(const float* _twiddles, float* _data, size_t _half, size_t _length) {
+        const size_t half = HALF != 0 ? HALF : _half;
+        const size_t length = LENGTH != 0 ? LENGTH : _length;
+        const float* twiddles = _twiddles + length - 2;               // Twiddles of the stage, contiguous
+        for (size_t start = 0; start < half; start += length) {
+            for (size_t k = 0; k < length / 2; k++) {
+                float wr = twiddles[2 * k];
+                float wi = twiddles[2 * k + 1];
+                float* a = _data + 2 * (start + k);
+                float* b = _data + 2 * (start + k + length / 2);
+                float br = b[0] * wr - b[1] * wi;
+                float bi = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - br;
+                b[1] = a[1] - bi;
+                a[0] += br;
+                a[1] += bi;
+            }
+        }
+    }
+
+    /// Stages from LENGTH to HALF, unrolled at compile time
+    template <size_t HALF, size_t LENGTH, bool DONE = (LENGTH > HALF)>
+    struct TComplexFFTStages {
+        static void Run(const float* _twiddles, float* _data) {
+            ComplexFFTStage<HALF, LENGTH>(_twiddles, _data, HALF, LENGTH);
+            TComplexFFTStages<HALF, 2 * LENGTH>::Run(_twiddles, _data);
+        }
+    };
+
+    template <size_t HALF, size_t LENGTH>
+    struct TComplexFFTStages<HALF, LENGTH, true> {
+        static void Run(const float*, float*) {}
+    };
+
+    /// In place complex FFT of size / 2 points, interleaved, forward (e^-i) direction
+    template <size_t BLOCK>
+    void ComplexFFT(const TRealFFTTables& _tables, float* _data) {
+        const size_t half = BLOCK != 0 ? BLOCK : _tables.size / 2;
+        for (size_t p = 0; p < _tables.bitReversalLength; p += 2) {
+            std::swap(_data[2 * _tables.bitReversal[p]], _data[2 * _tables.bitReversal[p + 1]]);
+            std::swap(_data[2 * _tables.bitReversal[p] + 1], _data[2 * _tables.bitReversal[p + 1] + 1]);
+        }
+        if (BLOCK != 0) {
+            TComplexFFTStages<BLOCK, 2>::Run(_tables.stageTwiddles, _data);
+            return;
+        }
+        for (size_t length = 2; length <= half; length <<= 1) { ComplexFFTStage<0, 0>(_tables.stageTwiddles, _data, half, length); }
+    }
+
+    template <size_t BLOCK>
+    void RealForward(const TRealFFTTables& _tables, const float* _input, float* _spectrum, float* _work) {
+        // Even samples as real parts and odd samples as imaginary parts of a half size complex signal
+        const size_t size = BLOCK != 0 ? 2 * BLOCK : _tables.size;
+        const size_t half = size / 2;
+        for (size_t i = 0; i < size; i++) { _work[i] = _input[i]; }
+        ComplexFFT<BLOCK>(_tables, _work);
+
+        // X[k] = E[k] + W^k O[k], with E and O the spectra of the even and odd samples
+        for (size_t k = 0; k <= half; k++) {
+            size_t a = (k == half) ? 0 : k;
+            size_t b = (k == 0) ? 0 : half - k;
+            float zr = _work[2 * a], zi = _work[2 * a + 1];
+            float cr = _work[2 * b], ci = -_work[2 * b + 1];                // conj(Z[half - k])
+            float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+            float or_ = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);           // (Z[k] - conj(Z[half - k])) / 2i
+            float wr = _tables.realTwiddles[2 * k], wi = _tables.realTwiddles[2 * k + 1];
+            _spectrum[2 * k] = er + wr * or_ - wi * oi;
+            _spectrum[2 * k + 1] = ei + wr * oi + wi * or_;
+        }
+    }
+
+    template <size_t BLOCK>
+    void RealInverse(const TRealFFTTables& _tables, const float* _spectrum, float* _output, float* _work) {
+        // Back to Z[k] = E[k] + i O[k], then an inverse complex FFT computed as conj(FFT(conj(Z)))
+        const size_t half = BLOCK != 0 ? BLOCK : _tables.size / 2;
+        for (size_t k = 0; k < half; k++) {
+            float xr = _spectrum[2 * k], xi = _spectrum[2 * k + 1];
+            float cr = _spectrum[2 * (half - k)], ci = -_spectrum[2 * (half - k) + 1];     // conj(X[half - k])
+            float er = 0.5f * (xr + cr), ei = 0.5f * (xi + ci);
+            float dr = 0.5f * (xr - cr), di = 0.5f * (xi - ci);            // W^k O[k]
+            float wr = _tables.realTwiddles[2 * k], wi = -_tables.realTwiddles[2 * k + 1];  // conj(W^k)
+            float or_ = dr * wr - di * wi, oi = dr * wi + di * wr;
+            _work[2 * k] = er - oi;                                         // E + i O, conjugated
+            _work[2 * k + 1] = -(ei + or_);
+        }
+        ComplexFFT<BLOCK>(_tables, _work);
+        float scale = 1.0f / half;
+        for (size_t k = 0; k < half; k++) {
+            _output[2 * k] = _work[2 * k] * scale;
+            _output[2 * k + 1] = -_work[2 * k + 1] * scale;
+        }
+    }
+
+    template <size_t BLOCK>
+    void ComplexMultiplyAccumulate(const float* FIXED_SIZE_RESTRICT _a, const float* FIXED_SIZE_RESTRICT _b, float* FIXED_SIZE_RESTRICT _accumulator, size_t _bins) {
+        const size_t bins = BLOCK != 0 ? BLOCK + 1 : _bins;
+        for (size_t i = 0; i < bins; i++) {
+            float ar = _a[2 * i], ai = _a[2 * i + 1];
+            float br = _b[2 * i], bi = _b[2 * i + 1];
+            _accumulator[2 * i] += ar * br - ai * bi;
+            _accumulator[2 * i + 1] += ar * bi + ai * br;
+        }
+    }
+
+    template <size_t BLOCK>
+    void Crossfade(const float* FIXED_SIZE_RESTRICT _old, const float* FIXED_SIZE_RESTRICT _new, const float* FIXED_SIZE_RESTRICT _fadeIn, float* FIXED_SIZE_RESTRICT _output, size_t _count) {
+        const size_t count = BLOCK != 0 ? BLOCK : _count;
+        for (size_t i = 0; i < count; i++) { _output[i] = _old[i] + _fadeIn[i] * (_new[i] - _old[i]); }
+    }
+
+    template <size_t BLOCK>
+    void Accumulate(float* FIXED_SIZE_RESTRICT _buffer, const float* FIXED_SIZE_RESTRICT _input, size_t _count) {
+        const size_t count = BLOCK != 0 ? BLOCK : _count;
+        for (size_t i = 0; i < count; i++) { _buffer[i] += _input[i]; }
+    }
+
+    template <size_t BLOCK>
+    TFixedSizeKernels MakeKernels() {
+        return { BLOCK, RealForward<BLOCK>, RealInverse<BLOCK>, ComplexMultiplyAccumulate<BLOCK>, Crossfade<BLOCK>, Accumulate<BLOCK> };
+    }
+
+    // Dispatch table, indexed by log2(block size / FIXED_SIZE_KERNELS_MIN_BLOCK)
+    const TFixedSizeKernels genericKernels = MakeKernels<0>();
+    const TFixedSizeKernels fixedSizeKernels[] = { MakeKernels<128>(), MakeKernels<256>(), MakeKernels<512>(), MakeKernels<1024>(), MakeKernels<2048>(), MakeKernels<4096>() };
+    static_assert(sizeof(fixedSizeKernels) / sizeof(fixedSizeKernels[0]) == 6 && FIXED_SIZE_KERNELS_MIN_BLOCK << 5 == FIXED_SIZE_KERNELS_MAX_BLOCK,
+        "The dispatch table must have one entry per power of two block size");
+}
+
+const TFixedSizeKernels& GetFixedSizeKernels(size_t _blockSize)
+{
+    if (!fixedSizeKernelsEnabled.load(std::memory_order_relaxed)) { return genericKernels; }
+    size_t index = 0;
+    for (size_t blockSize = FIXED_SIZE_KERNELS_MIN_BLOCK; blockSize <= FIXED_SIZE_KERNELS_MAX_BLOCK; blockSize <<= 1, index++) {
+        if (blockSize == _blockSize) { return fixedSizeKernels[index]; }
+    }
+    return genericKernels;
+}
+
+const TFixedSizeKernels& GetGenericKernels()
+{
+    return genericKernels;
+}
+
+void SetFixedSizeKernelsEnabled(bool _enabled)
+{
+    fixedSizeKernelsEnabled.store(_enabled, std::memory_order_relaxed);
+}
+
+bool AreFixedSizeKernelsEnabled()
+{
+    return fixedSizeKernelsEnabled.load(std::memory_order_relaxed);
+}
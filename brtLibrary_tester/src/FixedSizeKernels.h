@@ -0,0 +1,77 @@
+/**
+*
+* \brief Processing kernels compiled for each power of two block size, chosen once at setup. Prototype only: they serve the
+* tester FFT and partitioned convolvers, not the library fftsg, convolvers or CMonoBuffer the render path runs
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _FIXEDSIZEKERNELS_H_
+#define _FIXEDSIZEKERNELS_H_
+
+#include <cstddef>
+
+#define FIXED_SIZE_KERNELS_MIN_BLOCK    128         // Smallest block size with its own kernels
+#define FIXED_SIZE_KERNELS_MAX_BLOCK    4096        // Largest block size with its own kernels
+
+/** \brief Tables of a real FFT of size samples, as CRealFFT computes them
+*/
+struct TRealFFTTables {
+    size_t size;
+    const float* stageTwiddles;                     // e^(-2 pi i k / length), k < length / 2, for each stage length 2 to size / 2, from float length - 2
+    const float* realTwiddles;                      // e^(-2 pi i k / size), k <= size / 2
+    const size_t* bitReversal;                      // Pairs of indices swapped by the permutation
+    size_t bitReversalLength;                       // Indices in bitReversal, twice the number of swaps
+};
+
+/** \brief Kernels of the block processing of the convolvers for one block size. The FFTs transform two blocks (size = 2 blockSize),
+*	spectra have blockSize + 1 bins and buffers blockSize samples. The kernels of a supported block size are the same code as the
+*	generic ones, instantiated with the size as a compile-time constant so loops have known trip counts and can be unrolled and
+*	vectorised; they give bit-identical results. Size arguments are ignored by them.
+*	Only CRealFFT and the tester convolvers dispatch through them; the library render path is not affected.
+*/
+struct TFixedSizeKernels {
+    size_t blockSize;                               // 0 for the generic kernels
+    void (*RealForward)(const TRealFFTTables& _tables, const float* _input, float* _spectrum, float* _work);
+    void (*RealInverse)(const TRealFFTTables& _tables, const float* _spectrum, float* _output, float* _work);
+    void (*ComplexMultiplyAccumulate)(const float* _a, const float* _b, float* _accumulator, size_t _bins);
+    void (*Crossfade)(const float* _old, const float* _new, const float* _fadeIn, float* _output, size_t _count);  // old + fadeIn (new - old)
+    void (*Accumulate)(float* _buffer, const float* _input, size_t _count);                                        // _buffer += _input
+};
+
+/** \brief Returns the kernels of a block size, looked up in the dispatch table. Meant to be called at setup, not per block
+*	\param [in] _blockSize
+*	\retval the generic kernels if the size is not a power of two from FIXED_SIZE_KERNELS_MIN_BLOCK to FIXED_SIZE_KERNELS_MAX_BLOCK,
+*	or if the fixed size kernels are disabled
+*/
+const TFixedSizeKernels& GetFixedSizeKernels(size_t _blockSize);
+
+/** \brief Returns the kernels that take the size at run time
+*/
+const TFixedSizeKernels& GetGenericKernels();
+
+/** \brief Enables or disables the fixed size kernels for the objects set up from then on, to compare both. Enabled by default
+*	\param [in] _enabled
+*/
+void SetFixedSizeKernelsEnabled(bool _enabled);
+
+bool AreFixedSizeKernelsEnabled();
+
+#endif
@@ -0,0 +1,244 @@
+/**
+*
+* \brief Offline resampling of an HRTF table to a regular grid, spread over a pool of threads
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "GridResampler.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+    const double PI = 3.14159265358979323846;
+    const double SAME_ORIENTATION_COSINE = 0.99999999;        // About 0.008 degrees
+    const double BARYCENTRIC_TOLERANCE = -1e-9;
+
+    int GetDefaultNumberOfThreads(int _numberOfThreads) {
+        if (_numberOfThreads > 0) { return _numberOfThreads; }
+        unsigned int numberOfCores = std::thread::hardware_concurrency();
+        return numberOfCores == 0 ? 1 : (int)numberOfCores;
+    }
+
+    void ToUnitVector(double _azimuth, double _elevation, double& _x, double& _y, double& _z) {
+        double azimuth = _azimuth * PI / 180.0;
+        double elevation = _elevation * PI / 180.0;
+        _x = std::cos(azimuth) * std::cos(elevation);
+        _y = std::sin(azimuth) * std::cos(elevation);
+        _z = std::sin(elevation);
+    }
+
+    double Determinant(const double* _a, const double* _b, const double* _c) {
+        return _a[0] * (_b[1] * _c[2] - _b[2] * _c[1]) - _a[1] * (_b[0] * _c[2] - _b[2] * _c[0]) + _a[2] * (_b[0] * _c[1] - _b[1] * _c[0]);
+    }
+}
+
+TGridExtrapolation GetGridExtrapolation(const std::string& _extrapolationMethod)
+{
+    return _extrapolationMethod == "Zero" ? GRID_EXTRAPOLATION_ZERO : GRID_EXTRAPOLATION_NEAREST_POINT;
+}
+
+CGridResampler::CGridResampler(int _numberOfThreads) : workerPool(GetDefaultNumberOfThreads(_numberOfThreads), false), hrirLength(0),
+    extrapolation(GRID_EXTRAPOLATION_NEAREST_POINT)
+{
+}
+
+std::vector<BRTServices::orientation> CGridResampler::CreateGrid(float _resamplingStep)
+{
+    std::vector<BRTServices::orientation> grid;
+    int numberOfElevations = std::max(2, (int)std::round(180.0 / _resamplingStep) + 1);      // Both poles included
+    double elevationStep = 180.0 / (numberOfElevations - 1);
+    for (int e = 0; e < numberOfElevations; e++) {
+        double elevation = -90.0 + e * elevationStep;
+        int numberOfAzimuths = std::max(1, (int)std::round(360.0 * std::cos(elevation * PI / 180.0) / _resamplingStep));
+        if (e == 0 || e == numberOfElevations - 1) { numberOfAzimuths = 1; }
+        double azimuthStep = 360.0 / numberOfAzimuths;
+        for (int a = 0; a < numberOfAzimuths; a++) {
+            grid.push_back(BRTServices::orientation(a * azimuthStep, elevation < 0 ? elevation + 360.0 : elevation));
+        }
+    }
+    return grid;
+}
+
+bool CGridResampler::Resample(const BRTServices::T_HRTFTable& _rawTable, float _resamplingStep, TResampledGrid& _grid, TGridExtrapolation _extrapolation)
+{
+    if (!Prepare(_rawTable, _extrapolation)) { return false; }
+
+    _grid.orientations = CreateGrid(_resamplingStep);
+    _grid.hrirs.assign(_grid.orientations.size(), BRTServices::THRIRStruct());
+
+    TResampleJob job;
+    job.resampler = this;
+    job.grid = &_grid;
+    size_t numberOfTasks = (_grid.orientations.size() + GRID_RESAMPLER_POINTS_PER_TASK - 1) / GRID_RESAMPLER_POINTS_PER_TASK;
+    for (job.firstTask = 0; job.firstTask < numberOfTasks; job.firstTask += 0xFFFF) {      // The pool takes up to 65535 tasks per run
+        workerPool.Run((int)std::min<size_t>(0xFFFF, numberOfTasks - job.firstTask), &CGridResampler::ResampleTask, &job);
+    }
+    return true;
+}
+
+bool CGridResampler::Prepare(const BRTServices::T_HRTFTable& _rawTable, TGridExtrapolation _extrapolation)
+{
+    extrapolation = _extrapolation;
+    measured.clear();
+    if (_rawTable.empty()) { return false; }
+
+    // Measured HRIRs sorted by orientation, so the search order does not depend on the hash table layout
+    std::vector<std::pair<BRTServices::orientation, const BRTServices::THRIRStruct*>> sorted;
+    sorted.reserve(_rawTable.size());
+    for (auto it = _rawTable.begin(); it != _rawTable.end(); it++) { sorted.push_back(std::make_pair(it->first, &it->second)); }
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<BRTServices::orientation, const BRTServices::THRIRStruct*>& _a, const std::pair<BRTServices::orientation, const BRTServices::THRIRStruct*>& _b) {
+        return _a.first.azimuth < _b.first.azimuth || (_a.first.azimuth == _b.first.azimuth && _a.first.elevation < _b.first.elevation);
+    });
+    measured.resize(sorted.size());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        ToUnitVector(sorted[i].first.azimuth, sorted[i].first.elevation, measured[i].x, measured[i].y, measured[i].z);
+        measured[i].hrir = sorted[i].second;
+    }
+    hrirLength = sorted[0].second->leftHRIR.size();
+    return true;
+}
+
+void CGridResampler::ResampleTask(void* _job, int _taskIndex)
+{
+    const TResampleJob& job = *static_cast<const TResampleJob*>(_job);
+    size_t first = (job.firstTask + _taskIndex) * GRID_RESAMPLER_POINTS_PER_TASK;
+    size_t last = std::min(first + GRID_RESAMPLER_POINTS_PER_TASK, job.grid->orientations.size());
+    for (size_t point = first; point < last; point++) { job.resampler->ResamplePoint(job.grid->orientations[point], job.grid->hrirs[point]); }
+}
+
+size_t CGridResampler::FindNeighbours(const double* _point, size_t* _neighbours, double* _cosines) const
+{
+    // Nearest measured HRIRs, by decreasing cosine of the angle to the grid point. Ties keep the sorted table order
+    size_t numberOfNeighbours = 0;
+    for (size_t i = 0; i < measured.size(); i++) {
+        double cosine = measured[i].x * _point[0] + measured[i].y * _point[1] + measured[i].z * _point[2];
+        if (numberOfNeighbours == GRID_RESAMPLER_NEIGHBOURS && cosine <= _cosines[numberOfNeighbours - 1]) { continue; }
+        size_t position = (numberOfNeighbours < GRID_RESAMPLER_NEIGHBOURS) ? numberOfNeighbours++ : numberOfNeighbours - 1;
+        while (position > 0 && _cosines[position - 1] < cosine) {
+            _cosines[position] = _cosines[position - 1];
+            _neighbours[position] = _neighbours[position - 1];
+            position--;
+        }
+        _cosines[position] = cosine;
+        _neighbours[position] = i;
+    }
+    return numberOfNeighbours;
+}
+
+bool CGridResampler::FindSmallestTriangle(const double* _point, const size_t* _neighbours, size_t _numberOfNeighbours, size_t* _vertices, double* _weights) const
+{
+    // Smallest triangle of neighbours whose cone contains the grid point: point = wa A + wb B + wc C with all w >= 0. Triangles
+    // are compared by perimeter (sum of chords); on a tie the first one, nearest vertices first, is kept
+    double bestPerimeter = 0;
+    for (size_t a = 0; a < _numberOfNeighbours; a++) {
+        for (size_t b = a + 1; b < _numberOfNeighbours; b++) {
+            for (size_t c = b + 1; c < _numberOfNeighbours; c++) {
+                const TMeasuredHRIR& ma = measured[_neighbours[a]];
+                const TMeasuredHRIR& mb = measured[_neighbours[b]];
+                const TMeasuredHRIR& mc = measured[_neighbours[c]];
+                double va[3] = { ma.x, ma.y, ma.z }, vb[3] = { mb.x, mb.y, mb.z }, vc[3] = { mc.x, mc.y, mc.z };
+                double determinant = Determinant(va, vb, vc);
+                if (std::fabs(determinant) < 1e-12) { continue; }
+                double wa = Determinant(_point, vb, vc) / determinant;
+                double wb = Determinant(va, _point, vc) / determinant;
+                double wc = Determinant(va, vb, _point) / determinant;
+                if (wa < BARYCENTRIC_TOLERANCE || wb < BARYCENTRIC_TOLERANCE || wc < BARYCENTRIC_TOLERANCE) { continue; }
+                double perimeter = std::sqrt((va[0] - vb[0]) * (va[0] - vb[0]) + (va[1] - vb[1]) * (va[1] - vb[1]) + (va[2] - vb[2]) * (va[2] - vb[2]))
+                    + std::sqrt((vb[0] - vc[0]) * (vb[0] - vc[0]) + (vb[1] - vc[1]) * (vb[1] - vc[1]) + (vb[2] - vc[2]) * (vb[2] - vc[2]))
+                    + std::sqrt((vc[0] - va[0]) * (vc[0] - va[0]) + (vc[1] - va[1]) * (vc[1] - va[1]) + (vc[2] - va[2]) * (vc[2] - va[2]));
+                if (bestPerimeter > 0 && perimeter >= bestPerimeter) { continue; }
+                bestPerimeter = perimeter;
+                _vertices[0] = _neighbours[a];
+                _vertices[1] = _neighbours[b];
+                _vertices[2] = _neighbours[c];
+                _weights[0] = wa;
+                _weights[1] = wb;
+                _weights[2] = wc;
+            }
+        }
+    }
+    return bestPerimeter > 0;
+}
+
+TGridPointKind CGridResampler::ClassifyPoint(const BRTServices::orientation& _orientation) const
+{
+    double point[3];
+    ToUnitVector(_orientation.azimuth, _orientation.elevation, point[0], point[1], point[2]);
+    size_t neighbours[GRID_RESAMPLER_NEIGHBOURS];
+    double cosines[GRID_RESAMPLER_NEIGHBOURS];
+    size_t numberOfNeighbours = FindNeighbours(point, neighbours, cosines);
+    if (numberOfNeighbours == 0) { return GRID_POINT_EXTRAPOLATED; }
+    if (cosines[0] >= SAME_ORIENTATION_COSINE) { return GRID_POINT_MEASURED; }
+    size_t vertices[3];
+    double weights[3];
+    return FindSmallestTriangle(point, neighbours, numberOfNeighbours, vertices, weights) ? GRID_POINT_INTERPOLATED : GRID_POINT_EXTRAPOLATED;
+}
+
+void CGridResampler::ResamplePoint(const BRTServices::orientation& _orientation, BRTServices::THRIRStruct& _hrir) const
+{
+    double point[3];
+    ToUnitVector(_orientation.azimuth, _orientation.elevation, point[0], point[1], point[2]);
+    size_t neighbours[GRID_RESAMPLER_NEIGHBOURS];
+    double cosines[GRID_RESAMPLER_NEIGHBOURS];
+    size_t numberOfNeighbours = FindNeighbours(point, neighbours, cosines);
+
+    BRTServices::THRIRStruct& output = _hrir;
+    if (cosines[0] >= SAME_ORIENTATION_COSINE) {
+        output = *measured[neighbours[0]].hrir;
+        return;
+    }
+    size_t bestVertices[3];
+    double bestWeights[3];
+    if (!FindSmallestTriangle(point, neighbours, numberOfNeighbours, bestVertices, bestWeights)) {
+        Extrapolate(neighbours[0], output);
+        return;
+    }
+
+    double sum = bestWeights[0] + bestWeights[1] + bestWeights[2];
+    float weights[3] = { (float)(bestWeights[0] / sum), (float)(bestWeights[1] / sum), (float)(bestWeights[2] / sum) };
+    output.leftHRIR.assign(hrirLength, 0.0f);
+    output.rightHRIR.assign(hrirLength, 0.0f);
+    double leftDelay = 0, rightDelay = 0;
+    for (int v = 0; v < 3; v++) {
+        const BRTServices::THRIRStruct* hrir = measured[bestVertices[v]].hrir;
+        for (size_t s = 0; s < hrirLength; s++) {
+            output.leftHRIR[s] += weights[v] * hrir->leftHRIR[s];
+            output.rightHRIR[s] += weights[v] * hrir->rightHRIR[s];
+        }
+        leftDelay += weights[v] * (double)hrir->leftDelay;
+        rightDelay += weights[v] * (double)hrir->rightDelay;
+    }
+    output.leftDelay = (uint64_t)std::round(leftDelay);
+    output.rightDelay = (uint64_t)std::round(rightDelay);
+}
+
+void CGridResampler::Extrapolate(size_t _nearest, BRTServices::THRIRStruct& _hrir) const
+{
+    if (extrapolation == GRID_EXTRAPOLATION_NEAREST_POINT) {
+        _hrir = *measured[_nearest].hrir;
+        return;
+    }
+    _hrir.leftHRIR.assign(hrirLength, 0.0f);
+    _hrir.rightHRIR.assign(hrirLength, 0.0f);
+    _hrir.leftDelay = 0;
+    _hrir.rightDelay = 0;
+}
@@ -0,0 +1,141 @@
+/**
+*
+* \brief Offline resampling of an HRTF table to a regular grid, spread over a pool of threads
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#ifndef _GRIDRESAMPLER_H_
+#define _GRIDRESAMPLER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <BRTLibrary.h>
+#include "RealTimeWorkerPool.hpp"
+
+#define GRID_RESAMPLER_POINTS_PER_TASK      64          // Grid points computed by each task of the worker pool
+#define GRID_RESAMPLER_NEIGHBOURS           8           // Nearest measured HRIRs searched for an enclosing triangle
+
+/** \brief How grid points outside the measured coverage (not enclosed by any triangle of measured HRIRs) are filled
+*/
+enum TGridExtrapolation {
+    GRID_EXTRAPOLATION_NEAREST_POINT,                       // HRIR of the nearest measured point
+    GRID_EXTRAPOLATION_ZERO                                 // Silent HRIR, zero delays
+};
+
+/** \brief How a grid point is computed from the measured HRIRs
+*/
+enum TGridPointKind {
+    GRID_POINT_MEASURED,                                    // Copied from the measured HRIR at the same orientation
+    GRID_POINT_INTERPOLATED,                                // Weighted from an enclosing triangle of measured HRIRs
+    GRID_POINT_EXTRAPOLATED                                 // Outside the measured coverage, filled with the extrapolation method
+};
+
+/** \brief Extrapolation of an HRTF extrapolation method name, "Zero" or "NearestPoint"
+*/
+TGridExtrapolation GetGridExtrapolation(const std::string& _extrapolationMethod);
+
+/** \brief HRIRs of a grid, in grid order
+*/
+struct TResampledGrid {
+    std::vector<BRTServices::orientation> orientations;
+    std::vector<BRTServices::THRIRStruct> hrirs;            // hrirs[i] belongs to orientations[i]
+};
+
+/** \brief Resamples the HRIR table read from a SOFA file to a quasi-uniform grid: rings of constant elevation every resampling
+*	step, each one with round(360 cos(elevation) / step) equally spaced azimuths. Grid points that were measured are copied; the
+*	others are interpolated with spherical barycentric weights from the smallest triangle (shortest perimeter) of measured HRIRs,
+*	among the GRID_RESAMPLER_NEIGHBOURS nearest, that encloses them. Points no triangle encloses are outside the measured
+*	coverage and are extrapolated with the method given to Prepare.
+*	\details Grid points are split in tasks run by a CRealTimeWorkerPool. Every point is computed by one thread only, from the same
+*	inputs and in the same operation order, and written to its own slot of the result, so the result is bit-identical whatever
+*	the number of threads.
+*	This is not the offline interpolation of the library and does not replace it: its grid is not the one CHRTF::EndSetup builds,
+*	and HRTFs are still loaded with the serial ReadHRTFFromSofa. It only serves the HRTF storage report and the HRTF benchmark.
+*/
+class CGridResampler {
+public:
+    /** \brief Spawns the worker threads
+    *	\param [in] _numberOfThreads threads computing the grid, the calling one included. 0 uses every core
+    */
+    CGridResampler(int _numberOfThreads);
+
+    int GetNumberOfThreads() const { return workerPool.GetNumberOfThreads(); }
+
+    /** \brief Computes every point of the grid
+    *	\param [in] _rawTable measured HRIRs, all with the same length
+    *	\param [in] _resamplingStep degrees
+    *	\param [out] _grid
+    *	\param [in] _extrapolation of the points outside the measured coverage
+    *	\retval false if the table is empty
+    */
+    bool Resample(const BRTServices::T_HRTFTable& _rawTable, float _resamplingStep, TResampledGrid& _grid, TGridExtrapolation _extrapolation = GRID_EXTRAPOLATION_NEAREST_POINT);
+
+    /** \brief Prepares the measured HRIRs of a table to compute grid points one by one with ResamplePoint. Resample does it too
+    *	\param [in] _rawTable measured HRIRs, all with the same length. It must outlive the calls to ResamplePoint
+    *	\param [in] _extrapolation of the points outside the measured coverage
+    *	\retval false if the table is empty
+    */
+    bool Prepare(const BRTServices::T_HRTFTable& _rawTable, TGridExtrapolation _extrapolation = GRID_EXTRAPOLATION_NEAREST_POINT);
+
+    /** \brief Computes one grid point from the prepared table, with the same result as Resample. Several threads may call it at once
+    *	\param [in] _orientation
+    *	\param [out] _hrir
+    */
+    void ResamplePoint(const BRTServices::orientation& _orientation, BRTServices::THRIRStruct& _hrir) const;
+
+    /** \brief Tells how ResamplePoint computes a grid point from the prepared table, without computing it
+    *	\param [in] _orientation
+    */
+    TGridPointKind ClassifyPoint(const BRTServices::orientation& _orientation) const;
+
+    /** \brief Orientations of the grid, with elevations from 0 to 90 and from 270 to 360 degrees as in the HRTF tables
+    *	\param [in] _resamplingStep degrees
+    */
+    static std::vector<BRTServices::orientation> CreateGrid(float _resamplingStep);
+
+private:
+    struct TMeasuredHRIR {
+        double x, y, z;                                      // Unit vector of the orientation
+        const BRTServices::THRIRStruct* hrir;
+    };
+
+    struct TResampleJob {
+        const CGridResampler* resampler;
+        TResampledGrid* grid;
+        size_t firstTask;                                    // Task index 0 of the current run of the pool
+    };
+
+    static void ResampleTask(void* _job, int _taskIndex);
+
+    /// Keeps the GRID_RESAMPLER_NEIGHBOURS (or fewer) nearest measured HRIRs of a unit vector, nearest first, and returns how many
+    size_t FindNeighbours(const double* _point, size_t* _neighbours, double* _cosines) const;
+    /// Smallest triangle of neighbours that encloses a unit vector, and its barycentric weights. False if none does
+    bool FindSmallestTriangle(const double* _point, const size_t* _neighbours, size_t _numberOfNeighbours, size_t* _vertices, double* _weights) const;
+    /// Fills a point outside the measured coverage
+    void Extrapolate(size_t _nearest, BRTServices::THRIRStruct& _hrir) const;
+
+    CRealTimeWorkerPool workerPool;
+    std::vector<TMeasuredHRIR> measured;                     // Prepared table, sorted by orientation
+    size_t hrirLength;
+    TGridExtrapolation extrapolation;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/**
+*
+* \brief Resident set of HRTFs, partitioned for convolution, selected by index in constant time
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "HRTFBank.h"
+
+CHRTFBank::CHRTFBank() : blockSize(0), storage(SPECTRUM_STORAGE_FLOAT32), entries(HRTF_BANK_CAPACITY), numberOfHRTFs(0), maxPartitions(0)
+{
+}
+
+void CHRTFBank::Setup(size_t _blockSize, TSpectrumStorage _storage)
+{
+    blockSize = _blockSize;
+    storage = _storage;
+    numberOfHRTFs.store(0, std::memory_order_release);
+    maxPartitions.store(0, std::memory_order_release);
+    for (std::unique_ptr<TBankEntry>& entry : entries) { entry.reset(); }
+}
+
+int CHRTFBank::AddHRTF(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, const std::string& _name)
+{
+    int index = numberOfHRTFs.load(std::memory_order_relaxed);
+    if (_hrtf == nullptr || blockSize == 0 || index >= HRTF_BANK_CAPACITY) { return -1; }
+    const BRTServices::T_HRTFTable& table = _hrtf->GetRawHRTFTable();
+    if (table.empty()) { return -1; }
+
+    std::unique_ptr<TBankEntry> entry(new TBankEntry());
+    entry->hrtf = _hrtf;
+    entry->name = _name;
+    entry->index.Build(table);
+    entry->filters.resize(table.size());
+    CRealFFT fft(2 * blockSize);
+    size_t partitions = 0;
+    int point = 0;
+    for (const auto& hrir : table) {                            // The index numbers the points in the table iteration order
+        CPartitionedFilter& filter = entry->filters[point++];
+        filter.Setup(blockSize, hrir.second.leftHRIR.data(), hrir.second.rightHRIR.data(), std::min(hrir.second.leftHRIR.size(), hrir.second.rightHRIR.size()), storage, &fft);
+        partitions = std::max(partitions, filter.GetNumberOfPartitions());
+    }
+    return Publish(index, std::move(entry), partitions);
+}
+
+int CHRTFBank::AddHRTF(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, const std::string& _name, const std::vector<BRTServices::orientation>& _orientations,
+    std::vector<CPartitionedFilter>&& _filters)
+{
+    int index = numberOfHRTFs.load(std::memory_order_relaxed);
+    if (_hrtf == nullptr || blockSize == 0 || index >= HRTF_BANK_CAPACITY) { return -1; }
+    if (_filters.empty() || _filters.size() != _orientations.size()) { return -1; }
+
+    size_t partitions = 0;
+    for (const CPartitionedFilter& filter : _filters) {
+        if (filter.GetBlockSize() != blockSize || filter.GetPartitions(0).GetStorage() != storage) { return -1; }
+        partitions = std::max(partitions, filter.GetNumberOfPartitions());
+    }
+
+    std::unique_ptr<TBankEntry> entry(new TBankEntry());
+    entry->hrtf = _hrtf;
+    entry->name = _name;
+    entry->index.Build(_orientations);
+    entry->filters = std::move(_filters);
+    return Publish(index, std::move(entry), partitions);
+}
+
+int CHRTFBank::Publish(int _index, std::unique_ptr<TBankEntry> _entry, size_t _partitions)
+{
+    entries[_index] = std::move(_entry);
+    if (_partitions > maxPartitions.load(std::memory_order_relaxed)) { maxPartitions.store(_partitions, std::memory_order_release); }
+    numberOfHRTFs.store(_index + 1, std::memory_order_release); // Publishes the entry
+    return _index;
+}
+
+size_t CHRTFBank::GetMemoryBytes() const
+{
+    size_t bytes = 0;
+    for (int i = 0; i < GetNumberOfHRTFs(); i++) {
+        for (const CPartitionedFilter& filter : entries[i]->filters) { bytes += filter.GetMemoryBytes(); }
+    }
+    return bytes;
+}
+
+const std::shared_ptr<BRTServices::CHRTF>* CHRTFBank::GetHRTF(int _index) const
+{
+    if (_index < 0 || _index >= GetNumberOfHRTFs()) { return nullptr; }
+    return &entries[_index]->hrtf;
+}
+
+const CPartitionedFilter* CHRTFBank::FindFilter(int _index, float _azimuth, float _elevation) const
+{
+    if (_index < 0 || _index >= GetNumberOfHRTFs()) { return nullptr; }
+    const TBankEntry& entry = *entries[_index];
+    int point = entry.index.FindNearest(_azimuth, _elevation);
+    return point >= 0 ? &entry.filters[point] : nullptr;
+}
@@ -0,0 +1,118 @@
+/**
+*
+* \brief Resident set of HRTFs, partitioned for convolution, selected by index in constant time
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _HRTFBANK_H_
+#define _HRTFBANK_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <BRTLibrary.h>
+#include "CompactSpectra.h"
+#include "HRTFSpatialIndex.h"
+#include "PartitionedConvolver.h"
+
+#define HRTF_BANK_CAPACITY      16          // HRTFs a bank can hold, so adding one never moves those the audio thread reads
+
+/** \brief Set of preloaded HRTFs. For each one it keeps the HRTF, the partitioned spectra of the HRIRs of every grid point and a
+*	spatial index of the grid, so the audio thread can select an HRTF and find the filter of a direction in constant time.
+*	\details HRTFs are added by one control thread (or the loader) while the audio thread reads the bank: each entry is built
+*	before the count is published, and entries never move. Only one thread at a time may add HRTFs. HRTFs are not removed while the bank lives.
+*/
+class CHRTFBank {
+public:
+    CHRTFBank();
+
+    /** \brief Empties the bank and sets how its filters are partitioned. Not to be called while the audio thread reads the bank
+    *	\param [in] _blockSize samples per partition, the buffer size
+    *	\param [in] _storage format of the spectra
+    */
+    void Setup(size_t _blockSize, TSpectrumStorage _storage = SPECTRUM_STORAGE_FLOAT32);
+
+    /** \brief Partitions the HRIRs of an HRTF and adds it. Allocates, never from the audio thread
+    *	\param [in] _hrtf
+    *	\param [in] _name to list it, such as its file
+    *	\retval index of the HRTF in the bank, -1 if the bank is full or the HRTF is empty
+    */
+    int AddHRTF(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, const std::string& _name);
+
+    /** \brief Adds an HRTF whose HRIRs were already partitioned, such as those restored from its cache file. Allocates, never from the audio thread
+    *	\param [in] _hrtf
+    *	\param [in] _name to list it, such as its file
+    *	\param [in] _orientations grid points of the filters
+    *	\param [in] _filters _filters[i] belongs to _orientations[i], partitioned with the block size of the bank
+    *	\retval index of the HRTF in the bank, -1 if the bank is full or the filters do not fit it
+    */
+    int AddHRTF(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, const std::string& _name, const std::vector<BRTServices::orientation>& _orientations,
+        std::vector<CPartitionedFilter>&& _filters);
+
+    int GetNumberOfHRTFs() const { return numberOfHRTFs.load(std::memory_order_acquire); }
+    size_t GetBlockSize() const { return blockSize; }
+    TSpectrumStorage GetStorage() const { return storage; }
+
+    /** \brief Partitions of the longest HRIR in the bank
+    */
+    size_t GetMaxPartitions() const { return maxPartitions.load(std::memory_order_acquire); }
+
+    /** \brief Memory of the partitioned spectra of all the HRTFs
+    */
+    size_t GetMemoryBytes() const;
+
+    /** \brief HRTF at an index. Real-time safe
+    *	\retval nullptr if the index is not in the bank
+    */
+    const std::shared_ptr<BRTServices::CHRTF>* GetHRTF(int _index) const;
+
+    /** \brief Name the HRTF was added with
+    */
+    const std::string& GetName(int _index) const { return entries[_index]->name; }
+
+    /** \brief Filter of the grid point nearest to a direction. Constant time and real-time safe
+    *	\param [in] _index HRTF
+    *	\param [in] _azimuth degrees
+    *	\param [in] _elevation degrees
+    *	\retval nullptr if the index is not in the bank
+    */
+    const CPartitionedFilter* FindFilter(int _index, float _azimuth, float _elevation) const;
+
+private:
+    struct TBankEntry {
+        std::shared_ptr<BRTServices::CHRTF> hrtf;
+        std::string name;
+        CHRTFSpatialIndex index;
+        std::vector<CPartitionedFilter> filters;            // filters[i] belongs to point i of the index
+    };
+
+    /// Stores an entry whose filters are ready and publishes it
+    int Publish(int _index, std::unique_ptr<TBankEntry> _entry, size_t _partitions);
+
+    size_t blockSize;
+    TSpectrumStorage storage;
+    std::vector<std::unique_ptr<TBankEntry>> entries;       // HRTF_BANK_CAPACITY slots, filled in order
+    std::atomic<int> numberOfHRTFs;
+    std::atomic<size_t> maxPartitions;
+};
+
+#endif
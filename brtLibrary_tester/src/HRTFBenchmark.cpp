@@ -0,0 +1,273 @@
+/**
+*
+* \brief Benchmark of the HRTF SOFA parse, grid creation, offline interpolation and extrapolation, with stored baselines
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "HRTFBenchmark.h"
+#include "GridResampler.h"
+#include "ProcessingStatistics.hpp"
+#include <BRTLibrary.h>
+#include "ServiceModules/HRTFTester.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <vector>
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace {
+    /// HRTF SOFA files in resources. brir.sofa and the near field ILD files are not HRTFs
+    const char* const BENCHMARK_SOFA_FILES[] = {
+        "../../resources/hrtf.sofa",
+        "../../resources/0_IRC_1008_R_HRIR.sofa",
+        "../../resources/ListenResamp15.sofa",
+        "../../resources/SOFATransparentFront.sofa",
+    };
+
+    struct TBenchmarkResult {
+        std::string file;
+        int resamplingStep;
+        std::string stage;
+        double milliseconds;
+        long peakRSSKilobytes;
+    };
+
+    /// Makes the next GetPeakRSSKilobytes return the peak from now on, where the system allows it (Linux). Elsewhere the
+    /// peak is the one of the whole process
+    void ResetPeakRSS() {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        if (clearRefs.is_open()) { clearRefs << "5"; }
+#endif
+    }
+
+    long GetPeakRSSKilobytes() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) { return 0; }
+        return (long)(counters.PeakWorkingSetSize / 1024);
+#elif defined(__linux__)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) { return std::atol(line.c_str() + 6); }
+        }
+        return 0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return (long)(usage.ru_maxrss / 1024);         // Bytes on macOS
+#endif
+    }
+
+    std::shared_ptr<BRTServices::CHRTF> ParseHRTF(BRTReaders::CSOFAReader& _sofaReader, const std::string& _file, int _resamplingStep, const std::string& _extrapolationMethod) {
+        std::shared_ptr<BRTServices::CHRTF> hrtf = std::make_shared<BRTServices::CHRTF>();
+        if (!_sofaReader.ReadHRTFFromSofaWithoutProcess(_file, hrtf, _resamplingStep, _extrapolationMethod)) { return nullptr; }
+        return hrtf;
+    }
+
+    /// Runs a stage HRTF_BENCHMARK_REPETITIONS times, each one on a new HRTF, freshly parsed (not timed) if _startParsed, and keeps the fastest
+    bool MeasureStage(BRTReaders::CSOFAReader& _sofaReader, const std::string& _file, int _resamplingStep, const std::string& _extrapolationMethod,
+        bool _startParsed, const std::function<bool(std::shared_ptr<BRTServices::CHRTF>&)>& _stage, TBenchmarkResult& _result)
+    {
+        _result.milliseconds = -1;
+        for (int r = 0; r < HRTF_BENCHMARK_REPETITIONS; r++) {
+            std::shared_ptr<BRTServices::CHRTF> hrtf = _startParsed ? ParseHRTF(_sofaReader, _file, _resamplingStep, _extrapolationMethod) : std::make_shared<BRTServices::CHRTF>();
+            if (hrtf == nullptr) { return false; }
+            ResetPeakRSS();
+            CStopwatch stopwatch;
+            if (!_stage(hrtf)) { return false; }
+            double milliseconds = stopwatch.GetElapsedMilliseconds();
+            long peakRSSKilobytes = GetPeakRSSKilobytes();
+            if (_result.milliseconds < 0 || milliseconds < _result.milliseconds) {
+                _result.milliseconds = milliseconds;
+                _result.peakRSSKilobytes = peakRSSKilobytes;
+            }
+        }
+        return true;
+    }
+
+    void WriteResults(const std::vector<TBenchmarkResult>& _results, std::ostream& _output) {
+        _output << "{" << std::endl;
+        _output << "  \"hrtfBenchmark\": [" << std::endl;
+        for (size_t i = 0; i < _results.size(); i++) {       // One result per line, which is what ReadResults expects
+            const TBenchmarkResult& result = _results[i];
+            _output << "    { \"file\": \"" << result.file << "\", \"resamplingStep\": " << result.resamplingStep << ", \"stage\": \"" << result.stage
+                << "\", \"ms\": " << result.milliseconds << ", \"peakRssKB\": " << result.peakRSSKilobytes << " }" << (i + 1 < _results.size() ? "," : "") << std::endl;
+        }
+        _output << "  ]" << std::endl;
+        _output << "}" << std::endl;
+    }
+
+    /// Value of a key in a one-line JSON object written by WriteResults, without quotes
+    std::string FindValue(const std::string& _line, const std::string& _key) {
+        size_t position = _line.find("\"" + _key + "\":");
+        if (position == std::string::npos) { return ""; }
+        position = _line.find_first_not_of(" \"", position + _key.size() + 3);
+        if (position == std::string::npos) { return ""; }
+        size_t end = _line.find_first_of(",\"}", position);
+        return _line.substr(position, end == std::string::npos ? std::string::npos : end - position);
+    }
+
+    bool ReadResults(const std::string& _filePath, std::vector<TBenchmarkResult>& _results) {
+        std::ifstream file(_filePath);
+        if (!file.is_open()) { return false; }
+        std::string line;
+        while (std::getline(file, line)) {
+            TBenchmarkResult result;
+            result.stage = FindValue(line, "stage");
+            if (result.stage.empty()) { continue; }
+            result.file = FindValue(line, "file");
+            result.resamplingStep = std::atoi(FindValue(line, "resamplingStep").c_str());
+            result.milliseconds = std::atof(FindValue(line, "ms").c_str());
+            result.peakRSSKilobytes = std::atol(FindValue(line, "peakRssKB").c_str());
+            _results.push_back(result);
+        }
+        return true;
+    }
+
+    /// Prints every result past the tolerances of its baseline and returns how many there are
+    int CountRegressions(const std::vector<TBenchmarkResult>& _results, const std::vector<TBenchmarkResult>& _baseline) {
+        int regressions = 0;
+        for (const TBenchmarkResult& result : _results) {
+            auto baseline = std::find_if(_baseline.begin(), _baseline.end(), [&result](const TBenchmarkResult& _candidate) {
+                return _candidate.file == result.file && _candidate.resamplingStep == result.resamplingStep && _candidate.stage == result.stage;
+            });
+            if (baseline == _baseline.end()) { continue; }            // New file or stage, nothing to compare with
+            bool slower = result.milliseconds > baseline->milliseconds * (1 + HRTF_BENCHMARK_TIME_TOLERANCE) + HRTF_BENCHMARK_TIME_SLACK_MS;
+            bool bigger = result.peakRSSKilobytes > baseline->peakRSSKilobytes * (1 + HRTF_BENCHMARK_MEMORY_TOLERANCE) + HRTF_BENCHMARK_MEMORY_SLACK_KB;
+            if (!slower && !bigger) { continue; }
+            std::printf("REGRESSION %s step %d %s: %.2f ms (baseline %.2f), %ld KB (baseline %ld)\n", result.file.c_str(), result.resamplingStep,
+                result.stage.c_str(), result.milliseconds, baseline->milliseconds, result.peakRSSKilobytes, baseline->peakRSSKilobytes);
+            regressions++;
+        }
+        return regressions;
+    }
+}
+
+bool RunHRTFBenchmark(const std::string& _outputFilePath, const std::string& _baselineFilePath, bool _recordBaseline)
+{
+    BRTReaders::CSOFAReader sofaReader;
+    BRTServices::CHRTFTester hrtfTester;
+    std::vector<TBenchmarkResult> results;
+    bool failed = false;
+
+    std::printf("%-45s %5s %12s %12s %12s %12s %12s %13s %12s\n", "file", "step", "parse ms", "grid ms", "interp ms", "zero ms", "nearest ms", "tester ext ms", "peak MB");
+    for (const char* file : BENCHMARK_SOFA_FILES) {
+        for (int step = HRTF_BENCHMARK_FIRST_STEP; step <= HRTF_BENCHMARK_LAST_STEP; step++) {
+            TBenchmarkResult base = { file, step, "", 0, 0 };
+            TBenchmarkResult parseResult = base, gridResult = base, interpolationResult = base, zeroResult = base, nearestResult = base, extrapolationResult = base;
+            parseResult.stage = "parse";
+            gridResult.stage = "gridCreation";
+            interpolationResult.stage = "offlineInterpolation";
+            zeroResult.stage = "endSetupZero";
+            nearestResult.stage = "endSetupNearestPoint";
+            extrapolationResult.stage = "testerGridExtrapolation";
+
+            bool measured = MeasureStage(sofaReader, file, step, "NearestPoint", false, [&sofaReader, file, step](std::shared_ptr<BRTServices::CHRTF>& _hrtf) {
+                return sofaReader.ReadHRTFFromSofaWithoutProcess(file, _hrtf, step, "NearestPoint");
+            }, parseResult);
+            if (!measured) {
+                std::cout << "Error reading " << file << std::endl;
+                failed = true;
+                break;
+            }
+
+            // CHRTFTester also writes the grid it creates to a .csv file, which is part of the measured time
+            measured = MeasureStage(sofaReader, file, step, "NearestPoint", true, [&hrtfTester](std::shared_ptr<BRTServices::CHRTF>& _hrtf) { hrtfTester.TestGridCreation(_hrtf); return true; }, gridResult)
+                && MeasureStage(sofaReader, file, step, "NearestPoint", true, [&hrtfTester](std::shared_ptr<BRTServices::CHRTF>& _hrtf) { hrtfTester.TestGridInterpolation(_hrtf); return true; }, interpolationResult)
+                && MeasureStage(sofaReader, file, step, "Zero", true, [](std::shared_ptr<BRTServices::CHRTF>& _hrtf) { return _hrtf->EndSetup(); }, zeroResult)
+                && MeasureStage(sofaReader, file, step, "NearestPoint", true, [](std::shared_ptr<BRTServices::CHRTF>& _hrtf) { return _hrtf->EndSetup(); }, nearestResult);
+
+            // The library does not expose its extrapolation on its own. This stage times the tester's CGridResampler, not library
+            // code: the grid points it extrapolates (outside the measured coverage) are found untimed and only those are timed
+            std::shared_ptr<BRTServices::CHRTF> rawHRTF = measured ? ParseHRTF(sofaReader, file, step, "NearestPoint") : nullptr;
+            CGridResampler resampler(1);
+            std::vector<BRTServices::orientation> extrapolatedPoints;
+            measured = rawHRTF != nullptr && resampler.Prepare(rawHRTF->GetRawHRTFTable());
+            if (measured) {
+                for (const BRTServices::orientation& point : CGridResampler::CreateGrid((float)step)) {
+                    if (resampler.ClassifyPoint(point) == GRID_POINT_EXTRAPOLATED) { extrapolatedPoints.push_back(point); }
+                }
+                measured = MeasureStage(sofaReader, file, step, "NearestPoint", false, [&resampler, &extrapolatedPoints](std::shared_ptr<BRTServices::CHRTF>&) {
+                    BRTServices::THRIRStruct hrir;
+                    for (const BRTServices::orientation& point : extrapolatedPoints) { resampler.ResamplePoint(point, hrir); }
+                    return true;
+                }, extrapolationResult);
+            }
+            if (!measured) {
+                std::cout << "Error processing " << file << " with resampling step " << step << std::endl;
+                failed = true;
+                continue;
+            }
+
+            results.push_back(parseResult);
+            results.push_back(gridResult);
+            results.push_back(interpolationResult);
+            results.push_back(zeroResult);
+            results.push_back(nearestResult);
+            results.push_back(extrapolationResult);
+            long peakRSSKilobytes = std::max(std::max(parseResult.peakRSSKilobytes, gridResult.peakRSSKilobytes), std::max(std::max(interpolationResult.peakRSSKilobytes, zeroResult.peakRSSKilobytes), nearestResult.peakRSSKilobytes));
+            std::printf("%-45s %5d %12.2f %12.2f %12.2f %12.2f %12.2f %13.2f %12.1f   (%zu extrapolated points)\n", file, step, parseResult.milliseconds, gridResult.milliseconds,
+                interpolationResult.milliseconds, zeroResult.milliseconds, nearestResult.milliseconds, extrapolationResult.milliseconds, peakRSSKilobytes / 1024.0, extrapolatedPoints.size());
+        }
+    }
+
+    std::ofstream output(_outputFilePath);
+    if (!output.is_open()) {
+        std::cout << "Error writing " << _outputFilePath << std::endl;
+        return false;
+    }
+    WriteResults(results, output);
+    std::cout << "Benchmark results written to " << _outputFilePath << std::endl;
+    if (failed) {
+        std::cout << "HRTF benchmark FAILED, some files could not be read or processed" << std::endl;
+        return false;
+    }
+
+    if (_baselineFilePath.empty()) { return true; }
+    if (_recordBaseline) {
+        std::ofstream baselineOutput(_baselineFilePath);
+        if (!baselineOutput.is_open()) {
+            std::cout << "Error writing the baseline " << _baselineFilePath << std::endl;
+            return false;
+        }
+        WriteResults(results, baselineOutput);
+        std::cout << "Baseline recorded in " << _baselineFilePath << std::endl;
+        return true;
+    }
+    std::vector<TBenchmarkResult> baseline;
+    if (!ReadResults(_baselineFilePath, baseline)) {
+        std::cout << "Error reading the baseline " << _baselineFilePath << ", record one with --record-baseline" << std::endl;
+        return false;
+    }
+    int regressions = CountRegressions(results, baseline);
+    std::cout << regressions << " regression(s) against " << _baselineFilePath << std::endl;
+    return regressions == 0;
+}
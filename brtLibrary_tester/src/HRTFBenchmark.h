@@ -0,0 +1,51 @@
+/**
+*
+* \brief Benchmark of the HRTF SOFA parse, grid creation, offline interpolation and extrapolation, with stored baselines
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#ifndef _HRTFBENCHMARK_H_
+#define _HRTFBENCHMARK_H_
+
+#include <string>
+
+#define HRTF_BENCHMARK_FIRST_STEP           1           // Resampling steps swept, in degrees
+#define HRTF_BENCHMARK_LAST_STEP            15
+#define HRTF_BENCHMARK_REPETITIONS          3           // Runs of every stage, the fastest one is reported
+#define HRTF_BENCHMARK_TIME_TOLERANCE       0.25        // Relative slowdown over the baseline that counts as a regression
+#define HRTF_BENCHMARK_TIME_SLACK_MS        2.0         // Absolute slowdown always allowed, so very short stages do not fail on noise
+#define HRTF_BENCHMARK_MEMORY_TOLERANCE     0.10        // Relative peak RSS growth over the baseline that counts as a regression
+#define HRTF_BENCHMARK_MEMORY_SLACK_KB      1024
+
+/** \brief Times, for every HRTF SOFA file in resources and every resampling step from HRTF_BENCHMARK_FIRST_STEP to
+*	HRTF_BENCHMARK_LAST_STEP, each stage of the HRTF load separately: SOFA parse (ReadHRTFFromSofaWithoutProcess), grid creation
+*	and offline interpolation (CHRTFTester), EndSetup with the "Zero" and "NearestPoint" extrapolation methods, and the
+*	extrapolation of the grid points outside the measured coverage by the tester's CGridResampler (stage "testerGridExtrapolation").
+*	The library does not expose its own extrapolation, so that stage and its baseline track tester code, not the library.
+*	Each stage starts from a freshly parsed HRTF and reports its wall time and peak RSS.
+*	\param [in] _outputFilePath JSON results, one object per file, step and stage
+*	\param [in] _baselineFilePath results of a previous run to compare with, or to record. Empty to skip the comparison
+*	\param [in] _recordBaseline store this run in _baselineFilePath instead of comparing with it
+*	\retval true if every file was read and processed and, when compared, no stage regressed past the baseline tolerances.
+*	A missing baseline is a failure
+*/
+bool RunHRTFBenchmark(const std::string& _outputFilePath, const std::string& _baselineFilePath, bool _recordBaseline);
+
+#endif
@@ -0,0 +1,225 @@
+/**
+*
+* \brief Spatial index of the HRIRs of a grid, for constant time nearest point and interpolation triangle queries
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "HRTFSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+    const double PI = 3.14159265358979323846;
+    const double BARYCENTRIC_TOLERANCE = -1e-7;
+
+    double Determinant(const double* _a, const double* _b, const double* _c) {
+        return _a[0] * (_b[1] * _c[2] - _b[2] * _c[1]) - _a[1] * (_b[0] * _c[2] - _b[2] * _c[0]) + _a[2] * (_b[0] * _c[1] - _b[1] * _c[0]);
+    }
+
+    /// Elevation from -90 to 90
+    double SignedElevation(double _elevation) { return _elevation > 90.0 ? _elevation - 360.0 : _elevation; }
+}
+
+CHRTFSpatialIndex::CHRTFSpatialIndex() : cellDegrees(HRTF_INDEX_CELL_DEGREES), azimuthCells(0), elevationCells(0)
+{
+}
+
+CHRTFSpatialIndex::TUnitVector CHRTFSpatialIndex::ToUnitVector(double _azimuth, double _elevation)
+{
+    double azimuth = _azimuth * PI / 180.0;
+    double elevation = SignedElevation(_elevation) * PI / 180.0;
+    TUnitVector vector = { (float)(std::cos(azimuth) * std::cos(elevation)), (float)(std::sin(azimuth) * std::cos(elevation)), (float)std::sin(elevation) };
+    return vector;
+}
+
+void CHRTFSpatialIndex::Build(const BRTServices::T_HRTFTable& _table, float _cellDegrees)
+{
+    std::vector<BRTServices::orientation> tableOrientations;
+    tableOrientations.reserve(_table.size());
+    for (auto it = _table.begin(); it != _table.end(); it++) { tableOrientations.push_back(it->first); }
+    Build(tableOrientations, _cellDegrees);
+}
+
+void CHRTFSpatialIndex::Build(const std::vector<BRTServices::orientation>& _orientations, float _cellDegrees)
+{
+    orientations = _orientations;
+    cellDegrees = _cellDegrees;
+    azimuthCells = (int)std::ceil(360.0 / cellDegrees);
+    elevationCells = (int)std::ceil(180.0 / cellDegrees);
+    points.clear();
+    allPoints.clear();
+    for (size_t i = 0; i < orientations.size(); i++) {
+        points.push_back(ToUnitVector(orientations[i].azimuth, orientations[i].elevation));
+        allPoints.push_back((int)i);
+    }
+    cellStarts.assign(1, 0);
+    candidates.clear();
+    if (points.empty()) { cellStarts.clear(); return; }
+
+    // Points sorted by elevation: a point at angle R from a direction is within R of its elevation, so searches scan an elevation band
+    std::vector<int> byElevation = allPoints;
+    std::vector<double> sortedElevations;
+    std::sort(byElevation.begin(), byElevation.end(), [this](int _a, int _b) {
+        return SignedElevation(orientations[_a].elevation) < SignedElevation(orientations[_b].elevation);
+    });
+    for (int point : byElevation) { sortedElevations.push_back(SignedElevation(orientations[point].elevation)); }
+
+    const size_t neighbours = std::min<size_t>(HRTF_INDEX_NEIGHBOURS, points.size());
+    const double cellRadius = cellDegrees * 0.70711 + 1e-3;           // Half the diagonal of a cell, which is never longer than the one at the equator
+    const double gridSpacing = std::sqrt(41253.0 / points.size());    // Degrees between points if they were uniform (41253 square degrees in the sphere)
+    std::vector<std::pair<double, int>> band;                         // Cosine of the angle to the cell centre, point
+    std::vector<double> bandCosines;
+    for (int e = 0; e < elevationCells; e++) {
+        for (int a = 0; a < azimuthCells; a++) {
+            double centreElevation = -90.0 + (e + 0.5) * cellDegrees;
+            TUnitVector centre = ToUnitVector((a + 0.5) * cellDegrees, std::min(90.0, centreElevation));
+
+            double bandHalfWidth = 2 * (gridSpacing + cellRadius);
+            double minimumCosine = 1;
+            while (true) {
+                band.clear();
+                size_t first = std::lower_bound(sortedElevations.begin(), sortedElevations.end(), centreElevation - bandHalfWidth) - sortedElevations.begin();
+                size_t last = std::upper_bound(sortedElevations.begin(), sortedElevations.end(), centreElevation + bandHalfWidth) - sortedElevations.begin();
+                for (size_t i = first; i < last; i++) {
+                    const TUnitVector& point = points[byElevation[i]];
+                    band.push_back(std::make_pair((double)point.x * centre.x + (double)point.y * centre.y + (double)point.z * centre.z, byElevation[i]));
+                }
+                if (band.size() >= neighbours) {
+                    bandCosines.clear();
+                    for (const std::pair<double, int>& candidate : band) { bandCosines.push_back(candidate.first); }
+                    std::nth_element(bandCosines.begin(), bandCosines.begin() + (neighbours - 1), bandCosines.end(), std::greater<double>());
+                    double bound = std::acos(std::max(-1.0, std::min(1.0, bandCosines[neighbours - 1]))) * 180.0 / PI + 2 * cellRadius;
+                    minimumCosine = bound >= 180 ? -2 : std::cos(bound * PI / 180.0) - 1e-9;
+                    if (bound <= bandHalfWidth || bandHalfWidth >= 180) { break; }
+                    bandHalfWidth = std::min(180.0, bound);
+                }
+                else { bandHalfWidth = std::min(180.0, 2 * bandHalfWidth); }
+            }
+
+            size_t cellStart = candidates.size();
+            for (const std::pair<double, int>& candidate : band) {
+                if (candidate.first >= minimumCosine) { candidates.push_back(candidate.second); }
+            }
+            std::sort(candidates.begin() + cellStart, candidates.end());
+            cellStarts.push_back((int)candidates.size());
+        }
+    }
+}
+
+float CHRTFSpatialIndex::GetAverageCandidatesPerCell() const
+{
+    return cellStarts.size() > 1 ? (float)candidates.size() / (cellStarts.size() - 1) : 0.0f;
+}
+
+int CHRTFSpatialIndex::GetCell(float _azimuth, float _elevation) const
+{
+    float azimuth = _azimuth - 360.0f * std::floor(_azimuth / 360.0f);
+    float elevation = (float)SignedElevation(_elevation);
+    int a = std::min(azimuthCells - 1, std::max(0, (int)(azimuth / cellDegrees)));
+    int e = std::min(elevationCells - 1, std::max(0, (int)((elevation + 90.0f) / cellDegrees)));
+    return e * azimuthCells + a;
+}
+
+size_t CHRTFSpatialIndex::FindNeighbours(const TUnitVector& _direction, const int* _candidates, size_t _numberOfCandidates, size_t _maxNeighbours, int* _neighbours) const
+{
+    float cosines[HRTF_INDEX_NEIGHBOURS];
+    size_t numberOfNeighbours = 0;
+    for (size_t i = 0; i < _numberOfCandidates; i++) {
+        const TUnitVector& point = points[_candidates[i]];
+        float cosine = point.x * _direction.x + point.y * _direction.y + point.z * _direction.z;
+        if (numberOfNeighbours == _maxNeighbours && cosine <= cosines[numberOfNeighbours - 1]) { continue; }
+        size_t position = (numberOfNeighbours < _maxNeighbours) ? numberOfNeighbours++ : numberOfNeighbours - 1;
+        while (position > 0 && cosines[position - 1] < cosine) {
+            cosines[position] = cosines[position - 1];
+            _neighbours[position] = _neighbours[position - 1];
+            position--;
+        }
+        cosines[position] = cosine;
+        _neighbours[position] = _candidates[i];
+    }
+    return numberOfNeighbours;
+}
+
+bool CHRTFSpatialIndex::FindTriangleAmong(const TUnitVector& _direction, const int* _neighbours, size_t _numberOfNeighbours, TInterpolationTriangle& _triangle) const
+{
+    double direction[3] = { _direction.x, _direction.y, _direction.z };
+    for (size_t a = 0; a < _numberOfNeighbours; a++) {
+        for (size_t b = a + 1; b < _numberOfNeighbours; b++) {
+            for (size_t c = b + 1; c < _numberOfNeighbours; c++) {
+                const TUnitVector& pa = points[_neighbours[a]];
+                const TUnitVector& pb = points[_neighbours[b]];
+                const TUnitVector& pc = points[_neighbours[c]];
+                double va[3] = { pa.x, pa.y, pa.z }, vb[3] = { pb.x, pb.y, pb.z }, vc[3] = { pc.x, pc.y, pc.z };
+                double determinant = Determinant(va, vb, vc);
+                if (std::fabs(determinant) < 1e-9) { continue; }
+                double wa = Determinant(direction, vb, vc) / determinant;
+                double wb = Determinant(va, direction, vc) / determinant;
+                double wc = Determinant(va, vb, direction) / determinant;
+                if (wa < BARYCENTRIC_TOLERANCE || wb < BARYCENTRIC_TOLERANCE || wc < BARYCENTRIC_TOLERANCE) { continue; }
+                double sum = wa + wb + wc;
+                _triangle.vertices[0] = _neighbours[a];
+                _triangle.vertices[1] = _neighbours[b];
+                _triangle.vertices[2] = _neighbours[c];
+                _triangle.weights[0] = (float)(wa / sum);
+                _triangle.weights[1] = (float)(wb / sum);
+                _triangle.weights[2] = (float)(wc / sum);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int CHRTFSpatialIndex::FindNearest(float _azimuth, float _elevation) const
+{
+    if (!IsBuilt()) { return -1; }
+    int cell = GetCell(_azimuth, _elevation);
+    int nearest;
+    if (FindNeighbours(ToUnitVector(_azimuth, _elevation), &candidates[cellStarts[cell]], cellStarts[cell + 1] - cellStarts[cell], 1, &nearest) == 0) { return -1; }
+    return nearest;
+}
+
+bool CHRTFSpatialIndex::FindTriangle(float _azimuth, float _elevation, TInterpolationTriangle& _triangle) const
+{
+    if (!IsBuilt()) { return false; }
+    TUnitVector direction = ToUnitVector(_azimuth, _elevation);
+    int cell = GetCell(_azimuth, _elevation);
+    int neighbours[HRTF_INDEX_NEIGHBOURS];
+    size_t numberOfNeighbours = FindNeighbours(direction, &candidates[cellStarts[cell]], cellStarts[cell + 1] - cellStarts[cell], HRTF_INDEX_NEIGHBOURS, neighbours);
+    return FindTriangleAmong(direction, neighbours, numberOfNeighbours, _triangle);
+}
+
+int CHRTFSpatialIndex::FindNearestLinear(float _azimuth, float _elevation) const
+{
+    if (points.empty()) { return -1; }
+    int nearest;
+    FindNeighbours(ToUnitVector(_azimuth, _elevation), allPoints.data(), allPoints.size(), 1, &nearest);
+    return nearest;
+}
+
+bool CHRTFSpatialIndex::FindTriangleLinear(float _azimuth, float _elevation, TInterpolationTriangle& _triangle) const
+{
+    TUnitVector direction = ToUnitVector(_azimuth, _elevation);
+    int neighbours[HRTF_INDEX_NEIGHBOURS];
+    size_t numberOfNeighbours = FindNeighbours(direction, allPoints.data(), allPoints.size(), HRTF_INDEX_NEIGHBOURS, neighbours);
+    return FindTriangleAmong(direction, neighbours, numberOfNeighbours, _triangle);
+}
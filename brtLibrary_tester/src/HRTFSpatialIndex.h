@@ -0,0 +1,107 @@
+/**
+*
+* \brief Spatial index of the HRIRs of a grid, for constant time nearest point and interpolation triangle queries
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#ifndef _HRTFSPATIALINDEX_H_
+#define _HRTFSPATIALINDEX_H_
+
+#include <vector>
+#include <BRTLibrary.h>
+
+#define HRTF_INDEX_CELL_DEGREES         1.0f        // Azimuth and elevation size of the lookup table cells
+#define HRTF_INDEX_NEIGHBOURS           8           // Nearest points searched for an enclosing interpolation triangle
+
+/** \brief Three grid points and the barycentric weights of a direction inside them
+*/
+struct TInterpolationTriangle {
+    int vertices[3];
+    float weights[3];                               // Sum 1, all >= 0
+};
+
+/** \brief Lookup table over azimuth and elevation that answers, in constant time, which grid point is nearest to a direction and
+*	which triangle of grid points encloses it.
+*	\details Every cell of the table keeps the grid points that can be among the HRTF_INDEX_NEIGHBOURS nearest of any direction
+*	inside the cell: those within the distance of the cell centre to its HRTF_INDEX_NEIGHBOURS-th nearest point, plus twice the cell
+*	radius. A query only looks at the list of its cell, a few tens of points whatever the grid size, and returns exactly what a
+*	search over the whole grid returns (FindNearestLinear, FindTriangleLinear).
+*	Directions are azimuth and elevation in degrees, elevation either from -90 to 90 or from 0 to 90 and 270 to 360 as in the HRTF tables.
+*	The library render path does not use this index; CHRTF keeps its own lookups into the resampled grid.
+*/
+class CHRTFSpatialIndex {
+public:
+    CHRTFSpatialIndex();
+
+    /** \brief Builds the index of a grid
+    *	\param [in] _orientations grid points, queries return indices into this vector
+    *	\param [in] _cellDegrees size of the lookup table cells
+    */
+    void Build(const std::vector<BRTServices::orientation>& _orientations, float _cellDegrees = HRTF_INDEX_CELL_DEGREES);
+
+    /** \brief Builds the index of the orientations of an HRTF table, in the table iteration order
+    */
+    void Build(const BRTServices::T_HRTFTable& _table, float _cellDegrees = HRTF_INDEX_CELL_DEGREES);
+
+    bool IsBuilt() const { return !cellStarts.empty(); }
+
+    int GetNumberOfPoints() const { return (int)orientations.size(); }
+    const BRTServices::orientation& GetOrientation(int _point) const { return orientations[_point]; }
+
+    /** \brief Average number of points kept per cell
+    */
+    float GetAverageCandidatesPerCell() const;
+
+    /** \brief Nearest grid point to a direction
+    *	\retval index of the point, -1 if the index is empty
+    */
+    int FindNearest(float _azimuth, float _elevation) const;
+
+    /** \brief First triangle of the HRTF_INDEX_NEIGHBOURS nearest points, nearest vertices first, that encloses a direction
+    *	\param [out] _triangle
+    *	\retval false if none does, then the nearest point is the best HRIR
+    */
+    bool FindTriangle(float _azimuth, float _elevation, TInterpolationTriangle& _triangle) const;
+
+    /** \brief Same queries, searching the whole grid, to measure and check the index against
+    */
+    int FindNearestLinear(float _azimuth, float _elevation) const;
+    bool FindTriangleLinear(float _azimuth, float _elevation, TInterpolationTriangle& _triangle) const;
+
+private:
+    struct TUnitVector { float x, y, z; };
+
+    static TUnitVector ToUnitVector(double _azimuth, double _elevation);
+    int GetCell(float _azimuth, float _elevation) const;
+    /// Keeps the _maxNeighbours (up to HRTF_INDEX_NEIGHBOURS) nearest points of _candidates, nearest first
+    size_t FindNeighbours(const TUnitVector& _direction, const int* _candidates, size_t _numberOfCandidates, size_t _maxNeighbours, int* _neighbours) const;
+    bool FindTriangleAmong(const TUnitVector& _direction, const int* _neighbours, size_t _numberOfNeighbours, TInterpolationTriangle& _triangle) const;
+
+    std::vector<BRTServices::orientation> orientations;
+    std::vector<TUnitVector> points;
+    float cellDegrees;
+    int azimuthCells;
+    int elevationCells;
+    std::vector<int> cellStarts;                    // Candidates of cell c are candidates[cellStarts[c]] to candidates[cellStarts[c + 1]]
+    std::vector<int> candidates;                    // Ascending point index within each cell, so ties resolve as in the linear search
+    std::vector<int> allPoints;                     // 0 to N-1, the candidates of the linear search
+};
+
+#endif
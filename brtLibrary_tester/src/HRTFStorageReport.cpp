@@ -0,0 +1,167 @@
+/**
+*
+* \brief Memory footprint and spectral error of the compact HRTF storage formats
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "HRTFStorageReport.h"
+#include "CompactSpectra.h"
+#include "FFT.h"
+#include "GridResampler.h"
+#include "PartitionedConvolver.h"
+#include "ProcessingStatistics.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    volatile float benchmarkSink;           // Keeps the compiler from removing the measured work
+
+    struct TSpectralError {
+        double signal = 0;
+        double error = 0;
+        double sumOfRatios = 0;                         // dB, to average over spectra
+        double worstRatio = std::numeric_limits<double>::infinity();
+        double maxMagnitudeError = 0;                   // dB
+        size_t numberOfSpectra = 0;
+    };
+
+    void AddSpectrum(const float* _reference, const float* _decoded, size_t _bins, TSpectralError& _error) {
+        double signal = 0, error = 0, peak = 0;
+        for (size_t i = 0; i < _bins; i++) {
+            double re = _reference[2 * i], im = _reference[2 * i + 1];
+            double dre = _decoded[2 * i] - re, dim = _decoded[2 * i + 1] - im;
+            signal += re * re + im * im;
+            error += dre * dre + dim * dim;
+            peak = std::max(peak, re * re + im * im);
+        }
+        if (signal == 0) { return; }
+        for (size_t i = 0; i < _bins; i++) {
+            double power = (double)_reference[2 * i] * _reference[2 * i] + (double)_reference[2 * i + 1] * _reference[2 * i + 1];
+            if (power < peak * 1e-6) { continue; }              // More than 60 dB below the peak
+            double decodedPower = (double)_decoded[2 * i] * _decoded[2 * i] + (double)_decoded[2 * i + 1] * _decoded[2 * i + 1];
+            double magnitudeError = decodedPower > 0 ? std::fabs(10.0 * std::log10(decodedPower / power)) : 200.0;
+            _error.maxMagnitudeError = std::max(_error.maxMagnitudeError, magnitudeError);
+        }
+        double ratio = error > 0 ? 10.0 * std::log10(signal / error) : 200.0;
+        _error.signal += signal;
+        _error.error += error;
+        _error.sumOfRatios += ratio;
+        _error.worstRatio = std::min(_error.worstRatio, ratio);
+        _error.numberOfSpectra++;
+    }
+
+    /// Signal to error ratio of the output of the convolver with the given storage, against the 32 bit one
+    double MeasureConvolutionRatio(const BRTServices::THRIRStruct& _hrir, size_t _blockSize, TSpectrumStorage _storage) {
+        CUniformPartitionedConvolver reference, compact;
+        size_t length = _hrir.leftHRIR.size();
+        reference.Setup(_blockSize, _hrir.leftHRIR.data(), _hrir.rightHRIR.data(), length);
+        compact.Setup(_blockSize, _hrir.leftHRIR.data(), _hrir.rightHRIR.data(), length, _storage);
+
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+        std::vector<float> input(_blockSize), referenceLeft(_blockSize), referenceRight(_blockSize), left(_blockSize), right(_blockSize);
+        double signal = 0, error = 0;
+        for (int b = 0; b < 64; b++) {
+            for (float& sample : input) { sample = noise(generator); }
+            reference.Process(input.data(), referenceLeft.data(), referenceRight.data());
+            compact.Process(input.data(), left.data(), right.data());
+            for (size_t i = 0; i < _blockSize; i++) {
+                signal += (double)referenceLeft[i] * referenceLeft[i] + (double)referenceRight[i] * referenceRight[i];
+                error += ((double)left[i] - referenceLeft[i]) * ((double)left[i] - referenceLeft[i]) + ((double)right[i] - referenceRight[i]) * ((double)right[i] - referenceRight[i]);
+            }
+        }
+        if (signal == 0) { return 0; }
+        return error > 0 ? 10.0 * std::log10(signal / error) : std::numeric_limits<double>::infinity();
+    }
+}
+
+bool RunHRTFStorageReport(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, float _resamplingStep, size_t _partitionLength)
+{
+    TResampledGrid grid;
+    CGridResampler resampler(0);
+    if (_hrtf == nullptr || !resampler.Resample(_hrtf->GetRawHRTFTable(), _resamplingStep, grid) || grid.hrirs[0].leftHRIR.empty()) {
+        std::cout << "HRTF storage report: there is no HRTF to resample" << std::endl;
+        return false;
+    }
+
+    size_t hrirLength = grid.hrirs[0].leftHRIR.size();
+    size_t partitionsPerHRIR = (hrirLength + _partitionLength - 1) / _partitionLength;
+    size_t numberOfSpectra = grid.hrirs.size() * 2 * partitionsPerHRIR;
+    CRealFFT fft(2 * _partitionLength);
+    size_t spectrumSize = fft.GetSpectrumSize();
+
+    std::cout << std::endl << "HRTF storage: " << grid.hrirs.size() << " grid points every " << _resamplingStep << " degrees, HRIRs of "
+        << hrirLength << " samples in " << partitionsPerHRIR << " partition(s) of " << _partitionLength << " samples (" << numberOfSpectra << " spectra)" << std::endl;
+    char line[256];
+    snprintf(line, sizeof(line), "%10s %12s %7s %14s %15s %15s %12s %14s", "storage", "memory MB", "ratio", "mean SER dB", "worst SER dB", "max |dB| err", "expand ns", "output SER dB");
+    std::cout << line << std::endl;
+
+    size_t floatBytes = 0;
+    std::vector<float> padded(2 * _partitionLength), spectrum(spectrumSize), scratch(spectrumSize);
+    for (TSpectrumStorage storage : { SPECTRUM_STORAGE_FLOAT32, SPECTRUM_STORAGE_FLOAT16, SPECTRUM_STORAGE_INT16 }) {
+        // Stored as the convolver stores them: each partition zero padded to twice its length
+        CCompactSpectra table;
+        table.Setup(storage, numberOfSpectra, spectrumSize);
+        TSpectralError error;
+        size_t index = 0;
+        for (const BRTServices::THRIRStruct& hrir : grid.hrirs) {
+            for (const CMonoBuffer<float>* ear : { &hrir.leftHRIR, &hrir.rightHRIR }) {
+                for (size_t p = 0; p < partitionsPerHRIR; p++, index++) {
+                    size_t first = p * _partitionLength;
+                    size_t length = std::min(_partitionLength, hrirLength - first);
+                    std::fill(padded.begin(), padded.end(), 0.0f);
+                    std::copy(ear->begin() + first, ear->begin() + first + length, padded.begin());
+                    fft.Forward(padded.data(), spectrum.data());
+                    table.Store(index, spectrum.data());
+                    AddSpectrum(spectrum.data(), table.Read(index, scratch.data()), spectrumSize / 2, error);
+                }
+            }
+        }
+
+        CStopwatch stopwatch;
+        float sum = 0;
+        for (size_t i = 0; i < numberOfSpectra; i++) { sum += table.Read(i, scratch.data())[i % spectrumSize]; }
+        double expandNanoseconds = 1e6 * stopwatch.GetElapsedMilliseconds() / numberOfSpectra;
+        benchmarkSink = sum;
+
+        if (storage == SPECTRUM_STORAGE_FLOAT32) { floatBytes = table.GetMemoryBytes(); }
+        double meanRatio = error.numberOfSpectra > 0 ? error.sumOfRatios / error.numberOfSpectra : 0;
+        double worstRatio = error.numberOfSpectra > 0 ? error.worstRatio : 0;
+        double outputRatio = MeasureConvolutionRatio(grid.hrirs[0], _partitionLength, storage);
+        if (storage == SPECTRUM_STORAGE_FLOAT32) {
+            snprintf(line, sizeof(line), "%10s %12.2f %7.2f %14s %15s %15s %12.1f %14s", GetSpectrumStorageName(storage), table.GetMemoryBytes() / 1048576.0, 1.0,
+                "exact", "exact", "0", expandNanoseconds, "exact");
+        }
+        else {
+            snprintf(line, sizeof(line), "%10s %12.2f %7.2f %14.1f %15.1f %15.4f %12.1f %14.1f", GetSpectrumStorageName(storage), table.GetMemoryBytes() / 1048576.0,
+                (double)table.GetMemoryBytes() / floatBytes, meanRatio, worstRatio, error.maxMagnitudeError, expandNanoseconds, outputRatio);
+        }
+        std::cout << line << std::endl;
+    }
+    std::cout << "SER: signal to error ratio, of each spectrum and of the binaural output for white noise through the first grid HRIR."
+        << " Expand: time to read one spectrum (float32 is not expanded)" << std::endl;
+    std::cout << "These formats only apply to the tester partitioned convolvers; the listener HRTF the library renders with stays in float32" << std::endl;
+    return true;
+}
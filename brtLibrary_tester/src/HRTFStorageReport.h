@@ -0,0 +1,42 @@
+/**
+*
+* \brief Memory footprint and spectral error of the compact spectra formats of the tester partitioned convolvers
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _HRTFSTORAGEREPORT_H_
+#define _HRTFSTORAGEREPORT_H_
+
+#include <memory>
+#include <BRTLibrary.h>
+
+/** \brief Resamples an HRTF to a grid, partitions every HRIR in blocks of _partitionLength samples and keeps the partition
+*	spectra, as the tester partitioned convolvers do (the library keeps its HRTFs in float), in each TSpectrumStorage format. Prints, for each format, the memory of the whole grid,
+*	the signal to error ratio of the spectra (mean and worst), the largest magnitude error of the bins within 60 dB of the peak of
+*	their spectrum, the time to expand one spectrum and the signal to error ratio of a convolution with the front HRIR
+*	\param [in] _hrtf HRTF whose table is resampled
+*	\param [in] _resamplingStep degrees
+*	\param [in] _partitionLength samples, a power of two
+*	\retval false if the HRTF is empty
+*/
+bool RunHRTFStorageReport(const std::shared_ptr<BRTServices::CHRTF>& _hrtf, float _resamplingStep, size_t _partitionLength);
+
+#endif
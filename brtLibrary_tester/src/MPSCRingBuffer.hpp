@@ -0,0 +1,106 @@
+/**
+*
+* \brief Bounded lock-free queue for several producer threads and one consumer thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _MPSCRINGBUFFER_HPP_
+#define _MPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/** \brief Lock-free bounded queue for any number of producer threads and one consumer thread. Push never blocks or allocates, so
+*	the audio thread can be one of the producers; when the queue is full it fails at once.
+*	\details Each slot has a sequence number telling whether it is free for the producer of a given position or filled for the
+*	consumer. Producers claim positions with a compare-and-swap on the write counter, then fill the slot and publish it through
+*	its sequence. The consumer reads positions in order, so the elements of each producer keep their order.
+*/
+template <class T>
+class CMPSCRingBuffer {
+public:
+    /** \brief Allocates the storage
+    *	\param [in] _minimumCapacity rounded up to a power of two
+    */
+    explicit CMPSCRingBuffer(size_t _minimumCapacity) : writeCounter(0), readCounter(0) {
+        capacity = 1;
+        while (capacity < _minimumCapacity) { capacity <<= 1; }
+        mask = capacity - 1;
+        slots.reset(new TSlot[capacity]);
+        for (size_t i = 0; i < capacity; i++) { slots[i].sequence.store(i, std::memory_order_relaxed); }
+    }
+
+    CMPSCRingBuffer(const CMPSCRingBuffer&) = delete;
+    CMPSCRingBuffer& operator=(const CMPSCRingBuffer&) = delete;
+
+    size_t GetCapacity() const { return capacity; }
+
+    /** \brief Producer side, any thread. Writes one element
+    *	\retval false if the queue is full
+    */
+    bool Push(const T& _element) {
+        size_t write = writeCounter.load(std::memory_order_relaxed);
+        while (true) {
+            TSlot& slot = slots[write & mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == write) {
+                if (writeCounter.compare_exchange_weak(write, write + 1, std::memory_order_relaxed)) {
+                    slot.element = _element;
+                    slot.sequence.store(write + 1, std::memory_order_release);         // Filled
+                    return true;
+                }
+            }
+            else if ((std::ptrdiff_t)(sequence - write) < 0) { return false; }         // Not read yet: full
+            else { write = writeCounter.load(std::memory_order_relaxed); }             // Claimed by another producer
+        }
+    }
+
+    /** \brief Consumer side. Reads one element
+    *	\retval false if the queue is empty, or the next element is still being written
+    */
+    bool Pop(T& _element) {
+        size_t read = readCounter.load(std::memory_order_relaxed);
+        TSlot& slot = slots[read & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != read + 1) { return false; }
+        _element = slot.element;
+        slot.sequence.store(read + capacity, std::memory_order_release);                // Free for the producer of the next lap
+        readCounter.store(read + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    struct TSlot {
+        std::atomic<size_t> sequence;
+        T element;
+    };
+
+    std::unique_ptr<TSlot[]> slots;
+    size_t capacity;
+    size_t mask;
+    char padding0[64];                                  // Counters on separate cache lines (alignas would need C++17 aligned new)
+    std::atomic<size_t> writeCounter;                   // Written by every producer
+    char padding1[64];
+    std::atomic<size_t> readCounter;                    // Only written by the consumer
+    char padding2[64];
+};
+
+#endif
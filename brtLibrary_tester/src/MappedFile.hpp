@@ -0,0 +1,143 @@
+/**
+*
+* \brief Read-only memory mapped file
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _MAPPEDFILE_HPP_
+#define _MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#define MAPPED_FILE_READ_AHEAD_LIMIT    (16 * 1024 * 1024)  // Bytes up to which a whole file is read ahead
+
+/** \brief Maps a whole file in memory, read-only. Pages are loaded by the OS on first access, so opening is cheap
+*	whatever the size of the file
+*/
+class CMappedFile {
+public:
+    CMappedFile() : data(nullptr), size(0)
+#if defined(_WIN32)
+        , fileHandle(INVALID_HANDLE_VALUE), mappingHandle(NULL)
+#else
+        , fileDescriptor(-1)
+#endif
+    {}
+
+    ~CMappedFile() { Close(); }
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+
+    /** \brief Maps a file
+    *	\param [in] _filePath
+    *	\retval true if the file could be mapped
+    */
+    bool Open(const std::string& _filePath) {
+        Close();
+#if defined(_WIN32)
+        fileHandle = CreateFileA(_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE) { return false; }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) { Close(); return false; }
+        size = (size_t)fileSize.QuadPart;
+        if (size == 0) { return true; }
+        mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mappingHandle == NULL) { Close(); return false; }
+        data = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) { Close(); return false; }
+#else
+        fileDescriptor = open(_filePath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) { return false; }
+        struct stat fileStatus;
+        if (fstat(fileDescriptor, &fileStatus) != 0) { Close(); return false; }
+        size = (size_t)fileStatus.st_size;
+        if (size == 0) { return true; }
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED) { Close(); return false; }
+        data = (const uint8_t*)mapping;
+#endif
+        return true;
+    }
+
+    /** \brief Unmaps the file
+    */
+    void Close() {
+#if defined(_WIN32)
+        if (data != nullptr) { UnmapViewOfFile(data); }
+        if (mappingHandle != NULL) { CloseHandle(mappingHandle); }
+        if (fileHandle != INVALID_HANDLE_VALUE) { CloseHandle(fileHandle); }
+        mappingHandle = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (data != nullptr) { munmap((void*)data, size); }
+        if (fileDescriptor >= 0) { close(fileDescriptor); }
+        fileDescriptor = -1;
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    /** \brief Tells the OS the file is going to be read sequentially, so it reads ahead more aggressively. Files up to
+    *	MAPPED_FILE_READ_AHEAD_LIMIT bytes are also read ahead as a whole; larger ones are not, they would evict other pages
+    */
+    void AdviseSequential() {
+#if !defined(_WIN32)
+        if (data == nullptr) { return; }
+        madvise((void*)data, size, MADV_SEQUENTIAL);                    // The advice values are not flags, each needs its own call
+        if (size <= MAPPED_FILE_READ_AHEAD_LIMIT) { madvise((void*)data, size, MADV_WILLNEED); }
+#endif
+    }
+
+    bool IsOpen() const {
+#if defined(_WIN32)
+        return fileHandle != INVALID_HANDLE_VALUE;
+#else
+        return fileDescriptor >= 0;
+#endif
+    }
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+#if defined(_WIN32)
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+};
+
+#endif
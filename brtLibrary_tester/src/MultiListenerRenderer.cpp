@@ -0,0 +1,228 @@
+/**
+*
+* \brief Rendering of one scene for several listeners, sharing the spectra of the sources
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "MultiListenerRenderer.h"
+#include "AudioKernels.h"
+#include "ProcessingStatistics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    const float PI = 3.14159265358979323846f;
+
+    /// Listeners side by side, 25 cm apart, each with the next HRTF of the bank
+    Common::CVector3 GetListenerPosition(size_t _listener) { return Common::CVector3(0, 0.25f * _listener, 0); }
+
+    /// Sources evenly spread around the listeners, turning at MULTI_LISTENER_SOURCE_SPEED
+    Common::CVector3 GetSourcePosition(size_t _source, size_t _numberOfSources, double _time) {
+        float azimuth = (float)(360.0 * _source / _numberOfSources + MULTI_LISTENER_SOURCE_SPEED * _time) * PI / 180.0f;
+        float elevation = (-30.0f + 60.0f * (_source % 5) / 4.0f) * PI / 180.0f;
+        return Common::CVector3(MULTI_LISTENER_SOURCE_DISTANCE * std::cos(elevation) * std::cos(azimuth), MULTI_LISTENER_SOURCE_DISTANCE * std::cos(elevation) * std::sin(azimuth),
+            MULTI_LISTENER_SOURCE_DISTANCE * std::sin(elevation));
+    }
+
+    void FillSourceInputs(const std::vector<float>& _sourceSamples, size_t _block, size_t _blockSize, std::vector<std::vector<float>>& _inputs) {
+        for (size_t s = 0; s < _inputs.size(); s++) {
+            size_t position = (_sourceSamples.size() * s / _inputs.size() + _block * _blockSize) % _sourceSamples.size();    // Decorrelated inputs
+            for (size_t i = 0; i < _blockSize; i++, position = (position + 1) % _sourceSamples.size()) { _inputs[s][i] = _sourceSamples[position]; }
+        }
+    }
+}
+
+CMultiListenerRenderer::CMultiListenerRenderer() : bank(nullptr), blockSize(0), shareSourceSpectra(true)
+{
+}
+
+void CMultiListenerRenderer::Setup(const CHRTFBank& _bank, size_t _numberOfSources, size_t _numberOfListeners, bool _shareSourceSpectra)
+{
+    bank = &_bank;
+    blockSize = _bank.GetBlockSize();
+    shareSourceSpectra = _shareSourceSpectra;
+    size_t maxPartitions = _bank.GetMaxPartitions();
+
+    sourceSpectra.clear();
+    if (shareSourceSpectra) {
+        sourceSpectra.resize(_numberOfSources);
+        for (CSpectrumDelayLine& spectra : sourceSpectra) { spectra.Setup(blockSize, maxPartitions); }
+    }
+    sourcePositions.assign(_numberOfSources, Common::CVector3(MULTI_LISTENER_SOURCE_DISTANCE, 0, 0));
+    listeners.clear();
+    listeners.resize(_numberOfListeners);
+    for (TListener& listener : listeners) {
+        listener.convolvers.resize(_numberOfSources);
+        for (CUniformPartitionedConvolver& convolver : listener.convolvers) { convolver.Setup(blockSize, maxPartitions, shareSourceSpectra); }
+        listener.left.assign(blockSize, 0.0f);
+        listener.right.assign(blockSize, 0.0f);
+    }
+    sourceLeft.assign(blockSize, 0.0f);
+    sourceRight.assign(blockSize, 0.0f);
+}
+
+void CMultiListenerRenderer::SetListener(size_t _listener, int _hrtfIndex, const Common::CVector3& _position)
+{
+    listeners[_listener].hrtfIndex = _hrtfIndex;
+    listeners[_listener].position = _position;
+}
+
+void CMultiListenerRenderer::Process(const float* const* _sourceInputs)
+{
+    const TAudioKernels& kernels = GetAudioKernels();
+    for (size_t s = 0; s < sourceSpectra.size(); s++) { sourceSpectra[s].Push(_sourceInputs[s]); }
+
+    for (TListener& listener : listeners) {
+        kernels.Fill(listener.left.data(), 0.0f, blockSize);
+        kernels.Fill(listener.right.data(), 0.0f, blockSize);
+        for (size_t s = 0; s < sourcePositions.size(); s++) {
+            Common::CVector3 direction(sourcePositions[s].x - listener.position.x, sourcePositions[s].y - listener.position.y, sourcePositions[s].z - listener.position.z);
+            float distance = std::max(1e-6f, direction.GetDistance());
+            float azimuth = std::atan2(direction.y, direction.x) * 180.0f / PI;
+            float elevation = std::asin(std::max(-1.0f, std::min(1.0f, direction.z / distance))) * 180.0f / PI;
+            CUniformPartitionedConvolver& convolver = listener.convolvers[s];
+            convolver.SetFilter(bank->FindFilter(listener.hrtfIndex, azimuth < 0 ? azimuth + 360.0f : azimuth, elevation < 0 ? elevation + 360.0f : elevation));
+
+            if (shareSourceSpectra) { convolver.ProcessSpectra(sourceSpectra[s], sourceLeft.data(), sourceRight.data()); }
+            else { convolver.Process(_sourceInputs[s], sourceLeft.data(), sourceRight.data()); }
+            kernels.Accumulate(listener.left.data(), sourceLeft.data(), blockSize);
+            kernels.Accumulate(listener.right.data(), sourceRight.data(), blockSize);
+        }
+    }
+}
+
+void RunMultiListenerBenchmark(const CHRTFBank& _bank, const std::vector<float>& _sourceSamples, size_t _numberOfSources, size_t _maxListeners)
+{
+    int numberOfHRTFs = _bank.GetNumberOfHRTFs();
+    if (numberOfHRTFs == 0 || _sourceSamples.empty() || _numberOfSources == 0) {
+        std::cout << "The multi-listener benchmark needs an HRTF in the bank and the source audio" << std::endl;
+        return;
+    }
+    Common::CGlobalParameters globalParameters;
+    size_t blockSize = _bank.GetBlockSize();
+    double blockSeconds = (double)blockSize / globalParameters.GetSampleRate();
+    double deadline = 1000.0 * blockSeconds;
+    _maxListeners = std::max<size_t>(1, std::min<size_t>(_maxListeners, MULTI_LISTENER_MAX_LISTENERS));
+
+    std::vector<std::vector<float>> inputs(_numberOfSources, std::vector<float>(blockSize));
+    std::vector<const float*> inputPointers(_numberOfSources);
+    for (size_t s = 0; s < _numberOfSources; s++) { inputPointers[s] = inputs[s].data(); }
+
+    std::cout << std::endl << "Multi-listener rendering: " << _numberOfSources << " sources, " << numberOfHRTFs << " HRTFs, buffer size " << blockSize << std::endl;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%9s %12s %14s %12s %10s %10s", "listeners", "library ms", "independent ms", "shared ms", "FFTs", "identical");
+    std::cout << row << std::endl;
+
+    std::vector<double> libraryMeans, independentMeans, sharedMeans;
+    for (size_t numberOfListeners = 1; numberOfListeners <= _maxListeners; numberOfListeners++) {
+        // Library: one manager, every listener connected to the same sources
+        BRTBase::CBRTManager brtManager;
+        std::vector<std::shared_ptr<BRTListenerModel::CListenerHRTFbasedModel>> brtListeners;
+        std::vector<std::shared_ptr<BRTSourceModel::CSourceSimpleModel>> brtSources;
+        brtManager.BeginSetup();
+        for (size_t l = 0; l < numberOfListeners; l++) {
+            brtListeners.push_back(brtManager.CreateListener<BRTListenerModel::CListenerHRTFbasedModel>("multiListener" + std::to_string(l)));
+        }
+        for (size_t s = 0; s < _numberOfSources; s++) {
+            brtSources.push_back(brtManager.CreateSoundSource<BRTSourceModel::CSourceSimpleModel>("multiListenerSource" + std::to_string(s)));
+            for (auto& brtListener : brtListeners) { brtListener->ConnectSoundSource(brtSources.back()); }
+        }
+        brtManager.EndSetup();
+        for (size_t l = 0; l < numberOfListeners; l++) {
+            Common::CTransform transform;
+            transform.SetPosition(GetListenerPosition(l));
+            brtListeners[l]->SetListenerTransform(transform);
+            brtListeners[l]->SetHRTF(*_bank.GetHRTF((int)(l % numberOfHRTFs)));
+            brtListeners[l]->DisableNearFieldEffect();
+            brtListeners[l]->DisableInterpolation();            // The renderer takes the nearest grid HRIR, it does not interpolate
+        }
+        std::vector<CMonoBuffer<float>> brtInputs(_numberOfSources, CMonoBuffer<float>(blockSize));
+        Common::CEarPair<CMonoBuffer<float>> brtOutput;
+        brtOutput.left.resize(blockSize);
+        brtOutput.right.resize(blockSize);
+
+        CMultiListenerRenderer independent, shared;
+        independent.Setup(_bank, _numberOfSources, numberOfListeners, false);
+        shared.Setup(_bank, _numberOfSources, numberOfListeners, true);
+        for (size_t l = 0; l < numberOfListeners; l++) {
+            independent.SetListener(l, (int)(l % numberOfHRTFs), GetListenerPosition(l));
+            shared.SetListener(l, (int)(l % numberOfHRTFs), GetListenerPosition(l));
+        }
+
+        std::vector<double> libraryTimes, independentTimes, sharedTimes;
+        bool identical = true;
+        for (size_t block = 0; block < MULTI_LISTENER_WARMUP_BLOCKS + MULTI_LISTENER_MEASURED_BLOCKS; block++) {
+            bool measured = block >= MULTI_LISTENER_WARMUP_BLOCKS;
+            FillSourceInputs(_sourceSamples, block, blockSize, inputs);
+            for (size_t s = 0; s < _numberOfSources; s++) {
+                Common::CVector3 position = GetSourcePosition(s, _numberOfSources, (block + 0.5) * blockSeconds);
+                independent.SetSourcePosition(s, position);
+                shared.SetSourcePosition(s, position);
+            }
+
+            CStopwatch stopwatch;
+            for (size_t s = 0; s < _numberOfSources; s++) {
+                Common::CTransform transform = brtSources[s]->GetCurrentSourceTransform();
+                transform.SetPosition(GetSourcePosition(s, _numberOfSources, (block + 0.5) * blockSeconds));
+                brtSources[s]->SetSourceTransform(transform);
+                std::copy(inputs[s].begin(), inputs[s].end(), brtInputs[s].begin());
+                brtSources[s]->SetBuffer(brtInputs[s]);
+            }
+            brtManager.ProcessAll();
+            for (auto& brtListener : brtListeners) { brtListener->GetBuffers(brtOutput.left, brtOutput.right); }
+            if (measured) { libraryTimes.push_back(stopwatch.GetElapsedMilliseconds()); }
+
+            stopwatch.Restart();
+            independent.Process(inputPointers.data());
+            if (measured) { independentTimes.push_back(stopwatch.GetElapsedMilliseconds()); }
+
+            stopwatch.Restart();
+            shared.Process(inputPointers.data());
+            if (measured) { sharedTimes.push_back(stopwatch.GetElapsedMilliseconds()); }
+
+            for (size_t l = 0; l < numberOfListeners; l++) {
+                identical = identical && memcmp(independent.GetLeftOutput(l), shared.GetLeftOutput(l), blockSize * sizeof(float)) == 0 &&
+                    memcmp(independent.GetRightOutput(l), shared.GetRightOutput(l), blockSize * sizeof(float)) == 0;
+            }
+        }
+
+        libraryMeans.push_back(ComputeTimingStatistics(libraryTimes, deadline).mean);
+        independentMeans.push_back(ComputeTimingStatistics(independentTimes, deadline).mean);
+        sharedMeans.push_back(ComputeTimingStatistics(sharedTimes, deadline).mean);
+        std::string transforms = std::to_string(independent.GetForwardTransformsPerBlock()) + "/" + std::to_string(shared.GetForwardTransformsPerBlock());
+        std::snprintf(row, sizeof(row), "%9zu %12.4f %14.4f %12.4f %10s %10s", numberOfListeners, libraryMeans.back(), independentMeans.back(), sharedMeans.back(),
+            transforms.c_str(), identical ? "yes" : "NO");
+        std::cout << row << std::endl;
+    }
+
+    if (_maxListeners > 1) {
+        double additional = (double)(_maxListeners - 1);
+        std::cout << "Prototype renderer, cost per additional listener: independent " << (independentMeans.back() - independentMeans.front()) / additional
+            << " ms, shared " << (sharedMeans.back() - sharedMeans.front()) / additional << " ms (first listener " << sharedMeans.front() << " ms)" << std::endl;
+    }
+    std::cout << "The renderer is a different algorithm from the library listener (nearest HRIR only, no ITD, no HRIR interpolation, no near"
+        << " field effect) and is not used by the tester's render path. The library column is a reference for the scene, not a"
+        << " comparison: sharing the source spectra says nothing about the cost of additional library listeners" << std::endl;
+}
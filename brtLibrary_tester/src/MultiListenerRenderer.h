@@ -0,0 +1,113 @@
+/**
+*
+* \brief Prototype rendering of one scene for several listeners, sharing the spectra of the sources. A different algorithm from
+* the library listener, benchmarked only
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _MULTILISTENERRENDERER_H_
+#define _MULTILISTENERRENDERER_H_
+
+#include <memory>
+#include <vector>
+#include <BRTLibrary.h>
+#include "HRTFBank.h"
+#include "PartitionedConvolver.h"
+
+#define MULTI_LISTENER_MAX_LISTENERS        8
+#define MULTI_LISTENER_WARMUP_BLOCKS        20
+#define MULTI_LISTENER_MEASURED_BLOCKS      200
+#define MULTI_LISTENER_SOURCE_DISTANCE      2.0f
+#define MULTI_LISTENER_SOURCE_SPEED         30.0f       // Degrees per second around the listeners
+
+/** \brief Renders the same sources for several listeners, each one with its own HRTF of a CHRTFBank and its own position. Every
+*	listener has a convolver per source, whose filter is that of the direction of the source seen from the listener.
+*	\details With shared spectra, the input of each source is transformed once per block into a CSpectrumDelayLine that the
+*	convolvers of every listener read; otherwise each convolver transforms its input, as independent listeners do. Both give the
+*	same output bits. Everything is allocated in Setup.
+*	It takes the nearest grid HRIR of each direction and applies no ITD, HRIR interpolation or near field effect, so it is a
+*	model of the convolution cost only, not a replacement of the library listener. It is not used by the render path.
+*/
+class CMultiListenerRenderer {
+public:
+    CMultiListenerRenderer();
+
+    /** \brief Allocates the convolvers and the outputs. The bank must outlive the renderer and not grow while it renders
+    *	\param [in] _bank HRTFs of the listeners, partitioned with the block size
+    *	\param [in] _numberOfSources
+    *	\param [in] _numberOfListeners
+    *	\param [in] _shareSourceSpectra transform each source once for every listener
+    */
+    void Setup(const CHRTFBank& _bank, size_t _numberOfSources, size_t _numberOfListeners, bool _shareSourceSpectra);
+
+    /** \brief Sets the HRTF and position of a listener, which faces the X axis
+    *	\param [in] _listener
+    *	\param [in] _hrtfIndex in the bank
+    *	\param [in] _position
+    */
+    void SetListener(size_t _listener, int _hrtfIndex, const Common::CVector3& _position);
+
+    void SetSourcePosition(size_t _source, const Common::CVector3& _position) { sourcePositions[_source] = _position; }
+
+    /** \brief Renders one block for every listener. Does not allocate
+    *	\param [in] _sourceInputs block size samples of each source
+    */
+    void Process(const float* const* _sourceInputs);
+
+    const float* GetLeftOutput(size_t _listener) const { return listeners[_listener].left.data(); }
+    const float* GetRightOutput(size_t _listener) const { return listeners[_listener].right.data(); }
+
+    /** \brief Forward transforms of the source inputs in each block
+    */
+    size_t GetForwardTransformsPerBlock() const { return shareSourceSpectra ? sourceSpectra.size() : sourcePositions.size() * listeners.size(); }
+
+private:
+    struct TListener {
+        int hrtfIndex = 0;
+        Common::CVector3 position;
+        std::vector<CUniformPartitionedConvolver> convolvers;   // One per source
+        std::vector<float> left;
+        std::vector<float> right;
+    };
+
+    const CHRTFBank* bank;
+    size_t blockSize;
+    bool shareSourceSpectra;
+    std::vector<CSpectrumDelayLine> sourceSpectra;              // One per source, empty without shared spectra
+    std::vector<Common::CVector3> sourcePositions;
+    std::vector<TListener> listeners;
+    std::vector<float> sourceLeft;
+    std::vector<float> sourceRight;
+};
+
+/** \brief Renders N moving sources for 1 to _maxListeners listeners, with different HRTFs of the bank and positions, through one
+*	BRT manager whose listeners are all connected to the same sources, and with CMultiListenerRenderer without and with shared
+*	source spectra. Prints the block time of each, the cost of each additional listener of the renderer and whether both
+*	renderers match. The library listeners, with interpolation and near field disabled, still apply the ITD and their per source
+*	processing: their time is a reference for the scene, not a comparison with the renderer
+*	\param [in] _bank HRTFs of the listeners, partitioned with the buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _numberOfSources
+*	\param [in] _maxListeners
+*/
+void RunMultiListenerBenchmark(const CHRTFBank& _bank, const std::vector<float>& _sourceSamples, size_t _numberOfSources, size_t _maxListeners);
+
+#endif
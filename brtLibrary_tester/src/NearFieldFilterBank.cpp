@@ -0,0 +1,122 @@
+/**
+*
+* \brief Near field ILD filters: coefficient lookup table and biquad cascades of many sources in SIMD lanes
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "NearFieldFilterBank.h"
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////
+// Coefficient table
+//////////////////////////////
+
+CILDCoefficientTable::CILDCoefficientTable() : distanceSteps(0), azimuthSteps(0)
+{
+}
+
+bool CILDCoefficientTable::Build(const std::shared_ptr<BRTServices::CILD>& _ild)
+{
+    coefficients.clear();
+    if (_ild == nullptr) { return false; }
+    distanceSteps = (int)std::lround((NEARFIELD_TABLE_MAX_DISTANCE - NEARFIELD_TABLE_MIN_DISTANCE) / NEARFIELD_TABLE_DISTANCE_STEP) + 1;
+    azimuthSteps = (int)std::lround(180.0f / NEARFIELD_TABLE_AZIMUTH_STEP) + 1;
+    std::vector<float> table((size_t)2 * distanceSteps * azimuthSteps * NEARFIELD_COEFFICIENTS);
+    for (int ear = 0; ear < 2; ear++) {
+        for (int d = 0; d < distanceSteps; d++) {
+            for (int a = 0; a < azimuthSteps; a++) {
+                std::vector<float> point = _ild->GetILDNearFieldEffectCoefficients(ear == 0 ? Common::LEFT : Common::RIGHT,
+                    NEARFIELD_TABLE_MIN_DISTANCE + d * NEARFIELD_TABLE_DISTANCE_STEP, -90.0f + a * NEARFIELD_TABLE_AZIMUTH_STEP);
+                if (point.size() != NEARFIELD_COEFFICIENTS) { return false; }
+                std::copy(point.begin(), point.end(), table.begin() + (((size_t)ear * distanceSteps + d) * azimuthSteps + a) * NEARFIELD_COEFFICIENTS);
+            }
+        }
+    }
+    coefficients.swap(table);
+    return true;
+}
+
+void CILDCoefficientTable::Lookup(Common::T_ear _ear, float _distance, float _interauralAzimuth, float* _coefficients) const
+{
+    float distance = (std::min(std::max(_distance, NEARFIELD_TABLE_MIN_DISTANCE), NEARFIELD_TABLE_MAX_DISTANCE) - NEARFIELD_TABLE_MIN_DISTANCE) / NEARFIELD_TABLE_DISTANCE_STEP;
+    float azimuth = (std::min(std::max(_interauralAzimuth, -90.0f), 90.0f) + 90.0f) / NEARFIELD_TABLE_AZIMUTH_STEP;
+    int d0 = std::min((int)distance, distanceSteps - 2);
+    int a0 = std::min((int)azimuth, azimuthSteps - 2);
+    float dWeight = distance - d0;
+    float aWeight = azimuth - a0;
+    int ear = (_ear == Common::RIGHT) ? 1 : 0;
+    const float* p00 = GetPoint(ear, d0, a0);
+    const float* p01 = GetPoint(ear, d0, a0 + 1);
+    const float* p10 = GetPoint(ear, d0 + 1, a0);
+    const float* p11 = GetPoint(ear, d0 + 1, a0 + 1);
+    for (int c = 0; c < NEARFIELD_COEFFICIENTS; c++) {
+        float near = p00[c] + aWeight * (p01[c] - p00[c]);
+        float far = p10[c] + aWeight * (p11[c] - p10[c]);
+        _coefficients[c] = near + dWeight * (far - near);
+    }
+}
+
+//////////////////////////////
+// Biquad lanes
+//////////////////////////////
+
+CBiquadCascadeBank::CBiquadCascadeBank() : numberOfChannels(0), numberOfLanes(0), numberOfFrames(0), numberOfStages(0), kernels(&GetAudioKernels())
+{
+}
+
+void CBiquadCascadeBank::Setup(size_t _numberOfChannels, size_t _numberOfFrames, size_t _numberOfStages)
+{
+    numberOfChannels = _numberOfChannels;
+    numberOfLanes = (_numberOfChannels + 7) & ~size_t(7);
+    numberOfFrames = _numberOfFrames;
+    numberOfStages = _numberOfStages;
+    samples.assign(numberOfFrames * numberOfLanes, 0.0f);
+    coefficients.assign(numberOfStages * 5 * numberOfLanes, 0.0f);
+    states.assign(numberOfStages * 2 * numberOfLanes, 0.0f);
+    for (size_t stage = 0; stage < numberOfStages; stage++) {
+        std::fill(&coefficients[stage * 5 * numberOfLanes], &coefficients[stage * 5 * numberOfLanes] + numberOfLanes, 1.0f);      // b0
+    }
+}
+
+void CBiquadCascadeBank::SetCoefficients(size_t _channel, const float* _coefficients)
+{
+    for (size_t stage = 0; stage < numberOfStages; stage++) {
+        for (size_t c = 0; c < 5; c++) { coefficients[(stage * 5 + c) * numberOfLanes + _channel] = _coefficients[stage * 5 + c]; }
+    }
+}
+
+void CBiquadCascadeBank::SetInput(size_t _channel, const float* _input)
+{
+    float* lane = &samples[_channel];
+    for (size_t frame = 0; frame < numberOfFrames; frame++) { lane[frame * numberOfLanes] = _input[frame]; }
+}
+
+void CBiquadCascadeBank::Process()
+{
+    kernels->ProcessBiquadLanes(samples.data(), numberOfFrames, numberOfLanes, coefficients.data(), states.data(), numberOfStages);
+}
+
+void CBiquadCascadeBank::GetOutput(size_t _channel, float* _output) const
+{
+    const float* lane = &samples[_channel];
+    for (size_t frame = 0; frame < numberOfFrames; frame++) { _output[frame] = lane[frame * numberOfLanes]; }
+}
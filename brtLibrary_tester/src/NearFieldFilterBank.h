@@ -0,0 +1,122 @@
+/**
+*
+* \brief Near field ILD filters: coefficient lookup table and biquad cascades of many sources in SIMD lanes. Prototype only,
+* measured by the near field stress test: the library listeners still ask the ILD for their coefficients every block
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _NEARFIELDFILTERBANK_H_
+#define _NEARFIELDFILTERBANK_H_
+
+#include <memory>
+#include <vector>
+#include <BRTLibrary.h>
+#include "AudioKernels.h"
+
+#define NEARFIELD_STAGES                2           // Biquads of the near field ILD filter of each ear
+#define NEARFIELD_COEFFICIENTS          (5 * NEARFIELD_STAGES)     // b0 b1 b2 a1 a2 of each stage, as the ILD returns them
+#define NEARFIELD_TABLE_MIN_DISTANCE    0.1f        // Meters. Closer sources use the coefficients of this distance
+#define NEARFIELD_TABLE_MAX_DISTANCE    2.0f        // Meters. Farther sources use the coefficients of this distance
+#define NEARFIELD_TABLE_DISTANCE_STEP   0.05f
+#define NEARFIELD_TABLE_AZIMUTH_STEP    2.0f        // Degrees of interaural azimuth, from -90 to 90
+
+/** \brief Near field ILD filter coefficients of both ears precomputed on a grid of distance and interaural azimuth, so a source
+*	gets its coefficients with a bilinear interpolation instead of asking the ILD every block. Neighbouring grid points have close
+*	responses, so the interpolated biquads stay stable. Not used by the library listeners.
+*/
+class CILDCoefficientTable {
+public:
+    CILDCoefficientTable();
+
+    /** \brief Asks the ILD for the coefficients of every grid point. Allocates
+    *	\param [in] _ild
+    *	\retval false if the ILD does not give NEARFIELD_COEFFICIENTS coefficients
+    */
+    bool Build(const std::shared_ptr<BRTServices::CILD>& _ild);
+
+    bool IsBuilt() const { return !coefficients.empty(); }
+
+    /** \brief Interpolated coefficients. Real-time safe
+    *	\param [in] _ear Common::LEFT or Common::RIGHT
+    *	\param [in] _distance meters, clamped to the table
+    *	\param [in] _interauralAzimuth degrees, clamped to -90 to 90
+    *	\param [out] _coefficients NEARFIELD_COEFFICIENTS values
+    */
+    void Lookup(Common::T_ear _ear, float _distance, float _interauralAzimuth, float* _coefficients) const;
+
+    size_t GetMemoryBytes() const { return coefficients.size() * sizeof(float); }
+
+private:
+    const float* GetPoint(int _ear, int _distanceIndex, int _azimuthIndex) const {
+        return &coefficients[((size_t)(_ear * distanceSteps + _distanceIndex) * azimuthSteps + _azimuthIndex) * NEARFIELD_COEFFICIENTS];
+    }
+
+    int distanceSteps;
+    int azimuthSteps;
+    std::vector<float> coefficients;                // [ear][distance][azimuth][coefficient]
+};
+
+/** \brief Biquad cascades of many channels (a source ear each), processed together in SIMD lanes by ProcessBiquadLanes.
+*	Channels are copied in and out of a frame-major buffer. Everything is allocated in Setup. Not used by the library listeners.
+*/
+class CBiquadCascadeBank {
+public:
+    CBiquadCascadeBank();
+
+    /** \brief Allocates the lanes, with pass-through coefficients and clear states
+    *	\param [in] _numberOfChannels
+    *	\param [in] _numberOfFrames samples per block
+    *	\param [in] _numberOfStages biquads per channel
+    */
+    void Setup(size_t _numberOfChannels, size_t _numberOfFrames, size_t _numberOfStages = NEARFIELD_STAGES);
+
+    /** \brief Sets the coefficients of a channel, kept until changed
+    *	\param [in] _channel
+    *	\param [in] _coefficients b0 b1 b2 a1 a2 of each stage
+    */
+    void SetCoefficients(size_t _channel, const float* _coefficients);
+
+    /** \brief Copies the block of a channel in
+    */
+    void SetInput(size_t _channel, const float* _input);
+
+    /** \brief Filters the block of every channel
+    */
+    void Process();
+
+    /** \brief Copies the filtered block of a channel out
+    */
+    void GetOutput(size_t _channel, float* _output) const;
+
+    size_t GetNumberOfChannels() const { return numberOfChannels; }
+
+private:
+    size_t numberOfChannels;
+    size_t numberOfLanes;                           // Channels rounded up to 8, so all of them go in SIMD registers
+    size_t numberOfFrames;
+    size_t numberOfStages;
+    std::vector<float> samples;                     // [frame][lane]
+    std::vector<float> coefficients;                // [stage][coefficient][lane]
+    std::vector<float> states;                      // [stage][state][lane]
+    const TAudioKernels* kernels;
+};
+
+#endif
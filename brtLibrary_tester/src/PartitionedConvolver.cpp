@@ -0,0 +1,367 @@
+/**
+*
+* \brief Uniform and non-uniform partitioned convolution of a mono input with a pair of filters
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "PartitionedConvolver.h"
+#include "RealTimeWorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+//////////////////////////////
+// Filter
+//////////////////////////////
+
+CPartitionedFilter::CPartitionedFilter() : blockSize(0), numberOfPartitions(0)
+{
+}
+
+void CPartitionedFilter::Setup(size_t _blockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, TSpectrumStorage _storage, CRealFFT* _fft)
+{
+    std::unique_ptr<CRealFFT> ownFFT;
+    if (_fft == nullptr) {
+        ownFFT.reset(new CRealFFT(2 * _blockSize));
+        _fft = ownFFT.get();
+    }
+    blockSize = _blockSize;
+    numberOfPartitions = std::max<size_t>(1, (_filterLength + blockSize - 1) / blockSize);
+    size_t spectrumSize = _fft->GetSpectrumSize();
+
+    // Each partition is zero padded to two blocks, so the circular convolution of overlap-save does not wrap into the kept half
+    leftPartitions.Setup(_storage, numberOfPartitions, spectrumSize);
+    rightPartitions.Setup(_storage, numberOfPartitions, spectrumSize);
+    std::vector<float> padded(2 * blockSize);
+    std::vector<float> spectrum(spectrumSize);
+    for (size_t p = 0; p < numberOfPartitions; p++) {
+        size_t first = p * blockSize;
+        size_t length = (first < _filterLength) ? std::min(blockSize, _filterLength - first) : 0;
+        std::fill(padded.begin(), padded.end(), 0.0f);
+        if (length > 0) { std::copy(_leftFilter + first, _leftFilter + first + length, padded.begin()); }
+        _fft->Forward(padded.data(), spectrum.data());
+        leftPartitions.Store(p, spectrum.data());
+        std::fill(padded.begin(), padded.end(), 0.0f);
+        if (length > 0) { std::copy(_rightFilter + first, _rightFilter + first + length, padded.begin()); }
+        _fft->Forward(padded.data(), spectrum.data());
+        rightPartitions.Store(p, spectrum.data());
+    }
+}
+
+void CPartitionedFilter::SetupFromSpectra(size_t _blockSize, size_t _numberOfPartitions, const float* _leftSpectra, const float* _rightSpectra, TSpectrumStorage _storage)
+{
+    blockSize = _blockSize;
+    numberOfPartitions = _numberOfPartitions;
+    size_t spectrumSize = 2 * _blockSize + 2;                   // Floats of the spectrum of 2 * _blockSize samples
+    leftPartitions.Setup(_storage, numberOfPartitions, spectrumSize);
+    rightPartitions.Setup(_storage, numberOfPartitions, spectrumSize);
+    for (size_t p = 0; p < numberOfPartitions; p++) {
+        leftPartitions.Store(p, _leftSpectra + p * spectrumSize);
+        rightPartitions.Store(p, _rightSpectra + p * spectrumSize);
+    }
+}
+
+//////////////////////////////
+// Uniform
+//////////////////////////////
+
+//////////////////////////////
+// Spectrum delay line
+//////////////////////////////
+
+CSpectrumDelayLine::CSpectrumDelayLine() : blockSize(0), numberOfPartitions(1), spectrumSize(0), head(0)
+{
+}
+
+void CSpectrumDelayLine::Setup(size_t _blockSize, size_t _numberOfPartitions)
+{
+    blockSize = _blockSize;
+    numberOfPartitions = std::max<size_t>(1, _numberOfPartitions);
+    fft.reset(new CRealFFT(2 * blockSize));
+    spectrumSize = fft->GetSpectrumSize();
+    spectra.assign(numberOfPartitions * spectrumSize, 0.0f);
+    inputWindow.assign(2 * blockSize, 0.0f);
+    head = numberOfPartitions - 1;                  // The first Push writes slot 0
+}
+
+void CSpectrumDelayLine::Push(const float* _input)
+{
+    head = (head + 1) % numberOfPartitions;
+    memmove(inputWindow.data(), inputWindow.data() + blockSize, blockSize * sizeof(float));
+    memcpy(inputWindow.data() + blockSize, _input, blockSize * sizeof(float));
+    fft->Forward(inputWindow.data(), &spectra[head * spectrumSize]);
+}
+
+void CSpectrumDelayLine::Reset()
+{
+    std::fill(spectra.begin(), spectra.end(), 0.0f);
+    std::fill(inputWindow.begin(), inputWindow.end(), 0.0f);
+    head = numberOfPartitions - 1;
+}
+
+//////////////////////////////
+// Uniform convolver
+//////////////////////////////
+
+CUniformPartitionedConvolver::CUniformPartitionedConvolver() : blockSize(0), numberOfPartitions(0), spectrumSize(0), kernels(&GetGenericKernels()), filter(nullptr), nextFilter(nullptr),
+    crossfadeNext(false), crossfades(0)
+{
+}
+
+void CUniformPartitionedConvolver::Setup(size_t _blockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, TSpectrumStorage _storage)
+{
+    ownFilter.Setup(_blockSize, _leftFilter, _rightFilter, _filterLength, _storage);
+    Setup(_blockSize, ownFilter.GetNumberOfPartitions());
+    SetFilter(&ownFilter, false);
+}
+
+void CUniformPartitionedConvolver::Setup(size_t _blockSize, size_t _maxPartitions, bool _sharedInput)
+{
+    blockSize = _blockSize;
+    numberOfPartitions = std::max<size_t>(1, _maxPartitions);
+    fft.reset(new CRealFFT(2 * blockSize));
+    spectrumSize = fft->GetSpectrumSize();
+    kernels = &fft->GetKernels();
+    filter = nullptr;
+    nextFilter = nullptr;
+    crossfadeNext = false;
+    crossfades = 0;
+
+    fadeIn.resize(blockSize);
+    for (size_t i = 0; i < blockSize; i++) { fadeIn[i] = (float)(i + 1) / blockSize; }
+    if (_sharedInput) { delayLine = CSpectrumDelayLine(); }
+    else { delayLine.Setup(blockSize, numberOfPartitions); }
+    accumulator.assign(spectrumSize, 0.0f);
+    expandedPartition.assign(spectrumSize, 0.0f);
+    timeOutput.assign(2 * blockSize, 0.0f);
+    fadeOutput.assign(2 * blockSize, 0.0f);
+}
+
+bool CUniformPartitionedConvolver::SetFilter(const CPartitionedFilter* _filter, bool _crossfade)
+{
+    if (_filter == nullptr || _filter->GetBlockSize() != blockSize || _filter->GetNumberOfPartitions() > numberOfPartitions) { return false; }
+    nextFilter = _filter;
+    crossfadeNext = _crossfade && filter != nullptr;
+    return true;
+}
+
+void CUniformPartitionedConvolver::Reset()
+{
+    delayLine.Reset();
+}
+
+void CUniformPartitionedConvolver::Convolve(const CSpectrumDelayLine& _input, const CPartitionedFilter& _filter, int _ear, float* _output)
+{
+    const CCompactSpectra& partitions = _filter.GetPartitions(_ear);
+    size_t bins = spectrumSize / 2;
+    std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+    for (size_t p = 0; p < _filter.GetNumberOfPartitions(); p++) {              // Partition p meets the input spectrum of p blocks ago
+        const float* partition = partitions.Read(p, expandedPartition.data());    // Expanded while it is in cache
+        kernels->ComplexMultiplyAccumulate(_input.GetSpectrum(p), partition, accumulator.data(), bins);
+    }
+    fft->Inverse(accumulator.data(), _output);
+}
+
+void CUniformPartitionedConvolver::Process(const float* _input, float* _leftOutput, float* _rightOutput)
+{
+    delayLine.Push(_input);
+    ProcessSpectra(delayLine, _leftOutput, _rightOutput);
+}
+
+void CUniformPartitionedConvolver::ProcessSpectra(const CSpectrumDelayLine& _input, float* _leftOutput, float* _rightOutput)
+{
+    const CPartitionedFilter* oldFilter = (nextFilter != filter && crossfadeNext) ? filter : nullptr;
+    filter = nextFilter;
+    if (filter == nullptr) {
+        std::fill(_leftOutput, _leftOutput + blockSize, 0.0f);
+        std::fill(_rightOutput, _rightOutput + blockSize, 0.0f);
+    }
+    else {
+        float* outputs[2] = { _leftOutput, _rightOutput };
+        for (int ear = 0; ear < 2; ear++) {
+            Convolve(_input, *filter, ear, timeOutput.data());
+            const float* newOutput = timeOutput.data() + blockSize;                  // The first half is aliased
+            if (oldFilter == nullptr) {
+                memcpy(outputs[ear], newOutput, blockSize * sizeof(float));
+                continue;
+            }
+            Convolve(_input, *oldFilter, ear, fadeOutput.data());
+            const float* oldOutput = fadeOutput.data() + blockSize;
+            kernels->Crossfade(oldOutput, newOutput, fadeIn.data(), outputs[ear], blockSize);
+        }
+        if (oldFilter != nullptr) { crossfades++; }
+    }
+}
+
+//////////////////////////////
+// Tail worker
+//////////////////////////////
+
+CConvolutionTailWorker::CConvolutionTailWorker() : running(false), stopRequested(false)
+{
+}
+
+CConvolutionTailWorker::~CConvolutionTailWorker()
+{
+    Stop();
+}
+
+void CConvolutionTailWorker::Start()
+{
+    if (IsRunning()) { return; }
+    stopRequested.store(false, std::memory_order_relaxed);
+    thread = std::thread(&CConvolutionTailWorker::WorkerLoop, this);
+    running.store(true, std::memory_order_release);
+}
+
+void CConvolutionTailWorker::Stop()
+{
+    if (!IsRunning()) { return; }
+    stopRequested.store(true, std::memory_order_release);
+    thread.join();
+    running.store(false, std::memory_order_release);          // The thread is gone: from here on, Process computes the tails itself
+}
+
+void CConvolutionTailWorker::Add(CNonUniformPartitionedConvolver* _convolver)
+{
+    bool wasRunning = IsRunning();
+    Stop();
+    if (std::find(convolvers.begin(), convolvers.end(), _convolver) == convolvers.end()) { convolvers.push_back(_convolver); }
+    if (wasRunning) { Start(); }
+}
+
+void CConvolutionTailWorker::Remove(CNonUniformPartitionedConvolver* _convolver)
+{
+    bool wasRunning = IsRunning();
+    Stop();
+    convolvers.erase(std::remove(convolvers.begin(), convolvers.end(), _convolver), convolvers.end());
+    if (wasRunning) { Start(); }
+}
+
+void CConvolutionTailWorker::WorkerLoop()
+{
+    int idleIterations = 0;
+    while (!stopRequested.load(std::memory_order_acquire)) {
+        bool worked = false;
+        for (CNonUniformPartitionedConvolver* convolver : convolvers) { worked = convolver->ProcessPendingTail() || worked; }
+        if (worked) { idleIterations = 0; }
+        else if (++idleIterations < SPIN_ITERATIONS) { CpuRelax(); }
+        else if (idleIterations < 2 * SPIN_ITERATIONS) { std::this_thread::yield(); }
+        else { std::this_thread::sleep_for(std::chrono::microseconds(50)); }
+    }
+}
+
+//////////////////////////////
+// Non-uniform
+//////////////////////////////
+
+CNonUniformPartitionedConvolver::CNonUniformPartitionedConvolver() : hasTail(false), tailBlockSize(0), tailPosition(0), tailBlocks(0),
+    requestedTails(0), completedTails(0), tailWorker(nullptr), lateTails(0)
+{
+}
+
+CNonUniformPartitionedConvolver::~CNonUniformPartitionedConvolver()
+{
+    if (tailWorker != nullptr) { tailWorker->Remove(this); }
+}
+
+bool CNonUniformPartitionedConvolver::Setup(size_t _blockSize, size_t _tailBlockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, CConvolutionTailWorker* _tailWorker,
+    TSpectrumStorage _storage)
+{
+    if (_tailBlockSize == 0) { _tailBlockSize = _blockSize * CONVOLVER_TAIL_BLOCK_FACTOR; }
+    if (_blockSize == 0 || (_blockSize & (_blockSize - 1)) != 0 || _tailBlockSize < _blockSize || _tailBlockSize % _blockSize != 0 ||
+        (_tailBlockSize & (_tailBlockSize - 1)) != 0) { return false; }
+
+    if (tailWorker != nullptr) { tailWorker->Remove(this); }
+    tailWorker = nullptr;
+
+    // The tail output of the block ending at sample n is needed from n + tailBlockSize: the head covers 2 tail blocks of taps
+    tailBlockSize = _tailBlockSize;
+    size_t headLength = std::min(_filterLength, 2 * tailBlockSize);
+    head.Setup(_blockSize, _leftFilter, _rightFilter, headLength, _storage);
+    hasTail = _filterLength > headLength;
+    if (hasTail) { tail.Setup(tailBlockSize, _leftFilter + headLength, _rightFilter + headLength, _filterLength - headLength, _storage); }
+
+    for (int i = 0; i < 2; i++) {
+        tailInput[i].assign(tailBlockSize, 0.0f);
+        tailLeftOutput[i].assign(tailBlockSize, 0.0f);
+        tailRightOutput[i].assign(tailBlockSize, 0.0f);
+    }
+    tailPosition = 0;
+    tailBlocks = 0;
+    requestedTails.store(0, std::memory_order_relaxed);
+    completedTails.store(0, std::memory_order_relaxed);
+    lateTails = 0;
+
+    if (hasTail && _tailWorker != nullptr) {
+        tailWorker = _tailWorker;
+        tailWorker->Add(this);
+    }
+    return true;
+}
+
+bool CNonUniformPartitionedConvolver::ProcessPendingTail()
+{
+    size_t completed = completedTails.load(std::memory_order_relaxed);       // Only written here, by one thread at a time
+    if (requestedTails.load(std::memory_order_acquire) <= completed) { return false; }
+    int buffer = completed % 2;
+    tail.Process(tailInput[buffer].data(), tailLeftOutput[buffer].data(), tailRightOutput[buffer].data());
+    completedTails.store(completed + 1, std::memory_order_release);
+    return true;
+}
+
+void CNonUniformPartitionedConvolver::Process(const float* _input, float* _leftOutput, float* _rightOutput)
+{
+    head.Process(_input, _leftOutput, _rightOutput);
+    if (!hasTail) { return; }
+
+    size_t blockSize = head.GetBlockSize();
+    if (tailPosition == 0 && tailBlocks > 0) {
+        // Tail block tailBlocks - 1 is complete: hand it over, after making sure the previous one, whose output starts now, is done
+        size_t previous = tailBlocks - 1;
+        if (completedTails.load(std::memory_order_acquire) < previous) {
+            bool background = tailWorker != nullptr && tailWorker->IsRunning();
+            if (background) { lateTails++; }
+            while (completedTails.load(std::memory_order_acquire) < previous) {
+                if (background && tailWorker->IsRunning()) { CpuRelax(); }
+                else { ProcessPendingTail(); }
+            }
+        }
+        requestedTails.store(tailBlocks, std::memory_order_release);
+        if (tailWorker == nullptr || !tailWorker->IsRunning()) { ProcessPendingTail(); }
+    }
+
+    // Output of tail block tailBlocks - 2, computed during the last tail block
+    if (tailBlocks >= 2) {
+        int buffer = (tailBlocks - 2) % 2;
+        for (size_t i = 0; i < blockSize; i++) {
+            _leftOutput[i] += tailLeftOutput[buffer][tailPosition + i];
+            _rightOutput[i] += tailRightOutput[buffer][tailPosition + i];
+        }
+    }
+
+    memcpy(&tailInput[tailBlocks % 2][tailPosition], _input, blockSize * sizeof(float));
+    tailPosition += blockSize;
+    if (tailPosition == tailBlockSize) {
+        tailPosition = 0;
+        tailBlocks++;
+    }
+}
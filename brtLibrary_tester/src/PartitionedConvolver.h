@@ -0,0 +1,298 @@
+/**
+*
+* \brief Uniform and non-uniform partitioned convolution of a mono input with a pair of filters. Prototype only: the library
+* render path keeps its own convolvers, so the latency these classes would allow is not realised by the tester
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#ifndef _PARTITIONEDCONVOLVER_H_
+#define _PARTITIONEDCONVOLVER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "FFT.h"
+#include "CompactSpectra.h"
+
+#define CONVOLVER_TAIL_BLOCK_FACTOR     8           // Tail partitions are this many blocks long by default
+
+/** \brief Spectra of the partitions of a left and a right filter, each partition zero padded to two blocks, ready to be used by
+*	a CUniformPartitionedConvolver of the same block size. Many convolvers can share one filter.
+*/
+class CPartitionedFilter {
+public:
+    CPartitionedFilter();
+
+    /** \brief Computes the spectra of the partitions
+    *	\param [in] _blockSize samples per partition, a power of two
+    *	\param [in] _leftFilter
+    *	\param [in] _rightFilter
+    *	\param [in] _filterLength samples of each filter
+    *	\param [in] _storage format the spectra are kept in
+    *	\param [in] _fft transform of 2 * _blockSize samples to use, nullptr to create one
+    */
+    void Setup(size_t _blockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, TSpectrumStorage _storage = SPECTRUM_STORAGE_FLOAT32,
+        CRealFFT* _fft = nullptr);
+
+    /** \brief Takes spectra computed earlier by Setup, such as those of a cache file, without transforming anything
+    *	\param [in] _blockSize samples per partition
+    *	\param [in] _numberOfPartitions
+    *	\param [in] _leftSpectra _numberOfPartitions spectra of 2 * _blockSize samples, one after another
+    *	\param [in] _rightSpectra
+    *	\param [in] _storage format the spectra are kept in
+    */
+    void SetupFromSpectra(size_t _blockSize, size_t _numberOfPartitions, const float* _leftSpectra, const float* _rightSpectra, TSpectrumStorage _storage = SPECTRUM_STORAGE_FLOAT32);
+
+    size_t GetBlockSize() const { return blockSize; }
+    size_t GetNumberOfPartitions() const { return numberOfPartitions; }
+    const CCompactSpectra& GetPartitions(int _ear) const { return _ear == 0 ? leftPartitions : rightPartitions; }
+    size_t GetMemoryBytes() const { return leftPartitions.GetMemoryBytes() + rightPartitions.GetMemoryBytes(); }
+
+private:
+    size_t blockSize;
+    size_t numberOfPartitions;
+    CCompactSpectra leftPartitions;
+    CCompactSpectra rightPartitions;
+};
+
+/** \brief Spectra of the last input windows of a mono signal (previous block and current block), newest first: the frequency
+*	domain delay line of a uniformly partitioned convolution. One delay line can feed every convolver of the same signal, so the
+*	input is transformed once per block whatever the number of filters it is convolved with.
+*/
+class CSpectrumDelayLine {
+public:
+    CSpectrumDelayLine();
+
+    /** \brief Allocates the delay line and its transform
+    *	\param [in] _blockSize samples per block, a power of two
+    *	\param [in] _numberOfPartitions spectra kept, the partitions of the longest filter convolved with it
+    */
+    void Setup(size_t _blockSize, size_t _numberOfPartitions);
+
+    /** \brief Transforms the window ending with a new block. Does not allocate
+    *	\param [in] _input block size samples
+    */
+    void Push(const float* _input);
+
+    /** \brief Spectrum of the window that ended _blocksAgo blocks ago, 0 for the newest
+    *	\param [in] _blocksAgo less than the number of partitions
+    */
+    const float* GetSpectrum(size_t _blocksAgo) const {
+        size_t slot = (_blocksAgo <= head) ? head - _blocksAgo : head + numberOfPartitions - _blocksAgo;
+        return &spectra[slot * spectrumSize];
+    }
+
+    /** \brief Clears the input history
+    */
+    void Reset();
+
+    size_t GetBlockSize() const { return blockSize; }
+    size_t GetNumberOfPartitions() const { return numberOfPartitions; }
+    size_t GetSpectrumSize() const { return spectrumSize; }
+
+private:
+    size_t blockSize;
+    size_t numberOfPartitions;
+    size_t spectrumSize;
+    std::unique_ptr<CRealFFT> fft;
+    std::vector<float> spectra;                     // numberOfPartitions spectra, as a ring
+    size_t head;                                    // Slot of the newest spectrum
+    std::vector<float> inputWindow;                 // Previous block and current block
+};
+
+/** \brief Uniformly partitioned overlap-save convolution of a mono input with a left and a right filter, with a frequency domain
+*	delay line: each block costs one FFT of the input, one multiply-accumulate per partition and ear, and one inverse FFT per ear.
+*	The output has no latency beyond the block itself.
+*	\details The delay line holds the input only, so the filter can be replaced between blocks without losing the history. The
+*	block after a change is computed with both filters and the outputs are crossfaded linearly over the block. The delay line
+*	may also be one shared by several convolvers of the same input (ProcessSpectra).
+*/
+class CUniformPartitionedConvolver {
+public:
+    CUniformPartitionedConvolver();
+
+    /** \brief Computes the spectra of the filter partitions, kept by the convolver, and allocates everything Process needs
+    *	\param [in] _blockSize samples per block and per partition, a power of two
+    *	\param [in] _leftFilter
+    *	\param [in] _rightFilter
+    *	\param [in] _filterLength samples of each filter
+    *	\param [in] _storage format the partition spectra are kept in
+    */
+    void Setup(size_t _blockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, TSpectrumStorage _storage = SPECTRUM_STORAGE_FLOAT32);
+
+    /** \brief Allocates everything Process needs to convolve with filters set later with SetFilter
+    *	\param [in] _blockSize samples per block and per partition, a power of two
+    *	\param [in] _maxPartitions partitions of the longest filter
+    *	\param [in] _sharedInput the input comes only from delay lines given to ProcessSpectra, so no delay line of its own is allocated
+    */
+    void Setup(size_t _blockSize, size_t _maxPartitions, bool _sharedInput = false);
+
+    /** \brief Changes the filter from the next block on. Constant time and real-time safe
+    *	\param [in] _filter with the block size of the convolver and at most its maximum number of partitions; it must outlive its use
+    *	\param [in] _crossfade crossfade from the current filter over the next block, or switch at once
+    *	\retval false if the filter does not fit, the current one is kept
+    */
+    bool SetFilter(const CPartitionedFilter* _filter, bool _crossfade = true);
+
+    /** \brief Convolves one block. Does not allocate
+    *	\param [in] _input block size samples
+    *	\param [out] _leftOutput block size samples
+    *	\param [out] _rightOutput block size samples
+    */
+    void Process(const float* _input, float* _leftOutput, float* _rightOutput);
+
+    /** \brief Convolves the newest block of a delay line, which may be shared with other convolvers and is only read. Does not allocate
+    *	\param [in] _input with the block size of the convolver and at least the partitions of its filters, already pushed this block
+    *	\param [out] _leftOutput block size samples
+    *	\param [out] _rightOutput block size samples
+    */
+    void ProcessSpectra(const CSpectrumDelayLine& _input, float* _leftOutput, float* _rightOutput);
+
+    /** \brief Clears the input history
+    */
+    void Reset();
+
+    size_t GetBlockSize() const { return blockSize; }
+    size_t GetNumberOfPartitions() const { return numberOfPartitions; }
+    size_t GetFilterMemoryBytes() const { return ownFilter.GetMemoryBytes(); }
+    size_t GetNumberOfCrossfades() const { return crossfades; }
+
+private:
+    /// Sum of the partitions of a filter times the input spectra, in the time domain, for one ear. The last block samples are valid
+    void Convolve(const CSpectrumDelayLine& _input, const CPartitionedFilter& _filter, int _ear, float* _output);
+
+    size_t blockSize;
+    size_t numberOfPartitions;                      // Partitions of the longest filter
+    size_t spectrumSize;
+    std::unique_ptr<CRealFFT> fft;
+    const TFixedSizeKernels* kernels;               // Of the block size, chosen at setup
+    CPartitionedFilter ownFilter;                   // Filter of the first Setup
+    const CPartitionedFilter* filter;
+    const CPartitionedFilter* nextFilter;
+    bool crossfadeNext;
+    size_t crossfades;
+    std::vector<float> fadeIn;                      // Gain of the new filter over the crossfade block
+    std::vector<float> expandedPartition;           // Compact partition being multiplied
+    CSpectrumDelayLine delayLine;                   // Input of Process, empty with a shared input
+    std::vector<float> accumulator;
+    std::vector<float> timeOutput;
+    std::vector<float> fadeOutput;                  // Output of the old filter during a crossfade
+};
+
+class CNonUniformPartitionedConvolver;
+
+/** \brief Thread that computes the tail partitions of non-uniform convolvers ahead of the audio thread. The audio thread never
+*	blocks on it unless a tail is late; the worker spins, then yields and then polls with short sleeps while idle.
+*/
+class CConvolutionTailWorker {
+public:
+    CConvolutionTailWorker();
+    ~CConvolutionTailWorker();
+
+    /** \brief Starts the thread, which serves the convolvers set up with this worker. Setting up or destroying one of them pauses it
+    */
+    void Start();
+
+    /** \brief Stops the thread, tails are then computed by the audio thread
+    */
+    void Stop();
+
+    bool IsRunning() const { return running.load(std::memory_order_acquire); }
+
+private:
+    friend class CNonUniformPartitionedConvolver;
+
+    void Add(CNonUniformPartitionedConvolver* _convolver);
+    void Remove(CNonUniformPartitionedConvolver* _convolver);
+    void WorkerLoop();
+
+    static const int SPIN_ITERATIONS = 4096;
+
+    std::vector<CNonUniformPartitionedConvolver*> convolvers;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<bool> stopRequested;
+};
+
+/** \brief Non-uniformly partitioned convolution: the first taps of the filters are convolved block by block with short partitions
+*	(the head), and the rest with long partitions of tailBlockSize samples (the tail), so the latency is one short block while the
+*	cost per sample is close to that of the long partitions.
+*	Prototype only, measured by the convolver benchmark: the tester renders with the library convolvers and still needs the
+*	buffer sizes those allow (2048 samples recommended on Linux).
+*	\details The head covers the first 2 tailBlockSize taps. The tail is a uniform convolver of the remaining taps, run once every
+*	tailBlockSize samples on the input gathered meanwhile; its output is needed one tail block later, so it can be computed in the
+*	audio thread at once or by a CConvolutionTailWorker during the next tail block. Tail inputs and outputs are double buffered.
+*/
+class CNonUniformPartitionedConvolver {
+public:
+    CNonUniformPartitionedConvolver();
+    ~CNonUniformPartitionedConvolver();
+
+    /** \brief Prepares the head and tail convolvers
+    *	\param [in] _blockSize samples per Process call, a power of two
+    *	\param [in] _tailBlockSize samples of the tail partitions, a power of two multiple of _blockSize. 0 uses CONVOLVER_TAIL_BLOCK_FACTOR blocks
+    *	\param [in] _leftFilter
+    *	\param [in] _rightFilter
+    *	\param [in] _filterLength
+    *	\param [in] _tailWorker thread that computes the tail, nullptr to compute it in Process
+    *	\param [in] _storage format the partition spectra are kept in
+    *	\retval false if the sizes are not valid
+    */
+    bool Setup(size_t _blockSize, size_t _tailBlockSize, const float* _leftFilter, const float* _rightFilter, size_t _filterLength, CConvolutionTailWorker* _tailWorker = nullptr,
+        TSpectrumStorage _storage = SPECTRUM_STORAGE_FLOAT32);
+
+    /** \brief Convolves one block. Does not allocate
+    */
+    void Process(const float* _input, float* _leftOutput, float* _rightOutput);
+
+    size_t GetBlockSize() const { return head.GetBlockSize(); }
+    size_t GetTailBlockSize() const { return tailBlockSize; }
+    size_t GetNumberOfHeadPartitions() const { return head.GetNumberOfPartitions(); }
+    size_t GetNumberOfTailPartitions() const { return hasTail ? tail.GetNumberOfPartitions() : 0; }
+
+    /** \brief Number of times Process had to wait for the tail worker
+    */
+    size_t GetLateTails() const { return lateTails; }
+    size_t GetFilterMemoryBytes() const { return head.GetFilterMemoryBytes() + (hasTail ? tail.GetFilterMemoryBytes() : 0); }
+
+private:
+    friend class CConvolutionTailWorker;
+
+    /// Convolves the next requested tail block. Called by the tail worker, or by Process without one
+    bool ProcessPendingTail();
+
+    CUniformPartitionedConvolver head;
+    CUniformPartitionedConvolver tail;
+    bool hasTail;
+    size_t tailBlockSize;
+    size_t tailPosition;                            // Samples of the current tail block received so far
+    size_t tailBlocks;                              // Tail blocks completed by Process
+    std::vector<float> tailInput[2];
+    std::vector<float> tailLeftOutput[2];
+    std::vector<float> tailRightOutput[2];
+    std::atomic<size_t> requestedTails;             // Tail blocks handed over for computing
+    std::atomic<size_t> completedTails;
+    CConvolutionTailWorker* tailWorker;
+    size_t lateTails;
+};
+
+#endif
@@ -0,0 +1,108 @@
+/**
+*
+* \brief Statistics of per-block processing times
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _PROCESSINGSTATISTICS_HPP_
+#define _PROCESSINGSTATISTICS_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** \brief Summary of a set of block processing times, in milliseconds
+*/
+struct TTimingStatistics {
+    size_t numberOfBlocks = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    double deadline = 0;                    // Time available to process one block (buffer size / sample rate)
+    size_t blocksOverDeadline = 0;
+};
+
+/** \brief Measures elapsed time with the steady clock, which is cheap enough to be read from the audio thread
+*/
+class CStopwatch {
+public:
+    CStopwatch() : start(std::chrono::steady_clock::now()) {}
+    void Restart() { start = std::chrono::steady_clock::now(); }
+    double GetElapsedMilliseconds() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); }
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+/** \brief Computes percentiles and deadline misses of a set of block processing times
+*	\param [in] _blockTimes processing time of each block in milliseconds (it is sorted in place)
+*	\param [in] _deadline time available per block in milliseconds
+*	\retval statistics
+*/
+inline TTimingStatistics ComputeTimingStatistics(std::vector<double>& _blockTimes, double _deadline) {
+    TTimingStatistics statistics;
+    statistics.deadline = _deadline;
+    statistics.numberOfBlocks = _blockTimes.size();
+    if (_blockTimes.empty()) { return statistics; }
+
+    std::sort(_blockTimes.begin(), _blockTimes.end());
+    auto percentile = [&_blockTimes](double _percent) {
+        size_t index = (size_t)std::min<double>((double)_blockTimes.size() - 1, std::ceil(_percent / 100.0 * _blockTimes.size()) - 1);
+        return _blockTimes[index];
+    };
+    double sum = 0;
+    for (double time : _blockTimes) {
+        sum += time;
+        if (time > _deadline) { statistics.blocksOverDeadline++; }
+    }
+    statistics.mean = sum / _blockTimes.size();
+    statistics.p50 = percentile(50);
+    statistics.p90 = percentile(90);
+    statistics.p99 = percentile(99);
+    statistics.max = _blockTimes.back();
+    return statistics;
+}
+
+/** \brief Prints the header of the table written by PrintTimingStatisticsRow
+*	\param [in] _firstColumn title of the first column
+*/
+inline void PrintTimingStatisticsHeader(const std::string& _firstColumn) {
+    char line[256];
+    snprintf(line, sizeof(line), "%12s %10s %10s %10s %10s %10s %10s %8s %8s", _firstColumn.c_str(), "mean ms", "p50 ms", "p90 ms", "p99 ms", "max ms", "deadline", "load %", "misses");
+    std::cout << line << std::endl;
+}
+
+/** \brief Prints one row of timing statistics, load is the median time relative to the deadline
+*	\param [in] _firstColumn value of the first column
+*	\param [in] _statistics
+*/
+inline void PrintTimingStatisticsRow(const std::string& _firstColumn, const TTimingStatistics& _statistics) {
+    char line[256];
+    double load = _statistics.deadline > 0 ? 100.0 * _statistics.p50 / _statistics.deadline : 0;
+    snprintf(line, sizeof(line), "%12s %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f %8.1f %8zu", _firstColumn.c_str(), _statistics.mean, _statistics.p50, _statistics.p90,
+        _statistics.p99, _statistics.max, _statistics.deadline, load, _statistics.blocksOverDeadline);
+    std::cout << line << std::endl;
+}
+
+#endif
@@ -0,0 +1,222 @@
+/**
+*
+* \brief Detector of heap allocations made from the real-time audio thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#include "RTAllocationDetector.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(BRT_TESTER_RT_ALLOCATION_DETECTOR) && defined(__GLIBC__)
+#define RT_ALLOCATION_DETECTOR_HOOKS_MALLOC
+// glibc allocator entry points, called by the interposed malloc family so that the hooks do not call themselves
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+}
+#endif
+
+namespace {
+    thread_local bool insideRealTimeScope = false;                 // Set while the current thread is running the audio path
+    std::atomic<uint64_t> allocationCount(0);
+    std::atomic<uint64_t> deallocationCount(0);
+    std::atomic<bool> abortOnAllocation(false);
+
+#if defined(BRT_TESTER_RT_ALLOCATION_DETECTOR)
+    void OnRealTimeAllocatorCall(std::atomic<uint64_t>& counter, const char* operation)
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (abortOnAllocation.load(std::memory_order_relaxed)) {
+            insideRealTimeScope = false;                           // Avoid recursion if abort() itself allocates
+            std::fputs("RT allocation detector: ", stderr);        // No iostream here, it could allocate
+            std::fputs(operation, stderr);
+            std::fputs(" called from the audio thread\n", stderr);
+            std::abort();
+        }
+    }
+
+#if defined(RT_ALLOCATION_DETECTOR_HOOKS_MALLOC)
+    void* RawAllocate(std::size_t size) { return __libc_malloc(size); }
+    void RawFree(void* pointer) { __libc_free(pointer); }
+#else
+    void* RawAllocate(std::size_t size) { return std::malloc(size); }
+    void RawFree(void* pointer) { std::free(pointer); }
+#endif
+
+    void* RealTimeCheckedAllocate(std::size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "operator new"); }
+        void* pointer = RawAllocate(size == 0 ? 1 : size);
+        if (pointer == nullptr) { throw std::bad_alloc(); }
+        return pointer;
+    }
+
+    void RealTimeCheckedFree(void* pointer)
+    {
+        if (pointer == nullptr) { return; }
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(deallocationCount, "operator delete"); }
+        RawFree(pointer);
+    }
+
+#if defined(__cpp_aligned_new)
+    void* RealTimeCheckedAlignedAllocate(std::size_t size, std::size_t alignment)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "operator new"); }
+        if (size == 0) { size = 1; }
+#if defined(_WIN32)
+        void* pointer = _aligned_malloc(size, alignment);
+#elif defined(RT_ALLOCATION_DETECTOR_HOOKS_MALLOC)
+        void* pointer = __libc_memalign(alignment < sizeof(void*) ? sizeof(void*) : alignment, size);
+#else
+        void* pointer = nullptr;
+        if (posix_memalign(&pointer, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) != 0) { pointer = nullptr; }
+#endif
+        if (pointer == nullptr) { throw std::bad_alloc(); }
+        return pointer;
+    }
+
+    void RealTimeCheckedAlignedFree(void* pointer)
+    {
+        if (pointer == nullptr) { return; }
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(deallocationCount, "operator delete"); }
+#if defined(_WIN32)
+        _aligned_free(pointer);
+#else
+        RawFree(pointer);
+#endif
+    }
+#endif
+#endif
+}
+
+CRTAllocationDetector::CRealTimeScope::CRealTimeScope() : previousState(insideRealTimeScope)
+{
+    insideRealTimeScope = true;
+}
+
+CRTAllocationDetector::CRealTimeScope::~CRealTimeScope()
+{
+    insideRealTimeScope = previousState;
+}
+
+bool CRTAllocationDetector::IsEnabled()
+{
+#if defined(BRT_TESTER_RT_ALLOCATION_DETECTOR)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CRTAllocationDetector::SetAbortOnAllocation(bool _abortOnAllocation) { abortOnAllocation.store(_abortOnAllocation); }
+uint64_t CRTAllocationDetector::GetAllocationCount() { return allocationCount.load(); }
+uint64_t CRTAllocationDetector::GetDeallocationCount() { return deallocationCount.load(); }
+void CRTAllocationDetector::ResetCounters() { allocationCount.store(0); deallocationCount.store(0); }
+
+#if defined(BRT_TESTER_RT_ALLOCATION_DETECTOR)
+//////////////////////////////////////
+// Replacement of the global allocator
+//////////////////////////////////////
+
+void* operator new(std::size_t size) { return RealTimeCheckedAllocate(size); }
+void* operator new[](std::size_t size) { return RealTimeCheckedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { try { return RealTimeCheckedAllocate(size); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { try { return RealTimeCheckedAllocate(size); } catch (...) { return nullptr; } }
+void operator delete(void* pointer) noexcept { RealTimeCheckedFree(pointer); }
+void operator delete[](void* pointer) noexcept { RealTimeCheckedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { RealTimeCheckedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { RealTimeCheckedFree(pointer); }
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* pointer, std::size_t) noexcept { RealTimeCheckedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { RealTimeCheckedFree(pointer); }
+#endif
+#if defined(__cpp_aligned_new)
+void* operator new(std::size_t size, std::align_val_t alignment) { return RealTimeCheckedAlignedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return RealTimeCheckedAlignedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { try { return RealTimeCheckedAlignedAllocate(size, static_cast<std::size_t>(alignment)); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { try { return RealTimeCheckedAlignedAllocate(size, static_cast<std::size_t>(alignment)); } catch (...) { return nullptr; } }
+void operator delete(void* pointer, std::align_val_t) noexcept { RealTimeCheckedAlignedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { RealTimeCheckedAlignedFree(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { RealTimeCheckedAlignedFree(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { RealTimeCheckedAlignedFree(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { RealTimeCheckedAlignedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { RealTimeCheckedAlignedFree(pointer); }
+#endif
+#endif
+
+#if defined(RT_ALLOCATION_DETECTOR_HOOKS_MALLOC)
+//////////////////////////////////////
+// Interposition of the C allocator
+//////////////////////////////////////
+
+extern "C" {
+    void* malloc(size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "malloc"); }
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "calloc"); }
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "realloc"); }
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer)
+    {
+        if (pointer != nullptr && insideRealTimeScope) { OnRealTimeAllocatorCall(deallocationCount, "free"); }
+        __libc_free(pointer);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "memalign"); }
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "aligned_alloc"); }
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size)
+    {
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) { return EINVAL; }
+        if (insideRealTimeScope) { OnRealTimeAllocatorCall(allocationCount, "posix_memalign"); }
+        void* result = __libc_memalign(alignment, size);
+        if (result == nullptr && size != 0) { return ENOMEM; }
+        *pointer = result;
+        return 0;
+    }
+}
+#endif
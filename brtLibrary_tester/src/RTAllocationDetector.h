@@ -0,0 +1,69 @@
+/**
+*
+* \brief Detector of heap allocations made from the real-time audio thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _RTALLOCATIONDETECTOR_H_
+#define _RTALLOCATIONDETECTOR_H_
+
+#include <cstdint>
+
+/** \brief Debug helper that hooks the global allocator and counts (or aborts on) any new/delete done
+*	by a thread while it is inside a real-time scope. It is only active when the tester is compiled with
+*	BRT_TESTER_RT_ALLOCATION_DETECTOR defined (debug builds); otherwise every method is a no-op.
+*	With glibc, malloc, calloc, realloc, free and the aligned allocation functions are interposed as well, so calls from
+*	C libraries are seen too. Elsewhere only C++ operator new/delete are hooked.
+*/
+class CRTAllocationDetector {
+public:
+
+    /** \brief Marks the calling thread as real-time while the scope object lives
+    */
+    class CRealTimeScope {
+    public:
+        CRealTimeScope();
+        ~CRealTimeScope();
+    private:
+        bool previousState;
+    };
+
+    /** \brief Returns true if the allocator hooks have been compiled in
+    */
+    static bool IsEnabled();
+
+    /** \brief When enabled, the first allocation or deallocation done inside a real-time scope aborts the program
+    *	\param [in] _abortOnAllocation
+    */
+    static void SetAbortOnAllocation(bool _abortOnAllocation);
+
+    /** \brief Number of allocations done inside real-time scopes since the last reset
+    */
+    static uint64_t GetAllocationCount();
+
+    /** \brief Number of deallocations done inside real-time scopes since the last reset
+    */
+    static uint64_t GetDeallocationCount();
+
+    /** \brief Sets both counters to zero
+    */
+    static void ResetCounters();
+};
+
+#endif
@@ -0,0 +1,310 @@
+/**
+*
+* \brief Persistent binary cache of the raw HRIR tables of HRTFs
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _RAWHRTFCACHE_HPP_
+#define _RAWHRTFCACHE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <BRTLibrary.h>
+#include "MappedFile.hpp"
+#include "PartitionedConvolver.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+    #include <direct.h>
+#endif
+
+#define RAW_HRTF_CACHE_MAGIC                "BRTHRTFC"
+#define RAW_HRTF_CACHE_VERSION              4               // 4: records hold the table read from the SOFA file, not a grid resampled by the tester
+#define RAW_HRTF_CACHE_FILE_EXTENSION       ".hrtfcache"
+#define RAW_HRTF_CACHE_SOFA_HEADER_BYTES    65536           // Bytes of the SOFA file hashed into the key
+
+/** \brief Partitioned HRIRs of the grid of an HRTF, as restored from its cache file
+*/
+struct TRawHRTFCachePartitions {
+    TSpectrumStorage storage;                                       // Format the filters are restored in, set by the caller
+    std::vector<BRTServices::orientation> orientations;
+    std::vector<CPartitionedFilter> filters;                        // filters[i] belongs to orientations[i], partitioned with the buffer size
+
+    TRawHRTFCachePartitions() : storage(SPECTRUM_STORAGE_FLOAT32) {}
+};
+
+/** \brief On-disk cache of the raw HRIR table of an HRTF, as read from its SOFA file, with the spectra of its partitions for
+*	the buffer size, so that next loads are a memory map plus validation instead of a SOFA read and a transform per partition.
+*	\details A cache file is a fixed size header followed by one fixed size record per HRIR (orientation, delays, both HRIRs
+*	and the spectra of both partitioned HRIRs, as float). The header stores the key the table depends on: size, modification
+*	time and a hash of the first RAW_HRTF_CACHE_SOFA_HEADER_BYTES of the SOFA file, sample rate, buffer size, resampling step and
+*	extrapolation method, plus a checksum of the records. Any mismatch is a cache miss. The file layout is native endian,
+*	which is checked through the header too.
+*	This is not a cache of the processed CHRTF: the library offers no way to store or restore its resampled grid and partitioned
+*	table. A hit only saves the SOFA read (and the sample rate conversion); the caller still runs EndSetup, which recomputes the
+*	offline-interpolated grid on every load. The partitioned spectra only feed the tester's CHRTFBank (TRawHRTFCachePartitions),
+*	never the listener HRTF.
+*/
+class CRawHRTFCache {
+public:
+    CRawHRTFCache(std::string _cacheDirectory) : cacheDirectory(_cacheDirectory), enabled(true) {}
+
+    /** \brief Enables or disables the cache, when disabled Load always misses and Store does nothing
+    */
+    void SetEnabled(bool _enabled) { enabled = _enabled; }
+    bool IsEnabled() const { return enabled; }
+
+    /** \brief Restores the raw table of an HRTF from its cache file, if there is a valid one for this key
+    *	\param [in] _sofaFilePath SOFA file the HRTF was read from
+    *	\param [in] _sampleRate
+    *	\param [in] _bufferSize
+    *	\param [in] _resamplingStep
+    *	\param [in] _extrapolationMethod
+    *	\param [out] _partitions if not nullptr, filled with the partitioned HRIRs of the file, in the storage it asks for
+    *	\retval HRTF in setup, with the raw table added, which still needs its EndSetup; nullptr on cache miss
+    */
+    std::shared_ptr<BRTServices::CHRTF> Load(const std::string& _sofaFilePath, int _sampleRate, int _bufferSize, float _resamplingStep, const std::string& _extrapolationMethod,
+        TRawHRTFCachePartitions* _partitions = nullptr) {
+        if (!enabled) { return nullptr; }
+
+        THRTFCacheHeader expectedHeader;
+        if (!FillHeaderKey(_sofaFilePath, _sampleRate, _bufferSize, _resamplingStep, _extrapolationMethod, expectedHeader)) { return nullptr; }
+
+        CMappedFile cacheFile;
+        if (!cacheFile.Open(GetCacheFilePath(_sofaFilePath, expectedHeader))) { return nullptr; }
+        if (cacheFile.GetSize() < sizeof(THRTFCacheHeader)) { return nullptr; }
+
+        THRTFCacheHeader header;
+        memcpy(&header, cacheFile.GetData(), sizeof(header));
+        if (!IsSameKey(header, expectedHeader)) { return nullptr; }
+
+        size_t recordSize = GetRecordSize(header.hrirLength, header.numberOfPartitions, header.spectrumSize);
+        size_t payloadSize = recordSize * header.numberOfHRIRs;
+        if (header.recordSize != recordSize || cacheFile.GetSize() != sizeof(THRTFCacheHeader) + payloadSize) { return nullptr; }
+        if (header.spectrumSize != 2 * header.bufferSize + 2) { return nullptr; }
+
+        const uint8_t* payload = cacheFile.GetData() + sizeof(THRTFCacheHeader);
+        if (Hash(payload, payloadSize, FNV_OFFSET_BASIS) != header.payloadHash) { return nullptr; }
+
+        // Records are fed to the HRTF as if they were read from the SOFA file
+        std::shared_ptr<BRTServices::CHRTF> hrtf = std::make_shared<BRTServices::CHRTF>();
+        hrtf->BeginSetup(header.hrirLength, _extrapolationMethod);
+        hrtf->SetResamplingStep(_resamplingStep);
+        if (_partitions != nullptr) {
+            _partitions->orientations.resize(header.numberOfHRIRs);
+            _partitions->filters.assign(header.numberOfHRIRs, CPartitionedFilter());
+        }
+        for (uint32_t i = 0; i < header.numberOfHRIRs; i++) {
+            const uint8_t* record = payload + i * recordSize;
+            THRIRRecordHead recordHead;
+            memcpy(&recordHead, record, sizeof(recordHead));
+            const float* leftHRIR = (const float*)(record + sizeof(THRIRRecordHead));
+            const float* rightHRIR = leftHRIR + header.hrirLength;
+
+            BRTServices::THRIRStruct hrir;
+            hrir.leftDelay = recordHead.leftDelay;
+            hrir.rightDelay = recordHead.rightDelay;
+            hrir.leftHRIR.assign(leftHRIR, leftHRIR + header.hrirLength);
+            hrir.rightHRIR.assign(rightHRIR, rightHRIR + header.hrirLength);
+            hrtf->AddHRIR(recordHead.azimuth, recordHead.elevation, std::move(hrir));
+
+            if (_partitions != nullptr) {
+                const float* leftSpectra = rightHRIR + header.hrirLength;
+                const float* rightSpectra = leftSpectra + (size_t)header.numberOfPartitions * header.spectrumSize;
+                _partitions->orientations[i] = BRTServices::orientation(recordHead.azimuth, recordHead.elevation);
+                _partitions->filters[i].SetupFromSpectra(header.bufferSize, header.numberOfPartitions, leftSpectra, rightSpectra, _partitions->storage);
+            }
+        }
+        return hrtf;
+    }
+
+    /** \brief Writes the cache file of an HRTF. The file is written aside and renamed, so a concurrent Load never sees it half written
+    *	\param [in] _sofaFilePath SOFA file the HRTF was read from
+    *	\param [in] _sampleRate
+    *	\param [in] _bufferSize
+    *	\param [in] _resamplingStep
+    *	\param [in] _extrapolationMethod
+    *	\param [in] _hrtf HRTF read from _sofaFilePath with this configuration
+    *	\param [out] _partitions if not nullptr, filled with the partitioned HRIRs written to the file, in the storage it asks for
+    *	\retval true if the cache file has been written
+    */
+    bool Store(const std::string& _sofaFilePath, int _sampleRate, int _bufferSize, float _resamplingStep, const std::string& _extrapolationMethod, const std::shared_ptr<BRTServices::CHRTF>& _hrtf,
+        TRawHRTFCachePartitions* _partitions = nullptr) {
+        if (!enabled || _hrtf == nullptr || _bufferSize <= 0 || (_bufferSize & (_bufferSize - 1)) != 0) { return false; }
+
+        THRTFCacheHeader header;
+        if (!FillHeaderKey(_sofaFilePath, _sampleRate, _bufferSize, _resamplingStep, _extrapolationMethod, header)) { return false; }
+
+        const BRTServices::T_HRTFTable& table = _hrtf->GetRawHRTFTable();
+        header.hrirLength = (uint32_t)_hrtf->GetHRIRLength();
+        header.numberOfHRIRs = (uint32_t)table.size();
+        header.numberOfPartitions = (uint32_t)std::max<size_t>(1, (header.hrirLength + _bufferSize - 1) / _bufferSize);
+        header.spectrumSize = (uint32_t)(2 * _bufferSize + 2);
+        header.recordSize = (uint32_t)GetRecordSize(header.hrirLength, header.numberOfPartitions, header.spectrumSize);
+
+        std::vector<uint8_t> payload((size_t)header.recordSize * header.numberOfHRIRs, 0);
+        uint8_t* record = payload.data();
+        CRealFFT fft(2 * _bufferSize);
+        CPartitionedFilter filter;
+        if (_partitions != nullptr) {
+            _partitions->orientations.clear();
+            _partitions->filters.assign(table.size(), CPartitionedFilter());
+        }
+        for (auto it = table.begin(); it != table.end(); it++) {
+            if (it->second.leftHRIR.size() != header.hrirLength || it->second.rightHRIR.size() != header.hrirLength) {
+                if (_partitions != nullptr) { _partitions->filters.clear(); }
+                return false;
+            }
+            THRIRRecordHead recordHead;
+            recordHead.azimuth = it->first.azimuth;
+            recordHead.elevation = it->first.elevation;
+            recordHead.leftDelay = it->second.leftDelay;
+            recordHead.rightDelay = it->second.rightDelay;
+            memcpy(record, &recordHead, sizeof(recordHead));
+            memcpy(record + sizeof(recordHead), it->second.leftHRIR.data(), header.hrirLength * sizeof(float));
+            memcpy(record + sizeof(recordHead) + header.hrirLength * sizeof(float), it->second.rightHRIR.data(), header.hrirLength * sizeof(float));
+
+            filter.Setup(_bufferSize, it->second.leftHRIR.data(), it->second.rightHRIR.data(), header.hrirLength, SPECTRUM_STORAGE_FLOAT32, &fft);
+            float* leftSpectra = (float*)(record + sizeof(recordHead) + 2 * header.hrirLength * sizeof(float));
+            float* rightSpectra = leftSpectra + (size_t)header.numberOfPartitions * header.spectrumSize;
+            for (uint32_t p = 0; p < header.numberOfPartitions; p++) {
+                memcpy(leftSpectra + p * header.spectrumSize, filter.GetPartitions(0).Read(p, nullptr), header.spectrumSize * sizeof(float));
+                memcpy(rightSpectra + p * header.spectrumSize, filter.GetPartitions(1).Read(p, nullptr), header.spectrumSize * sizeof(float));
+            }
+            if (_partitions != nullptr) {
+                _partitions->filters[_partitions->orientations.size()].SetupFromSpectra(_bufferSize, header.numberOfPartitions, leftSpectra, rightSpectra, _partitions->storage);
+                _partitions->orientations.push_back(it->first);
+            }
+            record += header.recordSize;
+        }
+        header.payloadHash = Hash(payload.data(), payload.size(), FNV_OFFSET_BASIS);
+
+        MakeCacheDirectory(cacheDirectory);
+        std::string cacheFilePath = GetCacheFilePath(_sofaFilePath, header);
+        std::string temporaryFilePath = cacheFilePath + ".tmp";
+        FILE* cacheFile = fopen(temporaryFilePath.c_str(), "wb");
+        if (cacheFile == nullptr) { return false; }
+        bool written = fwrite(&header, sizeof(header), 1, cacheFile) == 1;
+        written = written && (payload.empty() || fwrite(payload.data(), payload.size(), 1, cacheFile) == 1);
+        written = (fclose(cacheFile) == 0) && written;
+        if (!written) { std::remove(temporaryFilePath.c_str()); return false; }
+
+        std::remove(cacheFilePath.c_str());                         // rename does not replace existing files on every platform
+        return std::rename(temporaryFilePath.c_str(), cacheFilePath.c_str()) == 0;
+    }
+
+private:
+
+    static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    struct THRTFCacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t endiannessMark;                                    // 0x01020304 written in native order
+        uint64_t sofaHeaderHash;                                    // FNV-1a 64 of the first RAW_HRTF_CACHE_SOFA_HEADER_BYTES of the SOFA file
+        uint64_t sofaFileSize;
+        int64_t sofaModificationTime;                               // Seconds since the epoch
+        uint32_t sampleRate;
+        uint32_t bufferSize;
+        float resamplingStep;
+        uint32_t hrirLength;
+        char extrapolationMethod[32];
+        uint32_t numberOfHRIRs;
+        uint32_t recordSize;                                        // Bytes per HRIR record
+        uint64_t payloadHash;                                       // FNV-1a 64 of all the records
+        uint32_t numberOfPartitions;                                // Of each HRIR, with the buffer size
+        uint32_t spectrumSize;                                      // Floats of the spectrum of a partition
+        uint8_t reserved[8];
+    };
+
+    struct THRIRRecordHead {
+        double azimuth;
+        double elevation;
+        uint64_t leftDelay;
+        uint64_t rightDelay;
+    };                                                              // Followed by hrirLength left and right samples, then the left and right partition spectra
+
+    static size_t GetRecordSize(uint32_t _hrirLength, uint32_t _numberOfPartitions, uint32_t _spectrumSize) {
+        return sizeof(THRIRRecordHead) + 2 * ((size_t)_hrirLength + (size_t)_numberOfPartitions * _spectrumSize) * sizeof(float);
+    }
+
+    static uint64_t Hash(const uint8_t* _data, size_t _size, uint64_t _hash) {
+        for (size_t i = 0; i < _size; i++) {
+            _hash ^= _data[i];
+            _hash *= FNV_PRIME;
+        }
+        return _hash;
+    }
+
+    bool FillHeaderKey(const std::string& _sofaFilePath, int _sampleRate, int _bufferSize, float _resamplingStep, const std::string& _extrapolationMethod, THRTFCacheHeader& _header) const {
+        // Size and time catch most edits of the file, the header hash catches a replaced file with the same size and time
+        struct stat sofaFileStatus;
+        if (stat(_sofaFilePath.c_str(), &sofaFileStatus) != 0) { return false; }
+        CMappedFile sofaFile;
+        if (!sofaFile.Open(_sofaFilePath)) { return false; }
+
+        memset(&_header, 0, sizeof(_header));
+        memcpy(_header.magic, RAW_HRTF_CACHE_MAGIC, sizeof(_header.magic));
+        _header.version = RAW_HRTF_CACHE_VERSION;
+        _header.endiannessMark = 0x01020304;
+        _header.sofaHeaderHash = Hash(sofaFile.GetData(), std::min<size_t>(sofaFile.GetSize(), RAW_HRTF_CACHE_SOFA_HEADER_BYTES), FNV_OFFSET_BASIS);
+        _header.sofaFileSize = sofaFile.GetSize();
+        _header.sofaModificationTime = (int64_t)sofaFileStatus.st_mtime;
+        _header.sampleRate = (uint32_t)_sampleRate;
+        _header.bufferSize = (uint32_t)_bufferSize;
+        _header.resamplingStep = _resamplingStep;
+        strncpy(_header.extrapolationMethod, _extrapolationMethod.c_str(), sizeof(_header.extrapolationMethod) - 1);
+        return true;
+    }
+
+    static bool IsSameKey(const THRTFCacheHeader& _a, const THRTFCacheHeader& _b) {
+        return memcmp(_a.magic, _b.magic, sizeof(_a.magic)) == 0 && _a.version == _b.version && _a.endiannessMark == _b.endiannessMark &&
+            _a.sofaHeaderHash == _b.sofaHeaderHash && _a.sofaFileSize == _b.sofaFileSize && _a.sofaModificationTime == _b.sofaModificationTime &&
+            _a.sampleRate == _b.sampleRate && _a.bufferSize == _b.bufferSize && _a.resamplingStep == _b.resamplingStep &&
+            strncmp(_a.extrapolationMethod, _b.extrapolationMethod, sizeof(_a.extrapolationMethod)) == 0;
+    }
+
+    std::string GetCacheFilePath(const std::string& _sofaFilePath, const THRTFCacheHeader& _header) const {
+        size_t nameStart = _sofaFilePath.find_last_of("/\\");
+        std::string fileName = (nameStart == std::string::npos) ? _sofaFilePath : _sofaFilePath.substr(nameStart + 1);
+        char key[128];
+        snprintf(key, sizeof(key), "_%016llx_%u_%u_%g_%s", (unsigned long long)_header.sofaHeaderHash, _header.sampleRate, _header.bufferSize, _header.resamplingStep, _header.extrapolationMethod);
+        return cacheDirectory + "/" + fileName + key + RAW_HRTF_CACHE_FILE_EXTENSION;
+    }
+
+    static void MakeCacheDirectory(const std::string& _directory) {
+#if defined(_WIN32)
+        _mkdir(_directory.c_str());
+#else
+        mkdir(_directory.c_str(), 0755);
+#endif
+    }
+
+    std::string cacheDirectory;
+    bool enabled;
+};
+
+#endif
@@ -0,0 +1,188 @@
+/**
+*
+* \brief Lock-free telemetry of the audio callback: stage timings, histograms and xrun counters
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#include "RealTimeTelemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    const char* STAGE_NAMES[TELEMETRY_NUMBER_OF_STAGES] = { "callback", "audioProcess", "ProcessAll", "interleave" };
+    const size_t NUMBER_OF_BINS = 6 * TELEMETRY_HISTOGRAM_BINS_PER_DECADE + 1;
+}
+
+//////////////////////////////
+// TIMING HISTOGRAM
+//////////////////////////////
+
+CTimingHistogram::CTimingHistogram() : bins(NUMBER_OF_BINS, 0), count(0), sum(0), max(0)
+{}
+
+void CTimingHistogram::Add(double _milliseconds)
+{
+    size_t bin = 0;
+    if (_milliseconds > TELEMETRY_HISTOGRAM_MIN_MS) {
+        bin = (size_t)std::ceil(std::log10(_milliseconds / TELEMETRY_HISTOGRAM_MIN_MS) * TELEMETRY_HISTOGRAM_BINS_PER_DECADE);
+        if (bin >= bins.size()) { bin = bins.size() - 1; }
+    }
+    bins[bin]++;
+    count++;
+    sum += _milliseconds;
+    if (_milliseconds > max) { max = _milliseconds; }
+}
+
+void CTimingHistogram::Reset()
+{
+    std::fill(bins.begin(), bins.end(), 0);
+    count = 0;
+    sum = 0;
+    max = 0;
+}
+
+double CTimingHistogram::GetBinUpperEdge(size_t _bin) const
+{
+    return TELEMETRY_HISTOGRAM_MIN_MS * std::pow(10.0, (double)_bin / TELEMETRY_HISTOGRAM_BINS_PER_DECADE);
+}
+
+double CTimingHistogram::GetPercentile(double _percent) const
+{
+    if (count == 0) { return 0.0; }
+    uint64_t rank = (uint64_t)std::ceil(_percent / 100.0 * count);
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < bins.size(); i++) {
+        accumulated += bins[i];
+        if (accumulated >= rank) { return std::min(GetBinUpperEdge(i), max); }
+    }
+    return max;
+}
+
+//////////////////////////////
+// REAL-TIME TELEMETRY
+//////////////////////////////
+
+CRealTimeTelemetry::CRealTimeTelemetry() : ring(TELEMETRY_RING_CAPACITY), nextBlockIndex(0), droppedRecords(0), numberOfBlocks(0), inputOverflows(0),
+    outputUnderflows(0), blocksOverDeadline(0), sampleRate(0), stopRequested(false)
+{
+    BeginBlock(0);
+}
+
+CRealTimeTelemetry::~CRealTimeTelemetry()
+{
+    Stop();
+}
+
+void CRealTimeTelemetry::Start(int _sampleRate)
+{
+    Stop();
+    sampleRate = _sampleRate;
+    stopRequested.store(false, std::memory_order_relaxed);
+    aggregatorThread = std::thread(&CRealTimeTelemetry::AggregatorLoop, this);
+}
+
+void CRealTimeTelemetry::Stop()
+{
+    stopRequested.store(true, std::memory_order_relaxed);
+    if (aggregatorThread.joinable()) { aggregatorThread.join(); }
+    Drain();
+}
+
+void CRealTimeTelemetry::AggregatorLoop()
+{
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        Drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(TELEMETRY_AGGREGATION_PERIOD_MS));
+    }
+}
+
+void CRealTimeTelemetry::Drain()
+{
+    std::lock_guard<std::mutex> lock(aggregateMutex);
+    TBlockTelemetry block;
+    while (ring.Pop(block)) {
+        numberOfBlocks++;
+        for (int i = 0; i < TELEMETRY_NUMBER_OF_STAGES; i++) { histograms[i].Add(block.stageMilliseconds[i]); }
+        if (block.inputOverflow) { inputOverflows++; }
+        if (block.outputUnderflow) { outputUnderflows++; }
+        double deadline = (sampleRate > 0) ? 1000.0 * block.numberOfFrames / sampleRate : 0.0;
+        if (deadline > 0 && block.stageMilliseconds[TELEMETRY_CALLBACK] > deadline) { blocksOverDeadline++; }
+    }
+}
+
+void CRealTimeTelemetry::Reset()
+{
+    Drain();
+    std::lock_guard<std::mutex> lock(aggregateMutex);
+    for (CTimingHistogram& histogram : histograms) { histogram.Reset(); }
+    numberOfBlocks = 0;
+    inputOverflows = 0;
+    outputUnderflows = 0;
+    blocksOverDeadline = 0;
+    droppedRecords.store(0, std::memory_order_relaxed);
+}
+
+void CRealTimeTelemetry::PrintTable(std::ostream& _output)
+{
+    Drain();
+    std::lock_guard<std::mutex> lock(aggregateMutex);
+    char row[256];
+    std::snprintf(row, sizeof(row), "%14s %10s %10s %10s %10s %10s", "stage", "mean ms", "p50 ms", "p99 ms", "p99.9 ms", "max ms");
+    _output << row << std::endl;
+    for (int i = 0; i < TELEMETRY_NUMBER_OF_STAGES; i++) {
+        const CTimingHistogram& histogram = histograms[i];
+        std::snprintf(row, sizeof(row), "%14s %10.4f %10.4f %10.4f %10.4f %10.4f", STAGE_NAMES[i], histogram.GetMean(), histogram.GetPercentile(50),
+            histogram.GetPercentile(99), histogram.GetPercentile(99.9), histogram.GetMax());
+        _output << row << std::endl;
+    }
+    _output << "Blocks: " << numberOfBlocks << ", over deadline: " << blocksOverDeadline << ", output underflows: " << outputUnderflows
+        << ", input overflows: " << inputOverflows << ", records dropped: " << droppedRecords.load(std::memory_order_relaxed) << std::endl;
+    _output << "Percentiles are bin upper edges (" << TELEMETRY_HISTOGRAM_BINS_PER_DECADE << " bins per decade)" << std::endl;
+}
+
+void CRealTimeTelemetry::PrintJSON(std::ostream& _output)
+{
+    Drain();
+    std::lock_guard<std::mutex> lock(aggregateMutex);
+    _output << "{" << std::endl;
+    _output << "  \"blocks\": " << numberOfBlocks << "," << std::endl;
+    _output << "  \"blocksOverDeadline\": " << blocksOverDeadline << "," << std::endl;
+    _output << "  \"outputUnderflows\": " << outputUnderflows << "," << std::endl;
+    _output << "  \"inputOverflows\": " << inputOverflows << "," << std::endl;
+    _output << "  \"droppedRecords\": " << droppedRecords.load(std::memory_order_relaxed) << "," << std::endl;
+    _output << "  \"stages\": {" << std::endl;
+    for (int i = 0; i < TELEMETRY_NUMBER_OF_STAGES; i++) {
+        const CTimingHistogram& histogram = histograms[i];
+        _output << "    \"" << STAGE_NAMES[i] << "\": { \"count\": " << histogram.GetCount() << ", \"meanMs\": " << histogram.GetMean()
+            << ", \"p50Ms\": " << histogram.GetPercentile(50) << ", \"p99Ms\": " << histogram.GetPercentile(99) << ", \"maxMs\": " << histogram.GetMax()
+            << ", \"histogram\": [";
+        bool first = true;
+        for (size_t b = 0; b < histogram.GetBins().size(); b++) {       // Only non-empty bins, as [upper edge ms, count]
+            if (histogram.GetBins()[b] == 0) { continue; }
+            _output << (first ? "" : ", ") << "[" << histogram.GetBinUpperEdge(b) << ", " << histogram.GetBins()[b] << "]";
+            first = false;
+        }
+        _output << "] }" << (i + 1 < TELEMETRY_NUMBER_OF_STAGES ? "," : "") << std::endl;
+    }
+    _output << "  }" << std::endl;
+    _output << "}" << std::endl;
+}
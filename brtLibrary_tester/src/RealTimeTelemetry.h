@@ -0,0 +1,157 @@
+/**
+*
+* \brief Lock-free telemetry of the audio callback: stage timings, histograms and xrun counters
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _REALTIMETELEMETRY_H_
+#define _REALTIMETELEMETRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "SPSCRingBuffer.hpp"
+
+#define TELEMETRY_RING_CAPACITY             4096        // Blocks buffered between the audio thread and the aggregator
+#define TELEMETRY_AGGREGATION_PERIOD_MS     20
+#define TELEMETRY_HISTOGRAM_BINS_PER_DECADE 10
+#define TELEMETRY_HISTOGRAM_MIN_MS          0.001       // Lower edge of the first bin; 6 decades, up to 1 s
+
+/** \brief Parts of the block processing that are timed
+*/
+enum TTelemetryStage { TELEMETRY_CALLBACK, TELEMETRY_AUDIO_PROCESS, TELEMETRY_PROCESS_ALL, TELEMETRY_INTERLEAVE, TELEMETRY_NUMBER_OF_STAGES };
+
+/** \brief What the audio thread records for every block
+*/
+struct TBlockTelemetry {
+    uint64_t blockIndex;
+    uint32_t numberOfFrames;
+    bool inputOverflow;
+    bool outputUnderflow;
+    float stageMilliseconds[TELEMETRY_NUMBER_OF_STAGES];
+};
+
+/** \brief Histogram of durations with logarithmic bins, plus exact count, mean and maximum
+*/
+class CTimingHistogram {
+public:
+    CTimingHistogram();
+    void Add(double _milliseconds);
+    void Reset();
+
+    /** \brief Upper edge of the bin holding the given percentile, an upper bound of the exact value
+    */
+    double GetPercentile(double _percent) const;
+
+    uint64_t GetCount() const { return count; }
+    double GetMean() const { return count > 0 ? sum / count : 0.0; }
+    double GetMax() const { return max; }
+    double GetBinUpperEdge(size_t _bin) const;
+    const std::vector<uint64_t>& GetBins() const { return bins; }
+
+private:
+    std::vector<uint64_t> bins;                             // The last bin also holds everything longer
+    uint64_t count;
+    double sum;
+    double max;
+};
+
+/** \brief Telemetry of the audio callback. The audio thread records the duration of every stage of a block and pushes the record
+*	to a wait-free SPSC ring, without locks, allocations or console output; when the ring is full the record is dropped and counted.
+*	A reader thread drains the ring periodically into per-stage histograms and xrun counters, which can be printed as a
+*	table or as JSON.
+*/
+class CRealTimeTelemetry {
+public:
+    CRealTimeTelemetry();
+    ~CRealTimeTelemetry();
+
+    /** \brief Starts the aggregator thread
+    *	\param [in] _sampleRate to compute the deadline of each block
+    */
+    void Start(int _sampleRate);
+
+    /** \brief Stops the aggregator thread, after draining the ring
+    */
+    void Stop();
+
+    /** \brief Audio thread. Starts the record of a block
+    */
+    void BeginBlock(uint32_t _numberOfFrames) {
+        current.blockIndex = nextBlockIndex++;
+        current.numberOfFrames = _numberOfFrames;
+        current.inputOverflow = false;
+        current.outputUnderflow = false;
+        for (int i = 0; i < TELEMETRY_NUMBER_OF_STAGES; i++) { current.stageMilliseconds[i] = 0.0f; }
+    }
+
+    /** \brief Audio thread. Records the duration of a stage of the current block
+    */
+    void RecordStage(TTelemetryStage _stage, double _milliseconds) { current.stageMilliseconds[_stage] = (float)_milliseconds; }
+
+    /** \brief Audio thread. Records the xruns the audio API reported for the current block
+    */
+    void RecordXruns(bool _inputOverflow, bool _outputUnderflow) {
+        current.inputOverflow = _inputOverflow;
+        current.outputUnderflow = _outputUnderflow;
+    }
+
+    /** \brief Audio thread. Publishes the record of the current block
+    */
+    void EndBlock() {
+        if (!ring.Push(current)) { droppedRecords.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    /** \brief Clears the aggregated data
+    */
+    void Reset();
+
+    /** \brief Prints a table with the percentiles of every stage and the counters
+    */
+    void PrintTable(std::ostream& _output);
+
+    /** \brief Prints the histograms and counters as a JSON object
+    */
+    void PrintJSON(std::ostream& _output);
+
+private:
+    void AggregatorLoop();
+    void Drain();
+
+    CSPSCRingBuffer<TBlockTelemetry> ring;
+    TBlockTelemetry current;                                // Only touched by the audio thread
+    uint64_t nextBlockIndex;                                // Only touched by the audio thread
+    std::atomic<uint64_t> droppedRecords;
+
+    std::mutex aggregateMutex;                              // Guards everything below; never taken by the audio thread
+    CTimingHistogram histograms[TELEMETRY_NUMBER_OF_STAGES];
+    uint64_t numberOfBlocks;
+    uint64_t inputOverflows;
+    uint64_t outputUnderflows;
+    uint64_t blocksOverDeadline;
+    int sampleRate;
+
+    std::thread aggregatorThread;
+    std::atomic<bool> stopRequested;
+};
+
+#endif
@@ -0,0 +1,200 @@
+/**
+*
+* \brief Pool of real-time worker threads, synchronised by spinning at block boundaries
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _REALTIMEWORKERPOOL_HPP_
+#define _REALTIMEWORKERPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+/** \brief Tells the CPU the thread is busy waiting
+*/
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/** \brief Pool of worker threads spawned once, before processing starts, that run the tasks of each audio block together with
+*	the calling (audio) thread.
+*	\details Run publishes a job of N tasks; every thread, the caller included, claims tasks from a shared atomic cursor until none
+*	is left, so a thread that finishes early takes the work the others have not started. This is a shared queue, not work
+*	stealing: there are no per-thread deques, every claim goes through the same cursor. After a job, workers spin for a short
+*	while, which catches the next job of the same block, and then park on a condition variable until Run publishes a new job, so
+*	they take no CPU between blocks. Run only touches the mutex when a worker is parked. Run does not allocate and returns when every task has finished.
+*/
+class CRealTimeWorkerPool {
+public:
+
+    typedef void (*TTaskFunction)(void* _context, int _taskIndex);
+
+    /** \brief Spawns the workers
+    *	\param [in] _numberOfThreads total threads processing each job, the calling thread included
+    *	\param [in] _realTimePriority try to raise the workers to real-time priority (it may need privileges, failure is ignored).
+    *	Ignored when there are more threads than cores
+    */
+    CRealTimeWorkerPool(int _numberOfThreads, bool _realTimePriority) : claimState(0), completedTasks(0), taskFunction(nullptr), taskContext(nullptr),
+        generation(0), parkedWorkers(0), stopRequested(false)
+    {
+        unsigned int numberOfCores = std::thread::hardware_concurrency();
+        if (numberOfCores != 0 && (unsigned int)_numberOfThreads > numberOfCores) { _realTimePriority = false; }
+        for (int i = 1; i < _numberOfThreads; i++) {
+            workers.push_back(std::thread(&CRealTimeWorkerPool::WorkerLoop, this));
+            if (_realTimePriority) { SetRealTimePriority(workers.back()); }
+        }
+    }
+
+    ~CRealTimeWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            stopRequested.store(true, std::memory_order_release);
+        }
+        parkCondition.notify_all();
+        for (std::thread& worker : workers) { worker.join(); }
+    }
+
+    CRealTimeWorkerPool(const CRealTimeWorkerPool&) = delete;
+    CRealTimeWorkerPool& operator=(const CRealTimeWorkerPool&) = delete;
+
+    /** \brief Number of threads that process each job, the calling thread included
+    */
+    int GetNumberOfThreads() const { return (int)workers.size() + 1; }
+
+    /** \brief Runs _numberOfTasks calls to _function, spread over all the threads, and waits for them. Only one thread may call Run
+    *	\param [in] _numberOfTasks up to 65535
+    *	\param [in] _function called as _function(_context, taskIndex) once for each task index
+    *	\param [in] _context
+    */
+    void Run(int _numberOfTasks, TTaskFunction _function, void* _context) {
+        if (_numberOfTasks <= 0) { return; }
+        taskFunction.store(_function, std::memory_order_relaxed);
+        taskContext.store(_context, std::memory_order_relaxed);
+        completedTasks.store(0, std::memory_order_relaxed);
+        generation++;
+        claimState.store(PackClaimState(generation, (uint32_t)_numberOfTasks, 0), std::memory_order_seq_cst);     // Publishes the job
+        if (parkedWorkers.load(std::memory_order_seq_cst) > 0) {
+            // The empty critical section orders the wake-up after a worker that is about to wait has checked the state
+            { std::lock_guard<std::mutex> lock(parkMutex); }
+            parkCondition.notify_all();
+        }
+
+        ExecuteTasks();
+        int waitIterations = 0;
+        while (completedTasks.load(std::memory_order_acquire) < _numberOfTasks) {
+            if (++waitIterations < SPIN_ITERATIONS) { CpuRelax(); }
+            else { std::this_thread::yield(); }          // A worker was preempted (more threads than cores), let it finish
+        }
+    }
+
+private:
+
+    static const int SPIN_ITERATIONS = 4096;            // Busy waiting before yielding the core, or before parking a worker
+
+    /// The claim state packs job generation, number of tasks and next task, so a claim can never succeed on an older job
+    static uint64_t PackClaimState(uint32_t _generation, uint32_t _numberOfTasks, uint32_t _nextTask) {
+        return ((uint64_t)_generation << 32) | ((uint64_t)(_numberOfTasks & 0xFFFF) << 16) | (_nextTask & 0xFFFF);
+    }
+
+    void ExecuteTasks() {
+        uint64_t state = claimState.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t nextTask = (uint32_t)(state & 0xFFFF);
+            uint32_t numberOfTasks = (uint32_t)((state >> 16) & 0xFFFF);
+            if (nextTask >= numberOfTasks) { return; }
+            if (claimState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // The job cannot finish before this claimed task, so its function and context are stable here
+                taskFunction.load(std::memory_order_relaxed)(taskContext.load(std::memory_order_relaxed), (int)nextTask);
+                completedTasks.fetch_add(1, std::memory_order_release);
+                state = claimState.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        int idleIterations = 0;
+        while (!stopRequested.load(std::memory_order_acquire)) {
+            uint64_t state = claimState.load(std::memory_order_acquire);
+            if ((state & 0xFFFF) < ((state >> 16) & 0xFFFF)) {
+                ExecuteTasks();
+                idleIterations = 0;
+            }
+            else if (++idleIterations < SPIN_ITERATIONS) { CpuRelax(); }
+            else {
+                Park(state);
+                idleIterations = 0;
+            }
+        }
+    }
+
+    /// Waits until a job newer than the one in _seenState is published, or the pool is destroyed
+    void Park(uint64_t _seenState) {
+        std::unique_lock<std::mutex> lock(parkMutex);
+        parkedWorkers.fetch_add(1, std::memory_order_seq_cst);
+        // Run stores the state before reading parkedWorkers, and this reads the state after incrementing it, so one of them sees the other
+        parkCondition.wait(lock, [this, _seenState]() {
+            return stopRequested.load(std::memory_order_acquire) || claimState.load(std::memory_order_seq_cst) != _seenState;
+        });
+        parkedWorkers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static void SetRealTimePriority(std::thread& _thread) {
+#if defined(_WIN32)
+        SetThreadPriority(_thread.native_handle(), THREAD_PRIORITY_TIME_CRITICAL);
+#else
+        sched_param parameters;
+        parameters.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+        pthread_setschedparam(_thread.native_handle(), SCHED_FIFO, &parameters);
+#endif
+    }
+
+    std::vector<std::thread> workers;
+    std::atomic<uint64_t> claimState;                   // Generation | number of tasks | next task to claim
+    std::atomic<int> completedTasks;
+    std::atomic<TTaskFunction> taskFunction;
+    std::atomic<void*> taskContext;
+    uint32_t generation;                                // Only written by the thread calling Run
+    std::atomic<int> parkedWorkers;                     // Workers waiting on parkCondition, or about to
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+    std::atomic<bool> stopRequested;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/**
+*
+* \brief Lock-free single producer, single consumer ring buffer
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _SPSCRINGBUFFER_HPP_
+#define _SPSCRINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/** \brief Lock-free ring buffer for one producer thread and one consumer thread. Neither side blocks or allocates after
+*	construction, so either of them can be the audio thread.
+*	\details Read and write counters grow monotonically and are masked with the capacity, a power of two. Each counter is
+*	written by one side only and kept on its own cache line.
+*/
+template <class T>
+class CSPSCRingBuffer {
+public:
+    /** \brief Allocates the storage
+    *	\param [in] _minimumCapacity rounded up to a power of two
+    */
+    explicit CSPSCRingBuffer(size_t _minimumCapacity) : writeCounter(0), readCounter(0) {
+        size_t capacity = 1;
+        while (capacity < _minimumCapacity) { capacity <<= 1; }
+        buffer.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    CSPSCRingBuffer(const CSPSCRingBuffer&) = delete;
+    CSPSCRingBuffer& operator=(const CSPSCRingBuffer&) = delete;
+
+    size_t GetCapacity() const { return buffer.size(); }
+
+    /** \brief Elements that can be read now. Exact for the consumer, a lower bound for the producer
+    */
+    size_t GetReadAvailable() const {
+        return writeCounter.load(std::memory_order_acquire) - readCounter.load(std::memory_order_acquire);
+    }
+
+    /** \brief Elements that can be written now. Exact for the producer, a lower bound for the consumer
+    */
+    size_t GetWriteAvailable() const { return buffer.size() - GetReadAvailable(); }
+
+    /** \brief Producer side. Writes one element
+    *	\retval false if the buffer is full
+    */
+    bool Push(const T& _element) {
+        size_t write = writeCounter.load(std::memory_order_relaxed);
+        if (write - readCounter.load(std::memory_order_acquire) >= buffer.size()) { return false; }
+        buffer[write & mask] = _element;
+        writeCounter.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** \brief Consumer side. Reads one element
+    *	\retval false if the buffer is empty
+    */
+    bool Pop(T& _element) {
+        size_t read = readCounter.load(std::memory_order_relaxed);
+        if (read == writeCounter.load(std::memory_order_acquire)) { return false; }
+        _element = buffer[read & mask];
+        readCounter.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** \brief Producer side. Writes as many of the elements as fit
+    *	\retval number of elements written
+    */
+    size_t Write(const T* _elements, size_t _count) {
+        size_t write = writeCounter.load(std::memory_order_relaxed);
+        size_t available = buffer.size() - (write - readCounter.load(std::memory_order_acquire));
+        if (_count > available) { _count = available; }
+        for (size_t i = 0; i < _count; i++) { buffer[(write + i) & mask] = _elements[i]; }
+        writeCounter.store(write + _count, std::memory_order_release);
+        return _count;
+    }
+
+    /** \brief Consumer side. Reads up to _count elements
+    *	\retval number of elements read
+    */
+    size_t Read(T* _elements, size_t _count) {
+        size_t read = readCounter.load(std::memory_order_relaxed);
+        size_t available = writeCounter.load(std::memory_order_acquire) - read;
+        if (_count > available) { _count = available; }
+        for (size_t i = 0; i < _count; i++) { _elements[i] = buffer[(read + i) & mask]; }
+        readCounter.store(read + _count, std::memory_order_release);
+        return _count;
+    }
+
+private:
+    std::vector<T> buffer;
+    size_t mask;
+    char padding0[64];                                  // Counters on separate cache lines (alignas would need C++17 aligned new)
+    std::atomic<size_t> writeCounter;                   // Only written by the producer
+    char padding1[64];
+    std::atomic<size_t> readCounter;                    // Only written by the consumer
+    char padding2[64];
+};
+
+#endif
@@ -0,0 +1,129 @@
+/**
+*
+* \brief Timing and quality of the sample rate conversion of the bundled HRTF files
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "SampleRateConversionReport.h"
+#include "SampleRateConverter.h"
+#include "ProcessingStatistics.hpp"
+#include <BRTLibrary.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const int ENGINE_SAMPLE_RATES[] = { 44100, 48000, 96000 };
+
+    bool IsBitIdentical(const BRTServices::T_HRTFTable& _a, const BRTServices::T_HRTFTable& _b) {
+        if (_a.size() != _b.size()) { return false; }
+        for (auto it = _a.begin(); it != _a.end(); it++) {
+            auto other = _b.find(it->first);
+            if (other == _b.end() || it->second.leftDelay != other->second.leftDelay || it->second.rightDelay != other->second.rightDelay) { return false; }
+            if (it->second.leftHRIR.size() != other->second.leftHRIR.size() || it->second.rightHRIR.size() != other->second.rightHRIR.size()) { return false; }
+            if (memcmp(it->second.leftHRIR.data(), other->second.leftHRIR.data(), it->second.leftHRIR.size() * sizeof(float)) != 0) { return false; }
+            if (memcmp(it->second.rightHRIR.data(), other->second.rightHRIR.data(), it->second.rightHRIR.size() * sizeof(float)) != 0) { return false; }
+        }
+        return true;
+    }
+
+    /// Signal to error ratio, in dB, of the HRIRs of _roundTrip against those of _original, over the length of the shorter one
+    double MeasureRoundTripRatio(const BRTServices::T_HRTFTable& _original, const BRTServices::T_HRTFTable& _roundTrip) {
+        double signal = 0, error = 0;
+        for (auto it = _original.begin(); it != _original.end(); it++) {
+            auto other = _roundTrip.find(it->first);
+            if (other == _roundTrip.end()) { continue; }
+            const CMonoBuffer<float>* originals[2] = { &it->second.leftHRIR, &it->second.rightHRIR };
+            const CMonoBuffer<float>* converted[2] = { &other->second.leftHRIR, &other->second.rightHRIR };
+            for (int ear = 0; ear < 2; ear++) {
+                size_t length = std::min(originals[ear]->size(), converted[ear]->size());
+                for (size_t i = 0; i < length; i++) {
+                    double difference = (double)(*converted[ear])[i] - (*originals[ear])[i];
+                    signal += (double)(*originals[ear])[i] * (*originals[ear])[i];
+                    error += difference * difference;
+                }
+            }
+        }
+        if (signal == 0) { return 0; }
+        return error > 0 ? 10.0 * std::log10(signal / error) : 200.0;
+    }
+}
+
+bool RunSampleRateConversionReport(const std::vector<std::string>& _hrtfFilePaths, const std::vector<std::string>& _ildFilePaths)
+{
+    BRTReaders::CSOFAReader sofaReader;
+    CHRIRSampleRateConverter serialConverter(1);
+    CHRIRSampleRateConverter parallelConverter(0);
+    const std::string extrapolationMethod = "NearestPoint";
+    bool succeeded = true;
+
+    std::cout << std::endl << "Sample rate conversion of the HRTF files (" << parallelConverter.GetNumberOfThreads() << " thread(s))" << std::endl;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%-32s %7s %7s %9s %5s %7s %11s %11s %9s %12s", "file", "from", "to", "L/M", "taps", "length", "1 thr ms", "N thr ms", "identical", "round trip");
+    std::cout << row << std::endl;
+
+    for (const std::string& filePath : _hrtfFilePaths) {
+        size_t nameStart = filePath.find_last_of("/\\");
+        std::string fileName = (nameStart == std::string::npos) ? filePath : filePath.substr(nameStart + 1);
+        int fileRate = sofaReader.GetSampleRateFromSofa(filePath);
+        std::shared_ptr<BRTServices::CHRTF> rawHRTF = std::make_shared<BRTServices::CHRTF>();
+        if (fileRate <= 0 || !sofaReader.ReadHRTFFromSofaWithoutProcess(filePath, rawHRTF, 5, extrapolationMethod)) {
+            std::cout << "Error reading " << filePath << std::endl;
+            succeeded = false;
+            continue;
+        }
+
+        for (int engineRate : ENGINE_SAMPLE_RATES) {
+            if (engineRate == fileRate) { continue; }
+            CPolyphaseResampler resampler;
+            resampler.Setup(fileRate, engineRate);
+
+            CStopwatch serialStopwatch;
+            std::shared_ptr<BRTServices::CHRTF> serial = serialConverter.Convert(rawHRTF, fileRate, engineRate, extrapolationMethod);
+            double serialTime = serialStopwatch.GetElapsedMilliseconds();
+            CStopwatch parallelStopwatch;
+            std::shared_ptr<BRTServices::CHRTF> parallel = parallelConverter.Convert(rawHRTF, fileRate, engineRate, extrapolationMethod);
+            double parallelTime = parallelStopwatch.GetElapsedMilliseconds();
+            std::shared_ptr<BRTServices::CHRTF> roundTrip = (parallel != nullptr) ? parallelConverter.Convert(parallel, engineRate, fileRate, extrapolationMethod) : nullptr;
+            if (serial == nullptr || parallel == nullptr || roundTrip == nullptr) {
+                std::cout << "Error converting " << filePath << " to " << engineRate << " Hz" << std::endl;
+                succeeded = false;
+                continue;
+            }
+
+            bool identical = IsBitIdentical(serial->GetRawHRTFTable(), parallel->GetRawHRTFTable());
+            succeeded = succeeded && identical;
+            std::string factors = std::to_string(resampler.GetUpFactor()) + "/" + std::to_string(resampler.GetDownFactor());
+            std::snprintf(row, sizeof(row), "%-32s %7d %7d %9s %5zu %7d %11.2f %11.2f %9s %9.1f dB", fileName.c_str(), fileRate, engineRate, factors.c_str(),
+                resampler.GetTapsPerPhase(), (int)parallel->GetHRIRLength(), serialTime, parallelTime, identical ? "yes" : "NO",
+                MeasureRoundTripRatio(rawHRTF->GetRawHRTFTable(), roundTrip->GetRawHRTFTable()));
+            std::cout << row << std::endl;
+        }
+    }
+
+    // The near field ILD holds biquad designs for one sample rate, not sampled signals, so there is nothing to resample
+    std::cout << std::endl << "ILD files (biquad coefficients, not resampled: only the file of the engine rate can be loaded):" << std::endl;
+    for (const std::string& filePath : _ildFilePaths) {
+        std::cout << "  " << filePath << ": " << sofaReader.GetSampleRateFromSofa(filePath) << " Hz" << std::endl;
+    }
+    return succeeded;
+}
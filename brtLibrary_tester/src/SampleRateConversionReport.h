@@ -0,0 +1,40 @@
+/**
+*
+* \brief Timing and quality of the sample rate conversion of the bundled HRTF files
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _SAMPLERATECONVERSIONREPORT_H_
+#define _SAMPLERATECONVERSIONREPORT_H_
+
+#include <string>
+#include <vector>
+
+/** \brief For every HRTF SOFA file and every engine sample rate (44100, 48000 and 96000 Hz) other than the rate of the file,
+*	converts the raw HRIR table with one thread and with every core. Prints both times, whether both results are bit-identical
+*	and the signal to error ratio of the HRIRs converted there and back
+*	\param [in] _hrtfFilePaths HRTF SOFA files
+*	\param [in] _ildFilePaths ILD SOFA files, whose rate is listed (their biquads are not resampled)
+*	\retval false if a file could not be read or a conversion failed
+*/
+bool RunSampleRateConversionReport(const std::vector<std::string>& _hrtfFilePaths, const std::vector<std::string>& _ildFilePaths);
+
+#endif
@@ -0,0 +1,199 @@
+/**
+*
+* \brief Polyphase sample rate conversion of HRIR tables
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#include "SampleRateConverter.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+    const double PI = 3.14159265358979323846;
+
+    int GreatestCommonDivisor(int _a, int _b) {
+        while (_b != 0) {
+            int remainder = _a % _b;
+            _a = _b;
+            _b = remainder;
+        }
+        return _a;
+    }
+
+    /// Modified Bessel function of the first kind and order 0, by its power series
+    double BesselI0(double _x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50; k++) {
+            term *= (_x / (2.0 * k)) * (_x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-16) { break; }
+        }
+        return sum;
+    }
+}
+
+//////////////////////////////
+// Polyphase resampler
+//////////////////////////////
+
+CPolyphaseResampler::CPolyphaseResampler() : upFactor(1), downFactor(1), tapsPerPhase(1), delay(0)
+{
+    phases.assign(1, 1.0);
+}
+
+bool CPolyphaseResampler::Setup(int _inputRate, int _outputRate)
+{
+    if (_inputRate <= 0 || _outputRate <= 0) { return false; }
+    int divisor = GreatestCommonDivisor(_inputRate, _outputRate);
+    upFactor = _outputRate / divisor;
+    downFactor = _inputRate / divisor;
+    if (upFactor == 1 && downFactor == 1) {
+        tapsPerPhase = 1;
+        delay = 0;
+        phases.assign(1, 1.0);
+        return true;
+    }
+
+    // The cutoff is below the lower Nyquist frequency, so downsampling needs proportionally longer branches
+    tapsPerPhase = (size_t)std::ceil(SAMPLE_RATE_CONVERTER_TAPS * std::max(1.0, (double)downFactor / upFactor));
+    size_t length = tapsPerPhase * upFactor;
+    size_t windowLength = length - (1 - length % 2);        // Odd, so the delay is a whole number of samples and the output is not shifted
+    size_t centre = (windowLength - 1) / 2;
+    double cutoff = SAMPLE_RATE_CONVERTER_BANDWIDTH * std::min(1.0, (double)upFactor / downFactor) / upFactor;     // Of the upsampled Nyquist frequency
+    double windowNormalization = BesselI0(SAMPLE_RATE_CONVERTER_KAISER_BETA);
+
+    std::vector<double> prototype(length, 0.0);
+    double sum = 0;
+    for (size_t n = 0; n < windowLength; n++) {
+        double x = (double)n - (double)centre;
+        double sinc = (x == 0) ? cutoff : std::sin(PI * cutoff * x) / (PI * x);
+        double ratio = 2.0 * n / (windowLength - 1) - 1.0;
+        double window = BesselI0(SAMPLE_RATE_CONVERTER_KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) / windowNormalization;
+        prototype[n] = sinc * window;
+        sum += prototype[n];
+    }
+
+    // Unity gain at DC for every branch on average (the upsampling zeros take a factor L)
+    phases.resize(length);
+    for (int p = 0; p < upFactor; p++) {
+        for (size_t i = 0; i < tapsPerPhase; i++) { phases[p * tapsPerPhase + i] = prototype[p + i * upFactor] * upFactor / sum; }
+    }
+    delay = centre;
+    return true;
+}
+
+size_t CPolyphaseResampler::GetOutputLength(size_t _inputLength) const
+{
+    return (size_t)(((unsigned long long)_inputLength * upFactor + downFactor - 1) / downFactor);
+}
+
+void CPolyphaseResampler::Process(const float* _input, size_t _inputLength, float* _output) const
+{
+    size_t outputLength = GetOutputLength(_inputLength);
+    for (size_t k = 0; k < outputLength; k++) {
+        // Output sample k is sample k M + delay of the upsampled and filtered signal: input j contributes through tap t - j L
+        unsigned long long t = (unsigned long long)k * downFactor + delay;
+        size_t phase = (size_t)(t % upFactor);
+        long long newest = (long long)(t / upFactor);
+        const double* taps = &phases[phase * tapsPerPhase];
+        double accumulator = 0;
+        for (size_t i = 0; i < tapsPerPhase; i++) {
+            long long j = newest - (long long)i;
+            if (j < 0) { break; }
+            if (j < (long long)_inputLength) { accumulator += taps[i] * _input[j]; }
+        }
+        _output[k] = (float)accumulator;
+    }
+}
+
+//////////////////////////////
+// HRIR table conversion
+//////////////////////////////
+
+CHRIRSampleRateConverter::CHRIRSampleRateConverter(int _numberOfThreads)
+    : workerPool(_numberOfThreads > 0 ? _numberOfThreads : std::max(1, (int)std::thread::hardware_concurrency()), false)
+{
+}
+
+std::shared_ptr<BRTServices::CHRTF> CHRIRSampleRateConverter::Convert(const std::shared_ptr<BRTServices::CHRTF>& _rawHRTF, int _inputRate, int _outputRate, const std::string& _extrapolationMethod)
+{
+    if (_rawHRTF == nullptr) { return nullptr; }
+    const BRTServices::T_HRTFTable& table = _rawHRTF->GetRawHRTFTable();
+    if (table.empty()) { return nullptr; }
+
+    CPolyphaseResampler resampler;
+    if (!resampler.Setup(_inputRate, _outputRate)) { return nullptr; }
+
+    std::vector<BRTServices::orientation> orientations;
+    std::vector<const BRTServices::THRIRStruct*> input;
+    orientations.reserve(table.size());
+    input.reserve(table.size());
+    for (auto it = table.begin(); it != table.end(); it++) {
+        orientations.push_back(it->first);
+        input.push_back(&it->second);
+    }
+    std::vector<BRTServices::THRIRStruct> output(input.size());
+
+    TConvertJob job;
+    job.resampler = &resampler;
+    job.input = &input;
+    job.output = &output;
+    job.gain = (float)_inputRate / _outputRate;                  // Same continuous response sampled more or less often
+    job.delayRatio = (double)_outputRate / _inputRate;
+    size_t numberOfTasks = (input.size() + SAMPLE_RATE_CONVERTER_HRIRS_PER_TASK - 1) / SAMPLE_RATE_CONVERTER_HRIRS_PER_TASK;
+    for (job.firstTask = 0; job.firstTask < numberOfTasks; job.firstTask += 0xFFFF) {      // The pool takes up to 65535 tasks per run
+        workerPool.Run((int)std::min<size_t>(0xFFFF, numberOfTasks - job.firstTask), &CHRIRSampleRateConverter::ConvertTask, &job);
+    }
+
+    std::shared_ptr<BRTServices::CHRTF> hrtf = std::make_shared<BRTServices::CHRTF>();
+    hrtf->BeginSetup((int32_t)resampler.GetOutputLength(_rawHRTF->GetHRIRLength()), _extrapolationMethod);
+    for (size_t i = 0; i < orientations.size(); i++) {
+        hrtf->AddHRIR(orientations[i].azimuth, orientations[i].elevation, std::move(output[i]));
+    }
+    return hrtf;
+}
+
+void CHRIRSampleRateConverter::ConvertTask(void* _job, int _taskIndex)
+{
+    const TConvertJob& job = *static_cast<const TConvertJob*>(_job);
+    size_t first = (job.firstTask + _taskIndex) * SAMPLE_RATE_CONVERTER_HRIRS_PER_TASK;
+    size_t last = std::min(first + SAMPLE_RATE_CONVERTER_HRIRS_PER_TASK, job.input->size());
+    for (size_t h = first; h < last; h++) {
+        const BRTServices::THRIRStruct& input = *(*job.input)[h];
+        BRTServices::THRIRStruct& output = (*job.output)[h];
+        output.leftHRIR.resize(job.resampler->GetOutputLength(input.leftHRIR.size()));
+        output.rightHRIR.resize(job.resampler->GetOutputLength(input.rightHRIR.size()));
+        job.resampler->Process(input.leftHRIR.data(), input.leftHRIR.size(), output.leftHRIR.data());
+        job.resampler->Process(input.rightHRIR.data(), input.rightHRIR.size(), output.rightHRIR.data());
+        for (float& sample : output.leftHRIR) { sample *= job.gain; }
+        for (float& sample : output.rightHRIR) { sample *= job.gain; }
+        output.leftDelay = (uint64_t)std::llround(input.leftDelay * job.delayRatio);
+        output.rightDelay = (uint64_t)std::llround(input.rightDelay * job.delayRatio);
+    }
+}
+
+std::shared_ptr<BRTServices::CHRTF> ConvertHRTFSampleRate(const std::shared_ptr<BRTServices::CHRTF>& _rawHRTF, int _inputRate, int _outputRate, const std::string& _extrapolationMethod, int _numberOfThreads)
+{
+    CHRIRSampleRateConverter converter(_numberOfThreads);
+    return converter.Convert(_rawHRTF, _inputRate, _outputRate, _extrapolationMethod);
+}
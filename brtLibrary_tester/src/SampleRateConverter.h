@@ -0,0 +1,125 @@
+/**
+*
+* \brief Polyphase sample rate conversion of HRIR tables
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+
+#ifndef _SAMPLERATECONVERTER_H_
+#define _SAMPLERATECONVERTER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <BRTLibrary.h>
+#include "RealTimeWorkerPool.hpp"
+
+#define SAMPLE_RATE_CONVERTER_TAPS              32          // Taps of each polyphase branch when upsampling, more when downsampling
+#define SAMPLE_RATE_CONVERTER_BANDWIDTH         0.92        // Passband edge, as a fraction of the Nyquist frequency of the lower rate
+#define SAMPLE_RATE_CONVERTER_KAISER_BETA       9.0         // Kaiser window of the prototype filter, about 90 dB of stopband
+#define SAMPLE_RATE_CONVERTER_HRIRS_PER_TASK    16          // HRIRs converted by each task of the worker pool
+
+/** \brief Rational sample rate converter: upsamples by L, low-pass filters and downsamples by M, with L / M the ratio of both
+*	rates reduced. The prototype is a Kaiser windowed sinc split in L branches, so each output sample costs one branch.
+*	\details The output is aligned with the input (the filter delay is compensated) and has ceil(n L / M) samples. Setup
+*	allocates; Process does not modify the converter, so several threads may use it at the same time.
+*/
+class CPolyphaseResampler {
+public:
+    CPolyphaseResampler();
+
+    /** \brief Designs the filter for a pair of rates
+    *	\param [in] _inputRate Hz
+    *	\param [in] _outputRate Hz
+    *	\retval false if a rate is not positive
+    */
+    bool Setup(int _inputRate, int _outputRate);
+
+    /** \brief Number of output samples for _inputLength input samples
+    */
+    size_t GetOutputLength(size_t _inputLength) const;
+
+    /** \brief Converts a whole signal, with zeros before and after it
+    *	\param [in] _input
+    *	\param [in] _inputLength
+    *	\param [out] _output GetOutputLength(_inputLength) samples
+    */
+    void Process(const float* _input, size_t _inputLength, float* _output) const;
+
+    int GetUpFactor() const { return upFactor; }
+    int GetDownFactor() const { return downFactor; }
+    size_t GetTapsPerPhase() const { return tapsPerPhase; }
+
+private:
+    int upFactor;
+    int downFactor;
+    size_t tapsPerPhase;
+    size_t delay;                                   // Delay of the prototype filter, in samples of the upsampled signal
+    std::vector<double> phases;                     // [phase][tap], tap i of phase p is the prototype sample p + i L
+};
+
+/** \brief Converts the HRIRs of a table read with ReadHRTFFromSofaWithoutProcess to another sample rate, on a worker pool.
+*	HRIRs are scaled by the rate ratio, so the frequency response keeps its gain, and delays are scaled and rounded.
+*	\details Every HRIR is converted by one thread only into its own slot, so the result is bit-identical whatever the number of threads.
+*/
+class CHRIRSampleRateConverter {
+public:
+    /** \brief Spawns the worker threads
+    *	\param [in] _numberOfThreads threads converting the table, the calling one included. 0 uses every core
+    */
+    CHRIRSampleRateConverter(int _numberOfThreads);
+
+    int GetNumberOfThreads() const { return workerPool.GetNumberOfThreads(); }
+
+    /** \brief Builds an HRTF, still to be processed, with the HRIRs of _rawHRTF at the new rate
+    *	\param [in] _rawHRTF
+    *	\param [in] _inputRate sample rate of the SOFA file
+    *	\param [in] _outputRate engine sample rate
+    *	\param [in] _extrapolationMethod
+    *	\retval HRTF with its raw table only, nullptr on error
+    */
+    std::shared_ptr<BRTServices::CHRTF> Convert(const std::shared_ptr<BRTServices::CHRTF>& _rawHRTF, int _inputRate, int _outputRate, const std::string& _extrapolationMethod);
+
+private:
+    struct TConvertJob {
+        const CPolyphaseResampler* resampler;
+        const std::vector<const BRTServices::THRIRStruct*>* input;
+        std::vector<BRTServices::THRIRStruct>* output;
+        float gain;
+        double delayRatio;
+        size_t firstTask;                                    // Task index 0 of the current run of the pool
+    };
+
+    static void ConvertTask(void* _job, int _taskIndex);
+
+    CRealTimeWorkerPool workerPool;
+};
+
+/** \brief Converts the HRIRs of a raw HRTF to the engine sample rate with a CHRIRSampleRateConverter
+*	\param [in] _rawHRTF read with ReadHRTFFromSofaWithoutProcess
+*	\param [in] _inputRate sample rate of the SOFA file
+*	\param [in] _outputRate engine sample rate
+*	\param [in] _extrapolationMethod
+*	\param [in] _numberOfThreads 0 uses every core
+*	\retval HRTF with its raw table only, ready for EndSetup, nullptr on error
+*/
+std::shared_ptr<BRTServices::CHRTF> ConvertHRTFSampleRate(const std::shared_ptr<BRTServices::CHRTF>& _rawHRTF, int _inputRate, int _outputRate, const std::string& _extrapolationMethod, int _numberOfThreads = 0);
+
+#endif
@@ -0,0 +1,272 @@
+/**
+*
+* \brief Streaming reader of RIFF/WAVE files, with a prefetch thread feeding the audio thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#include "StreamingAudioSource.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const uint16_t WAVE_FORMAT_PCM = 0x0001;
+    const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+    const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    // Little-endian readers, for endian-independent parsing (more info in http://soundfile.sapp.org/doc/WaveFormat/)
+    uint16_t ReadUint16(const uint8_t* _bytes) { return uint16_t(_bytes[0] | (_bytes[1] << 8)); }
+    uint32_t ReadUint32(const uint8_t* _bytes) { return uint32_t(_bytes[0]) | (uint32_t(_bytes[1]) << 8) | (uint32_t(_bytes[2]) << 16) | (uint32_t(_bytes[3]) << 24); }
+}
+
+//////////////////////////////
+// WAV STREAM READER
+//////////////////////////////
+
+CWavStreamReader::CWavStreamReader() : data(nullptr), numberOfFrames(0), position(0), sampleFormat(WAV_FORMAT_UNSUPPORTED), numberOfChannels(0),
+    sampleRate(0), bitsPerSample(0), frameSize(0), channel(-1)
+{}
+
+bool CWavStreamReader::Open(const std::string& _filePath)
+{
+    data = nullptr;
+    numberOfFrames = 0;
+    position = 0;
+    if (!file.Open(_filePath)) {
+        std::cout << "Error opening the wav file " << _filePath << std::endl;
+        return false;
+    }
+    if (!ParseHeader()) {
+        std::cout << "Error parsing the wav file " << _filePath << ": unsupported format or corrupted header" << std::endl;
+        file.Close();
+        return false;
+    }
+    file.AdviseSequential();
+    return true;
+}
+
+bool CWavStreamReader::ParseHeader()
+{
+    const uint8_t* bytes = file.GetData();
+    size_t size = file.GetSize();
+    if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) { return false; }
+
+    // Walks the chunks; the RIFF size is not trusted, files written while streaming often leave it wrong
+    bool fmtFound = false;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = bytes + offset;
+        uint64_t chunkSize = ReadUint32(chunk + 4);
+        const uint8_t* chunkData = chunk + 8;
+        size_t remaining = size - offset - 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunkSize < 16 || chunkSize > remaining) { return false; }
+            uint16_t formatTag = ReadUint16(chunkData);
+            numberOfChannels = ReadUint16(chunkData + 2);
+            sampleRate = (int)ReadUint32(chunkData + 4);
+            frameSize = ReadUint16(chunkData + 12);
+            bitsPerSample = ReadUint16(chunkData + 14);
+            if (formatTag == WAVE_FORMAT_EXTENSIBLE) {
+                if (chunkSize < 40) { return false; }
+                formatTag = ReadUint16(chunkData + 24);             // First two bytes of the subformat GUID
+            }
+            int containerBits = (numberOfChannels > 0) ? 8 * frameSize / numberOfChannels : 0;
+            if (formatTag == WAVE_FORMAT_PCM && containerBits == 16) { sampleFormat = WAV_FORMAT_INT16; }
+            else if (formatTag == WAVE_FORMAT_PCM && containerBits == 24) { sampleFormat = WAV_FORMAT_INT24; }
+            else if (formatTag == WAVE_FORMAT_PCM && containerBits == 32) { sampleFormat = WAV_FORMAT_INT32; }     // Also 24 bit in 32 bit containers
+            else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && containerBits == 32) { sampleFormat = WAV_FORMAT_FLOAT32; }
+            else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && containerBits == 64) { sampleFormat = WAV_FORMAT_FLOAT64; }
+            else { return false; }
+            fmtFound = true;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!fmtFound || frameSize <= 0) { return false; }
+            if (chunkSize > remaining || chunkSize == 0xFFFFFFFF) { chunkSize = remaining; }      // Truncated or unfinished file
+            data = chunkData;
+            numberOfFrames = chunkSize / frameSize;
+            return true;
+        }
+        offset += 8 + (size_t)chunkSize + (chunkSize & 1);          // Chunks are padded to an even size
+    }
+    return false;
+}
+
+float CWavStreamReader::DecodeSample(const uint8_t* _sample) const
+{
+    switch (sampleFormat) {
+    case WAV_FORMAT_INT16:
+        return (float)int16_t(ReadUint16(_sample)) / 32768.0f;
+    case WAV_FORMAT_INT24:
+        return (float)(int32_t(uint32_t(_sample[0]) << 8 | uint32_t(_sample[1]) << 16 | uint32_t(_sample[2]) << 24) >> 8) / 8388608.0f;
+    case WAV_FORMAT_INT32:
+        return (float)((double)int32_t(ReadUint32(_sample)) / 2147483648.0);
+    case WAV_FORMAT_FLOAT32: {
+        uint32_t bits = ReadUint32(_sample);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    case WAV_FORMAT_FLOAT64: {
+        uint64_t bits = uint64_t(ReadUint32(_sample)) | (uint64_t(ReadUint32(_sample + 4)) << 32);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return (float)value;
+    }
+    default:
+        return 0.0f;
+    }
+}
+
+size_t CWavStreamReader::ReadFrames(float* _output, size_t _numberOfFrames, bool _loop)
+{
+    if (data == nullptr || numberOfFrames == 0) { return 0; }
+    int sampleSize = frameSize / numberOfChannels;
+    bool downmix = (channel < 0 || channel >= numberOfChannels);
+    float downmixGain = 1.0f / numberOfChannels;
+
+    size_t framesRead = 0;
+    if (numberOfChannels == 1 && sampleFormat != WAV_FORMAT_FLOAT64) {
+        // Mono: contiguous runs converted by the SIMD kernels
+        const TAudioKernels& kernels = GetAudioKernels();
+        while (framesRead < _numberOfFrames) {
+            if (position >= numberOfFrames) {
+                if (!_loop) { break; }
+                position = 0;
+            }
+            size_t run = (size_t)std::min<uint64_t>(_numberOfFrames - framesRead, numberOfFrames - position);
+            const uint8_t* samples = data + position * frameSize;
+            float* output = _output + framesRead;
+            switch (sampleFormat) {
+            case WAV_FORMAT_INT16: kernels.ConvertInt16ToFloat(samples, output, run); break;
+            case WAV_FORMAT_INT24: kernels.ConvertInt24ToFloat(samples, output, run); break;
+            case WAV_FORMAT_INT32: kernels.ConvertInt32ToFloat(samples, output, run); break;
+            default: kernels.ConvertFloat32ToFloat(samples, output, run); break;
+            }
+            position += run;
+            framesRead += run;
+        }
+        return framesRead;
+    }
+    while (framesRead < _numberOfFrames) {
+        if (position >= numberOfFrames) {
+            if (!_loop) { break; }
+            position = 0;
+        }
+        const uint8_t* frame = data + position * frameSize;
+        if (downmix) {
+            float sum = 0.0f;
+            for (int c = 0; c < numberOfChannels; c++) { sum += DecodeSample(frame + c * sampleSize); }
+            _output[framesRead] = sum * downmixGain;
+        }
+        else {
+            _output[framesRead] = DecodeSample(frame + channel * sampleSize);
+        }
+        position++;
+        framesRead++;
+    }
+    return framesRead;
+}
+
+//////////////////////////////
+// STREAMING AUDIO SOURCE
+//////////////////////////////
+
+CStreamingAudioSource::CStreamingAudioSource() : stopRequested(false), waitOnUnderrun(false), underrunFrames(0)
+{}
+
+CStreamingAudioSource::~CStreamingAudioSource()
+{
+    Close();
+}
+
+bool CStreamingAudioSource::Open(const std::string& _filePath, int _sampleRate, int _channel)
+{
+    Close();
+    if (!reader.Open(_filePath)) { return false; }
+    if (reader.GetSampleRate() != _sampleRate) {
+        std::cout << "Error streaming " << _filePath << ": it is at " << reader.GetSampleRate() << " Hz and the engine at " << _sampleRate << " Hz" << std::endl;
+        return false;
+    }
+    reader.SetChannel(_channel);
+    std::cout << "Streaming " << _filePath << ": " << reader.GetNumberOfChannels() << " channel(s), " << reader.GetBitsPerSample() << " bit, "
+        << reader.GetSampleRate() << " Hz, " << (double)reader.GetNumberOfFrames() / reader.GetSampleRate() << " s" << std::endl;
+
+    ring.reset(new CSPSCRingBuffer<float>((size_t)(STREAMING_SOURCE_RING_SECONDS * reader.GetSampleRate())));
+    chunk.resize(STREAMING_SOURCE_CHUNK_FRAMES);
+    underrunFrames.store(0, std::memory_order_relaxed);
+    Prefetch();                                                 // Ring full before the first block
+    stopRequested.store(false, std::memory_order_relaxed);
+    prefetchThread = std::thread(&CStreamingAudioSource::PrefetchLoop, this);
+    return true;
+}
+
+void CStreamingAudioSource::Close()
+{
+    stopRequested.store(true, std::memory_order_relaxed);
+    if (prefetchThread.joinable()) { prefetchThread.join(); }
+    ring.reset();
+}
+
+void CStreamingAudioSource::FillBuffer(CMonoBuffer<float>& _output)
+{
+    size_t framesRead = (ring != nullptr) ? ring->Read(_output.data(), _output.size()) : 0;
+    while (framesRead < _output.size() && ring != nullptr && waitOnUnderrun.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+        framesRead += ring->Read(_output.data() + framesRead, _output.size() - framesRead);
+    }
+    if (framesRead < _output.size()) {
+        std::fill(_output.begin() + framesRead, _output.end(), 0.0f);
+        underrunFrames.fetch_add(_output.size() - framesRead, std::memory_order_relaxed);
+    }
+}
+
+void CStreamingAudioSource::PrefetchLoop()
+{
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        Prefetch();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+void CStreamingAudioSource::Prefetch()
+{
+    while (ring->GetWriteAvailable() >= chunk.size()) {
+        size_t framesDecoded = reader.ReadFrames(chunk.data(), chunk.size(), true);
+        if (framesDecoded == 0) { return; }
+        ring->Write(chunk.data(), framesDecoded);
+    }
+}
+
+bool LoadWavExcerpt(std::vector<float>& _samples, const std::string& _filePath, float _maximumSeconds, int _sampleRate)
+{
+    CWavStreamReader reader;
+    if (!reader.Open(_filePath)) { return false; }
+    if (reader.GetSampleRate() != _sampleRate) {
+        std::cout << "Error reading " << _filePath << ": it is at " << reader.GetSampleRate() << " Hz and the engine at " << _sampleRate << " Hz" << std::endl;
+        return false;
+    }
+    uint64_t numberOfFrames = std::min<uint64_t>(reader.GetNumberOfFrames(), (uint64_t)(_maximumSeconds * reader.GetSampleRate()));
+    _samples.resize((size_t)numberOfFrames);
+    _samples.resize(reader.ReadFrames(_samples.data(), _samples.size(), false));
+    return true;
+}
@@ -0,0 +1,163 @@
+/**
+*
+* \brief Streaming reader of RIFF/WAVE files, with a prefetch thread feeding the audio thread
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _STREAMINGAUDIOSOURCE_H_
+#define _STREAMINGAUDIOSOURCE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <BRTLibrary.h>
+#include "MappedFile.hpp"
+#include "SPSCRingBuffer.hpp"
+
+#define STREAMING_SOURCE_RING_SECONDS       1.0f        // Audio prefetched ahead of the audio thread
+#define STREAMING_SOURCE_CHUNK_FRAMES       4096        // Frames decoded by the prefetch thread at a time
+
+/** \brief Sample formats of the data chunk
+*/
+enum TWavSampleFormat { WAV_FORMAT_UNSUPPORTED, WAV_FORMAT_INT16, WAV_FORMAT_INT24, WAV_FORMAT_INT32, WAV_FORMAT_FLOAT32, WAV_FORMAT_FLOAT64 };
+
+/** \brief Reads the frames of a ".wav" file as mono float, without loading it in memory. The file is mapped and its RIFF chunks
+*	parsed, so the header can have any size and chunk order. PCM 16, 24 and 32 bit, IEEE float 32 and 64 bit and
+*	WAVE_FORMAT_EXTENSIBLE files are supported, with any number of channels.
+*/
+class CWavStreamReader {
+public:
+    CWavStreamReader();
+
+    /** \brief Opens a file and parses its header
+    *	\param [in] _filePath
+    *	\retval true if the file is a supported ".wav" file
+    */
+    bool Open(const std::string& _filePath);
+
+    /** \brief Selects the channel read as mono
+    *	\param [in] _channel channel index, or -1 to average all the channels
+    */
+    void SetChannel(int _channel) { channel = _channel; }
+
+    /** \brief Decodes the next frames. When _loop is true, reading continues from the beginning at the end of the file
+    *	\param [out] _output mono samples, in [-1, 1] for integer formats
+    *	\param [in] _numberOfFrames
+    *	\param [in] _loop
+    *	\retval number of frames decoded
+    */
+    size_t ReadFrames(float* _output, size_t _numberOfFrames, bool _loop);
+
+    /** \brief Moves the read position
+    *	\param [in] _frame
+    */
+    void Seek(uint64_t _frame) { position = (_frame < numberOfFrames) ? _frame : numberOfFrames; }
+
+    uint64_t GetNumberOfFrames() const { return numberOfFrames; }
+    int GetNumberOfChannels() const { return numberOfChannels; }
+    int GetSampleRate() const { return sampleRate; }
+    int GetBitsPerSample() const { return bitsPerSample; }
+    TWavSampleFormat GetSampleFormat() const { return sampleFormat; }
+
+private:
+    bool ParseHeader();
+    float DecodeSample(const uint8_t* _sample) const;
+
+    CMappedFile file;
+    const uint8_t* data;                                    // First byte of the data chunk
+    uint64_t numberOfFrames;
+    uint64_t position;                                      // Next frame to read
+    TWavSampleFormat sampleFormat;
+    int numberOfChannels;
+    int sampleRate;
+    int bitsPerSample;
+    int frameSize;                                          // Bytes per frame
+    int channel;
+};
+
+/** \brief Mono audio source streamed from a ".wav" file. A prefetch thread decodes the file ahead into a lock-free ring buffer
+*	and the audio thread only reads from the ring, so it never touches the disk nor waits. The file is played in a loop.
+*/
+class CStreamingAudioSource {
+public:
+    CStreamingAudioSource();
+    ~CStreamingAudioSource();
+
+    CStreamingAudioSource(const CStreamingAudioSource&) = delete;
+    CStreamingAudioSource& operator=(const CStreamingAudioSource&) = delete;
+
+    /** \brief Opens the file and starts the prefetch thread, which fills the ring before this method returns
+    *	\param [in] _filePath
+    *	\param [in] _sampleRate engine sample rate. Files at another rate are rejected, they are not resampled
+    *	\param [in] _channel channel played, -1 averages all the channels
+    *	\retval true if the file could be opened and is at _sampleRate
+    */
+    bool Open(const std::string& _filePath, int _sampleRate, int _channel = -1);
+
+    /** \brief True once a file has been opened, false when it could not be
+    */
+    bool IsOpen() const { return ring != nullptr; }
+
+    /** \brief Stops the prefetch thread and closes the file
+    */
+    void Close();
+
+    /** \brief Audio thread. Fills the buffer with the next frames; missing frames (underrun) are zeros and counted
+    *	\param [out] _output
+    */
+    void FillBuffer(CMonoBuffer<float>& _output);
+
+    /** \brief When true, FillBuffer waits for the prefetch thread instead of outputting zeros. For offline rendering, which runs
+    *	faster than real time and must not depend on timing
+    *	\param [in] _wait
+    */
+    void SetWaitOnUnderrun(bool _wait) { waitOnUnderrun.store(_wait, std::memory_order_relaxed); }
+
+    /** \brief Number of frames output as zeros because the ring was empty
+    */
+    uint64_t GetUnderrunFrames() const { return underrunFrames.load(std::memory_order_relaxed); }
+
+    const CWavStreamReader& GetReader() const { return reader; }
+
+private:
+    void PrefetchLoop();
+    void Prefetch();
+
+    CWavStreamReader reader;
+    std::unique_ptr<CSPSCRingBuffer<float>> ring;
+    std::vector<float> chunk;                               // Prefetch thread decoding buffer
+    std::thread prefetchThread;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> waitOnUnderrun;
+    std::atomic<uint64_t> underrunFrames;
+};
+
+/** \brief Decodes the beginning of a ".wav" file in memory, as mono float
+*	\param [out] _samples
+*	\param [in] _filePath
+*	\param [in] _maximumSeconds longest excerpt read
+*	\param [in] _sampleRate engine sample rate. Files at another rate are rejected, they are not resampled
+*	\retval true if the file could be read and is at _sampleRate
+*/
+bool LoadWavExcerpt(std::vector<float>& _samples, const std::string& _filePath, float _maximumSeconds, int _sampleRate);
+
+#endif
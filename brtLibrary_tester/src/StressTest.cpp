@@ -0,0 +1,385 @@
+/**
+*
+* \brief Scalability stress test with many moving sources
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#include "StressTest.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace {
+    const double PI = 3.14159265358979323846;
+
+    double DegreesToRadians(double _degrees) { return _degrees * PI / 180.0; }
+
+    /// Distributes sources around the listener with different speeds and directions. Every speed completes a whole number
+    /// of turns in STRESS_TEST_TRAJECTORY_PERIOD, so the path loops without jumps. Near field sources are spread from 0.2 to 1.7 m
+    TTrajectoryPath CreateTrajectory(int _sourceIndex, int _numberOfSources, bool _nearField) {
+        float initialAzimuth = 360.0f * _sourceIndex / _numberOfSources;
+        float initialElevation = -45.0f + 90.0f * ((_sourceIndex * 7) % 11) / 10.0f;
+        float azimuthSpeed = (_sourceIndex % 2 == 0 ? 1.0f : -1.0f) * (20.0f + 10.0f * (_sourceIndex % 5));     // Degrees per second
+        float elevationSpeed = (_sourceIndex % 3 == 0) ? 15.0f : 0.0f;
+        float distance = _nearField ? STRESS_TEST_NEAR_FIELD_DISTANCE + 0.3f * (_sourceIndex % 6) : STRESS_TEST_SOURCE_DISTANCE + 0.25f * (_sourceIndex % 4);
+
+        TTrajectoryPath path;
+        path.loop = true;
+        int numberOfKeyframes = (int)(STRESS_TEST_TRAJECTORY_PERIOD / STRESS_TEST_KEYFRAME_STEP) + 1;
+        for (int k = 0; k < numberOfKeyframes; k++) {
+            float time = k * STRESS_TEST_KEYFRAME_STEP;
+            float elevation = initialElevation + (float)(30.0 * std::sin(DegreesToRadians(elevationSpeed * time)));
+            path.keyframes.push_back({ time, initialAzimuth + azimuthSpeed * time, elevation, distance });
+        }
+        return path;
+    }
+}
+
+CStressScene::CStressScene(std::shared_ptr<BRTServices::CHRTF> _hrtf, int _numberOfSources, const std::vector<float>& _sourceSamples, bool _enableOnlineInterpolation,
+    int _numberOfLanes, CRealTimeWorkerPool* _workerPool, std::shared_ptr<BRTServices::CILD> _nearFieldILD)
+    : workerPool(_workerPool), sourceSamples(_sourceSamples), blockIndex(0), numberOfSources(_numberOfSources)
+{
+    Common::CGlobalParameters globalParameters;
+    bufferSize = globalParameters.GetBufferSize();
+    sampleRate = globalParameters.GetSampleRate();
+
+    int numberOfLanes = std::max(1, std::min(_numberOfLanes, _numberOfSources));
+    for (int l = 0; l < numberOfLanes; l++) {
+        std::unique_ptr<TStressLane> lane(new TStressLane());
+        lane->brtManager.BeginSetup();
+        lane->listener = lane->brtManager.CreateListener<BRTListenerModel::CListenerHRTFbasedModel>("stressListener" + std::to_string(l));
+        for (int i = l; i < _numberOfSources; i += numberOfLanes) {        // Round robin, so lanes get the same load
+            std::shared_ptr<BRTSourceModel::CSourceSimpleModel> source = lane->brtManager.CreateSoundSource<BRTSourceModel::CSourceSimpleModel>("stressSource" + std::to_string(i));
+            lane->listener->ConnectSoundSource(source);
+            lane->sources.push_back(source);
+            lane->trajectories.AddPath(CreateTrajectory(i, _numberOfSources, _nearFieldILD != nullptr));
+            lane->sourceInputs.push_back(CMonoBuffer<float>(bufferSize));
+            lane->samplePositions.push_back(sourceSamples.empty() ? 0 : (sourceSamples.size() * i / _numberOfSources));     // Decorrelated inputs
+        }
+        lane->brtManager.EndSetup();
+
+        Common::CTransform listenerPosition = Common::CTransform();
+        listenerPosition.SetPosition(Common::CVector3(0, 0, 0));
+        lane->listener->SetListenerTransform(listenerPosition);
+        lane->listener->SetHRTF(_hrtf);
+        if (_nearFieldILD != nullptr) {
+            lane->listener->SetILD(_nearFieldILD);
+            lane->listener->EnableNearFieldEffect();
+        }
+        else { lane->listener->DisableNearFieldEffect(); }
+        if (_enableOnlineInterpolation) { lane->listener->EnableInterpolation(); }
+        else { lane->listener->DisableInterpolation(); }
+
+        lane->output.left.resize(bufferSize);
+        lane->output.right.resize(bufferSize);
+        MoveSources(*lane);
+        lanes.push_back(std::move(lane));
+    }
+    output.left.resize(bufferSize);
+    output.right.resize(bufferSize);
+}
+
+void CStressScene::ProcessBlock()
+{
+    if (workerPool != nullptr && lanes.size() > 1) {
+        workerPool->Run((int)lanes.size(), &CStressScene::ProcessLaneTask, this);
+    }
+    else {
+        for (std::unique_ptr<TStressLane>& lane : lanes) { ProcessLane(*lane); }
+    }
+    MixLanes();
+    blockIndex++;
+    for (std::unique_ptr<TStressLane>& lane : lanes) { MoveSources(*lane); }
+}
+
+void CStressScene::ProcessLaneTask(void* _scene, int _laneIndex)
+{
+    CStressScene* scene = static_cast<CStressScene*>(_scene);
+    scene->ProcessLane(*scene->lanes[_laneIndex]);
+}
+
+void CStressScene::ProcessLane(TStressLane& _lane)
+{
+    FillSourceInputs(_lane);
+    _lane.brtManager.ProcessAll();
+    _lane.listener->GetBuffers(_lane.output.left, _lane.output.right);
+}
+
+void CStressScene::MixLanes()
+{
+    if (lanes.size() == 1) {
+        output.left = lanes[0]->output.left;           // Same size, no reallocation
+        output.right = lanes[0]->output.right;
+        return;
+    }
+    const TAudioKernels& kernels = GetAudioKernels();
+    kernels.Fill(output.left.data(), 0.0f, bufferSize);
+    kernels.Fill(output.right.data(), 0.0f, bufferSize);
+    for (std::unique_ptr<TStressLane>& lane : lanes) {              // Fixed order, deterministic result
+        kernels.Accumulate(output.left.data(), lane->output.left.data(), bufferSize);
+        kernels.Accumulate(output.right.data(), lane->output.right.data(), bufferSize);
+    }
+}
+
+void CStressScene::MoveSources(TStressLane& _lane)
+{
+    double startTime = (double)blockIndex * bufferSize / sampleRate;
+    double endTime = (double)(blockIndex + 1) * bufferSize / sampleRate;
+    _lane.trajectories.Evaluate(startTime, endTime, Common::CVector3(0, 0, 0));
+    for (size_t i = 0; i < _lane.sources.size(); i++) {
+        Common::CTransform sourceTransform = _lane.sources[i]->GetCurrentSourceTransform();
+        sourceTransform.SetPosition(_lane.trajectories.GetCentrePosition((int)i));
+        _lane.sources[i]->SetSourceTransform(sourceTransform);
+    }
+}
+
+void CStressScene::FillSourceInputs(TStressLane& _lane)
+{
+    for (size_t i = 0; i < _lane.sources.size(); i++) {
+        CMonoBuffer<float>& input = _lane.sourceInputs[i];
+        size_t& samplePosition = _lane.samplePositions[i];
+        for (int j = 0; j < bufferSize; j++) {
+            if (sourceSamples.empty()) { input[j] = 0.0f; continue; }
+            input[j] = sourceSamples[samplePosition];
+            if (++samplePosition >= sourceSamples.size()) { samplePosition = 0; }     // Looping
+        }
+        _lane.sources[i]->SetBuffer(input);
+    }
+}
+
+TTimingStatistics RunStressTest(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings)
+{
+    Common::CGlobalParameters globalParameters;
+    double deadline = 1000.0 * globalParameters.GetBufferSize() / globalParameters.GetSampleRate();
+
+    std::unique_ptr<CRealTimeWorkerPool> workerPool;
+    if (_settings.numberOfThreads > 1) { workerPool.reset(new CRealTimeWorkerPool(_settings.numberOfThreads, _settings.realTimePriority)); }
+    int numberOfLanes = _settings.numberOfLanes > 0 ? _settings.numberOfLanes : _settings.numberOfThreads;
+    std::unique_ptr<CStressScene> scene(new CStressScene(_hrtf, _settings.numberOfSources, _sourceSamples, _settings.enableOnlineInterpolation,
+        numberOfLanes, workerPool.get(), _settings.nearFieldILD));
+    for (int i = 0; i < _settings.warmupBlocks; i++) { scene->ProcessBlock(); }
+
+    std::vector<double> blockTimes;
+    blockTimes.reserve(_settings.measuredBlocks);
+    for (int i = 0; i < _settings.measuredBlocks; i++) {
+        CStopwatch stopwatch;
+        scene->ProcessBlock();
+        blockTimes.push_back(stopwatch.GetElapsedMilliseconds());
+    }
+    return ComputeTimingStatistics(blockTimes, deadline);
+}
+
+int FindMaximumNumberOfSources(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings, bool _verbose)
+{
+    TStressTestSettings settings = _settings;
+    auto meetsDeadline = [&](int _numberOfSources) {
+        settings.numberOfSources = _numberOfSources;
+        TTimingStatistics statistics = RunStressTest(_hrtf, _sourceSamples, settings);
+        if (_verbose) { PrintTimingStatisticsRow(std::to_string(_numberOfSources), statistics); }
+        return statistics.p99 <= statistics.deadline;
+    };
+
+    if (_verbose) { PrintTimingStatisticsHeader("sources"); }
+
+    // Doubling until the deadline is missed, then bisection
+    int lastGood = 0;
+    int firstBad = 1;
+    while (firstBad <= STRESS_TEST_MAX_SOURCES && meetsDeadline(firstBad)) {
+        lastGood = firstBad;
+        firstBad *= 2;
+    }
+    if (firstBad > STRESS_TEST_MAX_SOURCES) { return lastGood; }
+    while (firstBad - lastGood > 1) {
+        int middle = (lastGood + firstBad) / 2;
+        if (meetsDeadline(middle)) { lastGood = middle; }
+        else { firstBad = middle; }
+    }
+    return lastGood;
+}
+
+void RunStressTestBufferSizeSweep(THRTFProvider _hrtfProvider, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings)
+{
+    Common::CGlobalParameters globalParameters;
+    int originalBufferSize = globalParameters.GetBufferSize();
+
+    std::vector<int> bufferSizes;
+    std::vector<int> maximumSources;
+    for (int bufferSize = 128; bufferSize <= 4096; bufferSize *= 2) {
+        globalParameters.SetBufferSize(bufferSize);
+        std::cout << std::endl << "Buffer size " << bufferSize << " (deadline " << 1000.0 * bufferSize / globalParameters.GetSampleRate() << " ms)" << std::endl;
+        std::shared_ptr<BRTServices::CHRTF> hrtf = _hrtfProvider(bufferSize);
+        if (hrtf == nullptr) { continue; }
+        bufferSizes.push_back(bufferSize);
+        maximumSources.push_back(FindMaximumNumberOfSources(hrtf, _sourceSamples, _settings, true));
+    }
+    globalParameters.SetBufferSize(originalBufferSize);
+
+    std::cout << std::endl << "Maximum number of sources meeting the deadline (p99):" << std::endl;
+    for (size_t i = 0; i < bufferSizes.size(); i++) {
+        std::cout << "  buffer " << bufferSizes[i] << ":\t" << maximumSources[i] << (maximumSources[i] >= STRESS_TEST_MAX_SOURCES ? " (limit)" : "") << std::endl;
+    }
+}
+
+void RunStressTestThreadComparison(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings)
+{
+    int numberOfLanes = std::max(1, std::min(_settings.numberOfThreads, _settings.numberOfSources));
+    TStressTestSettings singleLaneSettings = _settings;
+    singleLaneSettings.numberOfThreads = 1;
+    singleLaneSettings.numberOfLanes = 1;
+    TStressTestSettings serialLanesSettings = singleLaneSettings;
+    serialLanesSettings.numberOfLanes = numberOfLanes;
+    TStressTestSettings parallelSettings = _settings;
+    parallelSettings.numberOfLanes = numberOfLanes;
+    TTimingStatistics singleLane = RunStressTest(_hrtf, _sourceSamples, singleLaneSettings);
+    TTimingStatistics serialLanes = RunStressTest(_hrtf, _sourceSamples, serialLanesSettings);
+    TTimingStatistics parallel = RunStressTest(_hrtf, _sourceSamples, parallelSettings);
+
+    std::string lanes = std::to_string(numberOfLanes);
+    PrintTimingStatisticsHeader("lanes/thr");
+    PrintTimingStatisticsRow("1/1", singleLane);
+    PrintTimingStatisticsRow(lanes + "/1", serialLanes);
+    PrintTimingStatisticsRow(lanes + "/" + std::to_string(_settings.numberOfThreads), parallel);
+    if (parallel.mean > 0 && serialLanes.mean > 0) {
+        // Each lane renders a copy of the listener, so the lanes cost more than the single manager even on one thread
+        std::cout << "Lane overhead on one thread: " << 100.0 * (serialLanes.mean / singleLane.mean - 1.0) << "% (listener copies)" << std::endl;
+        std::cout << "Pool speedup, same lanes: mean " << serialLanes.mean / parallel.mean << "x, p99 " << serialLanes.p99 / parallel.p99 << "x" << std::endl;
+        std::cout << "Net gain over one lane: mean " << singleLane.mean / parallel.mean << "x, p99 " << singleLane.p99 / parallel.p99 << "x" << std::endl;
+    }
+    std::cout << "The lanes only approximate a parallel ProcessAll for this test: the live and offline renders process every source serially"
+        << " in one BRT manager" << std::endl;
+}
+
+void RunNearFieldStressTest(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings)
+{
+    if (_settings.nearFieldILD == nullptr) {
+        std::cout << "Near field stress test needs the near field ILD" << std::endl;
+        return;
+    }
+    int numberOfSources = std::max(1, _settings.numberOfSources);
+
+    // Library scene, near field disabled and enabled (same trajectories)
+    TStressTestSettings farSettings = _settings;
+    farSettings.nearFieldILD = nullptr;
+    TTimingStatistics far = RunStressTest(_hrtf, _sourceSamples, farSettings);
+    TTimingStatistics near = RunStressTest(_hrtf, _sourceSamples, _settings);
+    PrintTimingStatisticsHeader("near field");
+    PrintTimingStatisticsRow("off", far);
+    PrintTimingStatisticsRow("on", near);
+    std::cout << "Per source: " << 1000.0 * far.mean / numberOfSources << " us off, " << 1000.0 * near.mean / numberOfSources << " us on, near field "
+        << 1000.0 * (near.mean - far.mean) / numberOfSources << " us" << std::endl;
+
+    // Near field filters alone
+    Common::CGlobalParameters globalParameters;
+    int bufferSize = globalParameters.GetBufferSize();
+    int sampleRate = globalParameters.GetSampleRate();
+    CILDCoefficientTable table;
+    CStopwatch buildStopwatch;
+    if (!table.Build(_settings.nearFieldILD)) {
+        std::cout << "The ILD does not give " << NEARFIELD_STAGES << " biquads per ear, the coefficient table can not be built" << std::endl;
+        return;
+    }
+    double buildTime = buildStopwatch.GetElapsedMilliseconds();
+
+    CTrajectoryEngine trajectories;
+    for (int i = 0; i < numberOfSources; i++) { trajectories.AddPath(CreateTrajectory(i, numberOfSources, true)); }
+    size_t numberOfChannels = 2 * (size_t)numberOfSources;
+    CBiquadCascadeBank bank;
+    bank.Setup(numberOfChannels, bufferSize);
+    std::vector<Common::CBiquadFilter> referenceFilters(numberOfChannels * NEARFIELD_STAGES);      // Library biquads, [channel][stage]
+    std::vector<CMonoBuffer<float>> references(numberOfChannels, CMonoBuffer<float>(bufferSize));
+    std::vector<float> input(bufferSize);
+    std::vector<float> output(bufferSize);
+    float coefficients[NEARFIELD_COEFFICIENTS];
+    double referenceTime = 0;
+    double bankTime = 0;
+    double squaredDifference = 0;
+    double squaredReference = 0;
+    float maximumDifference = 0;
+    float maximumOutput = 0;
+    size_t worstChannel = 0;
+    int totalBlocks = _settings.warmupBlocks + _settings.measuredBlocks;
+    for (int block = 0; block < totalBlocks; block++) {
+        trajectories.Evaluate((double)block * bufferSize / sampleRate, (double)(block + 1) * bufferSize / sampleRate, Common::CVector3(0, 0, 0));
+        bool measured = block >= _settings.warmupBlocks;
+        size_t readPosition = _sourceSamples.empty() ? 0 : ((size_t)block * bufferSize) % _sourceSamples.size();
+
+        // Coefficients from the ILD every block, one cascade of library biquads per channel
+        double elapsed = 0;
+        for (size_t channel = 0; channel < numberOfChannels; channel++) {
+            for (int j = 0; j < bufferSize; j++) { input[j] = _sourceSamples.empty() ? 0.0f : _sourceSamples[(readPosition + channel * 997 + j) % _sourceSamples.size()]; }
+            Common::CVector3 position = trajectories.GetCentrePosition((int)(channel / 2));
+            Common::T_ear ear = (channel % 2 == 0) ? Common::LEFT : Common::RIGHT;
+            CMonoBuffer<float>& reference = references[channel];
+            CStopwatch stopwatch;
+            std::vector<float> exact = _settings.nearFieldILD->GetILDNearFieldEffectCoefficients(ear, position.GetDistance(), position.GetInterauralAzimuthDegrees());
+            std::copy(input.begin(), input.end(), reference.begin());
+            for (int stage = 0; stage < NEARFIELD_STAGES; stage++) {
+                const float* c = &exact[stage * 5];
+                Common::CBiquadFilter& filter = referenceFilters[channel * NEARFIELD_STAGES + stage];
+                filter.SetCoefficients(c[0], c[1], c[2], c[3], c[4]);
+                filter.Process(reference);
+            }
+            elapsed += stopwatch.GetElapsedMilliseconds();
+            bank.SetInput(channel, input.data());
+        }
+        if (measured) { referenceTime += elapsed; }
+
+        // Table and SIMD lanes. Inputs were copied in above, outside the timing, as the reference reads them in place
+        CStopwatch stopwatch;
+        for (size_t channel = 0; channel < numberOfChannels; channel++) {
+            Common::CVector3 position = trajectories.GetCentrePosition((int)(channel / 2));
+            table.Lookup((channel % 2 == 0) ? Common::LEFT : Common::RIGHT, position.GetDistance(), position.GetInterauralAzimuthDegrees(), coefficients);
+            bank.SetCoefficients(channel, coefficients);
+        }
+        bank.Process();
+        if (measured) { bankTime += stopwatch.GetElapsedMilliseconds(); }
+
+        // Every channel against its library cascade
+        for (size_t channel = 0; channel < numberOfChannels; channel++) {
+            bank.GetOutput(channel, output.data());
+            const CMonoBuffer<float>& reference = references[channel];
+            for (int j = 0; j < bufferSize; j++) {
+                float difference = std::fabs(output[j] - reference[j]);
+                squaredDifference += (double)difference * difference;
+                squaredReference += (double)reference[j] * reference[j];
+                maximumOutput = std::max(maximumOutput, std::fabs(reference[j]));
+                if (difference <= maximumDifference) { continue; }
+                maximumDifference = difference;
+                worstChannel = channel;
+            }
+        }
+    }
+
+    double measuredSourceBlocks = (double)std::max(1, _settings.measuredBlocks) * numberOfSources;
+    std::cout << std::endl << "Near field filters, " << numberOfSources << " sources (" << numberOfChannels << " biquad cascades of " << NEARFIELD_STAGES << " stages)" << std::endl;
+    std::cout << "  ILD every block, library biquads per ear:\t" << 1000.0 * referenceTime / measuredSourceBlocks << " us per source" << std::endl;
+    std::cout << "  Table and " << GetAudioKernels().name << " lanes:\t\t" << 1000.0 * bankTime / measuredSourceBlocks << " us per source" << std::endl;
+    if (bankTime > 0) { std::cout << "  Speedup: " << referenceTime / bankTime << "x" << std::endl; }
+    std::cout << "  Table: " << table.GetMemoryBytes() / 1024 << " KB, built in " << buildTime << " ms" << std::endl;
+    // The table interpolates the coefficients, and each filter moves from one block's coefficients to the next its own way, so
+    // both outputs are not expected to be the same bits; this is the error of the table and lanes against the library filters
+    std::cout << "  Difference with the library biquads, all " << numberOfChannels << " channels: maximum " << maximumDifference << " (channel " << worstChannel
+        << ", peak output " << maximumOutput << "), error to signal ratio ";
+    if (squaredDifference > 0 && squaredReference > 0) { std::cout << 10.0 * std::log10(squaredDifference / squaredReference) << " dB" << std::endl; }
+    else { std::cout << (squaredDifference > 0 ? "undefined (silent reference)" : "-inf dB (same output)") << std::endl; }
+    std::cout << "  Prototype only: the library listeners still recompute their coefficients every block, and the tester listener"
+        << " keeps the near field effect disabled unless the menu enables it" << std::endl;
+}
@@ -0,0 +1,168 @@
+/**
+*
+* \brief Scalability stress test with many moving sources
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _STRESSTEST_H_
+#define _STRESSTEST_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <BRTLibrary.h>
+#include "NearFieldFilterBank.h"
+#include "ProcessingStatistics.hpp"
+#include "RealTimeWorkerPool.hpp"
+#include "TrajectoryEngine.h"
+
+#define STRESS_TEST_WARMUP_BLOCKS       50
+#define STRESS_TEST_MEASURED_BLOCKS     1000
+#define STRESS_TEST_MAX_SOURCES         1024
+#define STRESS_TEST_SOURCE_DISTANCE     1.5f
+#define STRESS_TEST_NEAR_FIELD_DISTANCE 0.2f                // Closest source when the near field effect is enabled
+#define STRESS_TEST_TRAJECTORY_PERIOD   72.0f               // Seconds, after which every stress source is back where it started
+#define STRESS_TEST_KEYFRAME_STEP       0.25f
+
+/** \brief Settings of a stress test run
+*/
+struct TStressTestSettings {
+    int numberOfSources = 32;                                   // Sources connected to the listener
+    int warmupBlocks = STRESS_TEST_WARMUP_BLOCKS;               // Blocks processed before measuring
+    int measuredBlocks = STRESS_TEST_MEASURED_BLOCKS;           // Blocks whose processing time is measured
+    bool enableOnlineInterpolation = true;                      // Listener online interpolation
+    int numberOfThreads = 1;                                    // 1 processes every source serially in one BRT manager
+    int numberOfLanes = 0;                                      // BRT managers the sources are split among, 0 for one per thread
+    bool realTimePriority = true;                               // Try to run the worker threads at real-time priority
+    std::shared_ptr<BRTServices::CILD> nearFieldILD;            // Enables the listener near field effect, with the sources within 2 m. nullptr disables it
+};
+
+/** \brief Scene with one listener and N moving sources, built on its own BRT managers so it does not interfere with the
+*	tester scene. Everything the blocks need is allocated in the constructor.
+*	\details The sources are split among lanes; each lane is an independent BRT manager with a copy of the listener (same HRTF
+*	and transform) and its share of the sources, so lanes can be processed at the same time on a worker pool. The binaural output
+*	is the sum of the lane outputs, always added in lane order so the result does not depend on the thread scheduling.
+*	This is a stress-only approximation of a parallel ProcessAll. The library processes the sources of one manager serially, so
+*	each lane repeats the listener work, and the live and offline renders of the tester stay serial in a single manager.
+*/
+class CStressScene {
+public:
+    /** \brief Creates the listener and connects _numberOfSources sources with independent trajectories
+    *	\param [in] _hrtf listener HRTF, loaded for the current buffer size
+    *	\param [in] _numberOfSources
+    *	\param [in] _sourceSamples mono audio played by every source, each one from a different position
+    *	\param [in] _enableOnlineInterpolation
+    *	\param [in] _numberOfLanes number of independent managers the sources are split among
+    *	\param [in] _workerPool pool that processes the lanes, nullptr to process them serially in the calling thread
+    *	\param [in] _nearFieldILD ILD of the near field effect, nullptr to disable it
+    */
+    CStressScene(std::shared_ptr<BRTServices::CHRTF> _hrtf, int _numberOfSources, const std::vector<float>& _sourceSamples, bool _enableOnlineInterpolation,
+        int _numberOfLanes = 1, CRealTimeWorkerPool* _workerPool = nullptr, std::shared_ptr<BRTServices::CILD> _nearFieldILD = nullptr);
+
+    /** \brief Renders one block: moves the sources, feeds their inputs, runs ProcessAll and gets the listener output
+    */
+    void ProcessBlock();
+
+    /** \brief Returns the binaural output of the last block
+    */
+    const Common::CEarPair<CMonoBuffer<float>>& GetOutput() const { return output; }
+
+    int GetNumberOfSources() const { return numberOfSources; }
+
+    int GetNumberOfLanes() const { return (int)lanes.size(); }
+
+private:
+    /// One BRT manager with its listener and a subset of the sources
+    struct TStressLane {
+        BRTBase::CBRTManager brtManager;
+        std::shared_ptr<BRTListenerModel::CListenerHRTFbasedModel> listener;
+        std::vector<std::shared_ptr<BRTSourceModel::CSourceSimpleModel>> sources;
+        CTrajectoryEngine trajectories;                         // One path per source, evaluated together once per block
+        std::vector<CMonoBuffer<float>> sourceInputs;
+        std::vector<size_t> samplePositions;                    // Read position of each source in sourceSamples
+        Common::CEarPair<CMonoBuffer<float>> output;
+    };
+
+    static void ProcessLaneTask(void* _scene, int _laneIndex);
+    void ProcessLane(TStressLane& _lane);
+    void MoveSources(TStressLane& _lane);
+    void FillSourceInputs(TStressLane& _lane);
+    void MixLanes();
+
+    std::vector<std::unique_ptr<TStressLane>> lanes;
+    CRealTimeWorkerPool* workerPool;
+    const std::vector<float>& sourceSamples;
+    Common::CEarPair<CMonoBuffer<float>> output;
+    unsigned long blockIndex;
+    int numberOfSources;
+    int bufferSize;
+    int sampleRate;
+};
+
+/** \brief Returns the HRTF to use at a given buffer size (the HRTF partitions depend on it). The provider sets the buffer
+*	size it reads the HRTF with itself, it does not rely on that of the caller
+*/
+typedef std::function<std::shared_ptr<BRTServices::CHRTF>(int _bufferSize)> THRTFProvider;
+
+/** \brief Measures the processing time of each block of a scene with N sources, against the buffer deadline. With more than one
+*	thread, the worker pool is spawned before the warm-up blocks and the scene has one lane per thread
+*	\param [in] _hrtf listener HRTF, loaded for the current buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _settings
+*	\retval statistics of the measured blocks, in milliseconds
+*/
+TTimingStatistics RunStressTest(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings);
+
+/** \brief Finds the maximum number of sources whose 99th percentile block time is within the deadline, at the current buffer size
+*	\param [in] _hrtf listener HRTF, loaded for the current buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _settings the number of sources is ignored
+*	\param [in] _verbose print the statistics of every evaluated number of sources
+*	\retval maximum number of sources, 0 if not even one source meets the deadline
+*/
+int FindMaximumNumberOfSources(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings, bool _verbose);
+
+/** \brief Runs FindMaximumNumberOfSources for each buffer size from 128 to 4096 and prints a summary. The global buffer size is
+*	restored at the end, the stream must be stopped while it runs
+*	\param [in] _hrtfProvider gives the HRTF for each buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _settings the number of sources is ignored
+*/
+void RunStressTestBufferSizeSweep(THRTFProvider _hrtfProvider, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings);
+
+/** \brief Measures the scene in one lane, the same lanes as the parallel run processed serially, and those lanes on the worker
+*	pool. Every lane renders its own copy of the listener, so the lanes add work: the pool speedup is measured against the serial
+*	lanes (same work), and the net gain against the single lane (the scene a single manager renders)
+*	\param [in] _hrtf listener HRTF, loaded for the current buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _settings numberOfThreads is used for the parallel run
+*/
+void RunStressTestThreadComparison(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings);
+
+/** \brief Measures the cost of the near field effect per source: the library scene with it disabled and enabled, and then the
+*	near field filters alone, with the coefficients asked to the ILD every block and one cascade of library biquads
+*	(Common::CBiquadFilter) per source ear, against the coefficient table and the cascades of all the sources in SIMD lanes.
+*	Prints the largest difference over every channel and the error to signal ratio of the table and lanes output
+*	\param [in] _hrtf listener HRTF, loaded for the current buffer size
+*	\param [in] _sourceSamples mono audio played by the sources
+*	\param [in] _settings nearFieldILD is required
+*/
+void RunNearFieldStressTest(std::shared_ptr<BRTServices::CHRTF> _hrtf, const std::vector<float>& _sourceSamples, const TStressTestSettings& _settings);
+
+#endif
@@ -0,0 +1,171 @@
+/**
+*
+* \brief Keyframed source trajectories, evaluated for all sources in a batch once per block
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+
+#include "TrajectoryEngine.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    /// Sine of an angle given in turns. Reduced to [-1/4, 1/4] turn, where an odd polynomial of degree 11 is accurate to 1e-7.
+    /// Only arithmetic and min/max, so loops over arrays are vectorised
+    inline float SinTurns(float _turns) {
+        const float roundingMagic = 12582912.0f;                        // 1.5 * 2^23: adding and subtracting it rounds to an integer
+        float t = _turns - ((_turns + roundingMagic) - roundingMagic);  // [-0.5, 0.5]
+        float folded = 0.5f - t;                                        // sin(pi - x) = sin(x)
+        t = (t < folded) ? t : folded;
+        folded = -0.5f - t;
+        t = (t > folded) ? t : folded;
+        float x = t * 6.28318530717958647f;
+        float x2 = x * x;
+        return x * (1.0f + x2 * (-1.0f / 6 + x2 * (1.0f / 120 + x2 * (-1.0f / 5040 + x2 * (1.0f / 362880 + x2 * (-1.0f / 39916800))))));
+    }
+}
+
+void SphericalToCartesian(const float* __restrict _azimuths, const float* __restrict _elevations, const float* __restrict _distances,
+    float* __restrict _x, float* __restrict _y, float* __restrict _z, size_t _count)
+{
+    const float degreesToTurns = 1.0f / 360.0f;
+    for (size_t i = 0; i < _count; i++) {
+        float azimuth = _azimuths[i] * degreesToTurns;
+        float elevation = _elevations[i] * degreesToTurns;
+        float horizontal = _distances[i] * SinTurns(elevation + 0.25f);         // cos(x) = sin(x + 1/4 turn)
+        _x[i] = horizontal * SinTurns(azimuth + 0.25f);
+        _y[i] = horizontal * SinTurns(azimuth);
+        _z[i] = _distances[i] * SinTurns(elevation);
+    }
+}
+
+int CTrajectoryEngine::AddPath(const TTrajectoryPath& _path)
+{
+    if (_path.keyframes.empty()) { return -1; }
+    paths.push_back(_path);
+    segments.push_back(0);
+    size_t size = paths.size() * NUMBER_OF_INSTANTS;
+    azimuths.resize(size);
+    elevations.resize(size);
+    distances.resize(size);
+    x.resize(size);
+    y.resize(size);
+    z.resize(size);
+    return (int)paths.size() - 1;
+}
+
+void CTrajectoryEngine::Clear()
+{
+    paths.clear();
+    segments.clear();
+    azimuths.clear();
+    elevations.clear();
+    distances.clear();
+    x.clear();
+    y.clear();
+    z.clear();
+}
+
+bool CTrajectoryEngine::LoadFromFile(const std::string& _filePath)
+{
+    std::ifstream file(_filePath);
+    if (!file.is_open()) {
+        std::cout << "Error opening the trajectory file " << _filePath << std::endl;
+        return false;
+    }
+
+    int pathsAdded = 0;
+    TTrajectoryPath path;
+    bool inPath = false;
+    auto finishPath = [&]() {
+        if (inPath && AddPath(path) >= 0) { pathsAdded++; }
+        path = TTrajectoryPath();
+    };
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first) || first[0] == '#') { continue; }
+        if (first == "path") {
+            finishPath();
+            std::string mode;
+            tokens >> mode;
+            path.loop = (mode == "loop");
+            inPath = true;
+            continue;
+        }
+        TTrajectoryKeyframe keyframe;
+        std::istringstream keyframeTokens(line);
+        if (!inPath || !(keyframeTokens >> keyframe.time >> keyframe.azimuth >> keyframe.elevation >> keyframe.distance)
+            || (!path.keyframes.empty() && keyframe.time < path.keyframes.back().time) || (path.keyframes.empty() && keyframe.time != 0)) {
+            std::cout << "Error in the trajectory file " << _filePath << ", line " << lineNumber << ": " << line << std::endl;
+            return false;
+        }
+        path.keyframes.push_back(keyframe);
+    }
+    finishPath();
+    return pathsAdded > 0;
+}
+
+void CTrajectoryEngine::InterpolatePath(size_t _path, double _time, size_t _output)
+{
+    const std::vector<TTrajectoryKeyframe>& keyframes = paths[_path].keyframes;
+    double duration = keyframes.back().time;
+    if (paths[_path].loop && duration > 0) { _time -= duration * std::floor(_time / duration); }
+
+    const TTrajectoryKeyframe* from = &keyframes.back();
+    const TTrajectoryKeyframe* to = from;
+    if (_time < duration) {
+        // Blocks advance in time, so the search starts at the last segment found
+        size_t& segment = segments[_path];
+        if (segment + 1 >= keyframes.size() || _time < keyframes[segment].time) { segment = 0; }
+        while (keyframes[segment + 1].time <= _time) { segment++; }
+        from = &keyframes[segment];
+        to = &keyframes[segment + 1];
+    }
+    float weight = (to->time > from->time) ? (float)((_time - from->time) / (to->time - from->time)) : 0.0f;
+    azimuths[_output] = from->azimuth + weight * (to->azimuth - from->azimuth);
+    elevations[_output] = from->elevation + weight * (to->elevation - from->elevation);
+    distances[_output] = from->distance + weight * (to->distance - from->distance);
+}
+
+void CTrajectoryEngine::Evaluate(double _startTime, double _endTime, const Common::CVector3& _listenerPosition)
+{
+    double times[NUMBER_OF_INSTANTS] = { _startTime, 0.5 * (_startTime + _endTime), _endTime };
+    for (size_t p = 0; p < paths.size(); p++) {
+        for (int i = 0; i < NUMBER_OF_INSTANTS; i++) { InterpolatePath(p, times[i], p * NUMBER_OF_INSTANTS + i); }
+    }
+    SphericalToCartesian(azimuths.data(), elevations.data(), distances.data(), x.data(), y.data(), z.data(), azimuths.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        x[i] += _listenerPosition.x;
+        y[i] += _listenerPosition.y;
+        z[i] += _listenerPosition.z;
+    }
+}
+
+Common::CVector3 CTrajectoryEngine::GetPosition(int _path, TInstant _instant) const
+{
+    size_t index = (size_t)_path * NUMBER_OF_INSTANTS + _instant;
+    return Common::CVector3(x[index], y[index], z[index]);
+}
@@ -0,0 +1,107 @@
+/**
+*
+* \brief Keyframed source trajectories, evaluated for all sources in a batch once per block
+* \date	October 2026
+*
+* \authors 3DI-DIANA Research Group (University of Malaga), in alphabetical order: M. Cuevas-Rodriguez, D. Gonzalez-Toledo, L. Molina-Tanco, F. Morales-Benitez ||
+* Coordinated by , A. Reyes-Lecuona (University of Malaga)||
+* \b Contact: areyes@uma.es
+*
+* \b Contributions: (additional authors/contributors can be added here)
+*
+* \b Project: SONICOM ||
+* \b Website: https://www.sonicom.eu/
+*
+* \b Copyright: University of Malaga 2023. Code based in the 3DTI Toolkit library (https://github.com/3DTune-In/3dti_AudioToolkit) with Copyright University of Malaga and Imperial College London - 2018
+*
+* \b Licence: This program is free software, you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+*
+* \b Acknowledgement: This project has received funding from the European Union’s Horizon 2020 research and innovation programme under grant agreement no.101017743
+*/
+
+
+#ifndef _TRAJECTORYENGINE_H_
+#define _TRAJECTORYENGINE_H_
+
+#include <string>
+#include <vector>
+#include <BRTLibrary.h>
+
+/** \brief Position of a source at a given time, in spherical coordinates around the listener
+*/
+struct TTrajectoryKeyframe {
+    float time;                 // Seconds
+    float azimuth;              // Degrees, not wrapped: 0 to 720 is two turns
+    float elevation;            // Degrees
+    float distance;             // Meters
+};
+
+/** \brief Keyframes of one source, linearly interpolated. Two keyframes with the same time make a jump
+*/
+struct TTrajectoryPath {
+    std::vector<TTrajectoryKeyframe> keyframes;     // Sorted by time, the first one at time 0
+    bool loop = false;                              // Starts again after the last keyframe, otherwise the source stays there
+};
+
+/** \brief Evaluates keyframed trajectories of many sources. Once per block, the start, centre and end positions of every path are
+*	computed in a batch: keyframe interpolation per path, then the spherical to Cartesian conversion for all of them at once,
+*	with a float polynomial sine that the compiler vectorises. Motion depends on time only, not on the buffer size.
+*/
+class CTrajectoryEngine {
+public:
+    /** \brief Adds a path
+    *	\param [in] _path
+    *	\retval index of the path, -1 if it has no keyframes
+    */
+    int AddPath(const TTrajectoryPath& _path);
+
+    /** \brief Adds the paths of a text file, one "path loop" or "path once" line per path followed by one
+    *	"time azimuth elevation distance" line per keyframe. Lines starting with # are comments
+    *	\param [in] _filePath
+    *	\retval true if the file could be read and had at least one valid path
+    */
+    bool LoadFromFile(const std::string& _filePath);
+
+    /** \brief Removes every path
+    */
+    void Clear();
+
+    /** \brief Computes the positions of all the paths at the start, centre and end of a block. Does not allocate
+    *	\param [in] _startTime seconds
+    *	\param [in] _endTime seconds
+    *	\param [in] _listenerPosition positions are relative to it
+    */
+    void Evaluate(double _startTime, double _endTime, const Common::CVector3& _listenerPosition);
+
+    int GetNumberOfPaths() const { return (int)paths.size(); }
+    const TTrajectoryPath& GetPath(int _path) const { return paths[_path]; }
+
+    /** \brief Positions computed by the last Evaluate
+    */
+    Common::CVector3 GetStartPosition(int _path) const { return GetPosition(_path, START); }
+    Common::CVector3 GetCentrePosition(int _path) const { return GetPosition(_path, CENTRE); }
+    Common::CVector3 GetEndPosition(int _path) const { return GetPosition(_path, END); }
+
+private:
+    enum TInstant { START, CENTRE, END, NUMBER_OF_INSTANTS };
+
+    void InterpolatePath(size_t _path, double _time, size_t _output);
+    Common::CVector3 GetPosition(int _path, TInstant _instant) const;
+
+    std::vector<TTrajectoryPath> paths;
+    std::vector<size_t> segments;                   // Segment of each path found last time, where the next search starts
+    // Structure of arrays, NUMBER_OF_INSTANTS entries per path
+    std::vector<float> azimuths;
+    std::vector<float> elevations;
+    std::vector<float> distances;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+};
+
+/** \brief Converts spherical coordinates (degrees) to Cartesian, for arrays of points. x = d cos(az) cos(el), y = d sin(az) cos(el),
+*	z = d sin(el). Accurate to about 1e-6 relative
+*/
+void SphericalToCartesian(const float* _azimuths, const float* _elevations, const float* _distances, float* _x, float* _y, float* _z, size_t _count);
+
+#endif